@@ -1,4 +1,4 @@
-QT += widgets charts
+QT += widgets charts concurrent sql
 QT       += core gui
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
@@ -15,23 +15,51 @@ SOURCES += \
     accuracy/accuracyvisualizer.cpp \
     accuracy/accuracywindow.cpp \
     accuracy/accuracycalculator.cpp \
+    accuracy/accuracyengine.cpp \
+    accuracy/evaluationstandard.cpp \
+    accuracy/iso2302standard.cpp \
+    accuracy/jisb6192standard.cpp \
+    accuracy/vdi3441standard.cpp \
+    accuracy/incrementalaccuracy.cpp \
+    accuracy/uncertaintyengine.cpp \
     appstate.cpp \
     autoconfigdialog.cpp \
     automeasurement.cpp \
     averagefilter.cpp \
+    biquadlowpass.cpp \
+    bytearena.cpp \
     calculatemesurement.cpp \
+    changedetector.cpp \
+    changegatefilter.cpp \
+    cycleplanner.cpp \
     databuffer.cpp \
     datameasurement.cpp \
     datavisualizer.cpp \
+    decimator.cpp \
+    driftmodel.cpp \
+    environmentcompensator.cpp \
+    environmentsource.cpp \
     expectationfilter.cpp \
+    expectedtable.cpp \
     filemanager.cpp \
     filter.cpp \
+    formulaexpression.cpp \
+    hampelfilter.cpp \
     main.cpp \
     mainwindow.cpp \
+    measurementcolumns.cpp \
+    measurementsnapshot.cpp \
     nonefilter.cpp \
     pyproc.cpp \
+    rawrecordstore.cpp \
+    recalcengine.cpp \
+    sessiondatabase.cpp \
+    sessionfile.cpp \
+    sessionjournal.cpp \
+    sessionrefilter.cpp \
     settingsmanager.cpp \
-    stepconfigdialog.cpp
+    stepconfigdialog.cpp \
+    stepstatistics.cpp
 
 HEADERS += \
     accuracy/accuracydatasaver.h \
@@ -39,22 +67,51 @@ HEADERS += \
     accuracy/accuracyvisualizer.h \
     accuracy/accuracywindow.h \
     accuracy/accuracycalculator.h \
+    accuracy/accuracyengine.h \
+    accuracy/evaluationstandard.h \
+    accuracy/iso2302standard.h \
+    accuracy/jisb6192standard.h \
+    accuracy/vdi3441standard.h \
+    accuracy/incrementalaccuracy.h \
+    accuracy/uncertaintyengine.h \
     appstate.h \
     autoconfigdialog.h \
     automeasurement.h \
+    binaryio.h \
     averagefilter.h \
+    biquadlowpass.h \
+    bytearena.h \
     calculatemesurement.h \
+    changedetector.h \
+    changegatefilter.h \
+    cycleplanner.h \
     databuffer.h \
     datameasurement.h \
     datavisualizer.h \
+    decimator.h \
+    driftmodel.h \
+    environmentcompensator.h \
+    environmentsource.h \
     expectationfilter.h \
+    expectedtable.h \
     filemanager.h \
     filter.h \
+    formulaexpression.h \
+    hampelfilter.h \
     mainwindow.h \
+    measurementcolumns.h \
+    measurementsnapshot.h \
     nonefilter.h \
     pyproc.h \
+    rawrecordstore.h \
+    recalcengine.h \
+    sessiondatabase.h \
+    sessionfile.h \
+    sessionjournal.h \
+    sessionrefilter.h \
     settingsmanager.h \
     stepconfigdialog.h \
+    stepstatistics.h \
     typemeasurement.h
 
 FORMS += \
@@ -1,6 +1,7 @@
 #include "accuracycalculator.h"
 #include <QtMath>
 #include <algorithm>
+#include <cmath>
 
 // ─────────────────────────────────────────────────────
 // Публичный метод: точка входа
@@ -11,12 +12,15 @@ AccuracyResultList AccuracyCalculator::compute(const DataMeasurement& measuremen
 
     // ❗ Здесь в будущем будет вызов валидатора корректности данных
 
-    for (const auto& group : measurement.groups()) {
-        if (!group.selectedFor)
+    const MeasurementColumns& cols = measurement.columns();
+    const StepStatistics& stats = measurement.stepStatistics();
+
+    for (int g = 0; g < cols.groupCount() && g < stats.groupCount(); ++g) {
+        if (!cols.groupSelected[g])
             continue;
 
-          // Вызываем строгий расчёт только для одной группы
-          AccuracyResultList results = computeStrictBidirectional(group);
+          // Полный расчёт ISO 230-2 для одной группы
+          AccuracyResultList results = computeGroup(stats.group(g));
 
           // Добавляем результат в список
           allResults += results;
@@ -25,144 +29,193 @@ AccuracyResultList AccuracyCalculator::compute(const DataMeasurement& measuremen
       return allResults;
 }
 
-AccuracyResultList AccuracyCalculator::computeStrictBidirectional(const MeasurementGroup& group)
+// ─────────────────────────────────────────────────────
+// Расчёт по снимку: накопители уже лежат в блоках групп
+// ─────────────────────────────────────────────────────
+AccuracyResultList AccuracyCalculator::compute(const MeasurementSnapshot& snapshot)
 {
-    AccuracyResultList results;
-
-    // ─────────────────────────────────────
-    // 1. Разделение серий по шагам и направлениям
-    // ─────────────────────────────────────
-    QMap<int, QVector<const MeasurementSeries*>> forwardMap;
-    QMap<int, QVector<const MeasurementSeries*>> backwardMap;
+    AccuracyResultList allResults;
 
-    for (const auto& s : group.steps) {
-        if (s.measurements.isEmpty())
+    for (int g = 0; g < snapshot.groupCount(); ++g) {
+        if (!snapshot.group(g).groupSelected[0])
             continue;
 
-        if (s.direction == ApproachDirection::Forward)
-            forwardMap[s.stepNumber].append(&s);
-        else if (s.direction == ApproachDirection::Backward)
-            backwardMap[s.stepNumber].append(&s);
+        allResults += computeGroup(snapshot.groupStats(g));
     }
 
-    // ─────────────────────────────────────
-    // 2. Расчёт по каждому шагу
-    // ─────────────────────────────────────
-    for (int step : forwardMap.keys()) {
-        if (!backwardMap.contains(step))
-            continue;
-
-        const auto& fSeries = forwardMap[step];
-        const auto& bSeries = backwardMap[step];
+    return allResults;
+}
 
-        QVector<double> fValues, bValues;
-        double expected = std::numeric_limits<double>::quiet_NaN();
+namespace {
 
-        for (const auto* s : fSeries) {
-            for (const auto& m : s->measurements)
-                if (!std::isnan(m.deviation))
-                    fValues.append(m.deviation);
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
 
-            if (!s->measurements.isEmpty() && std::isnan(expected) == true && !std::isnan(s->measurements.first().expected))
-                expected = s->measurements.first().expected;
+// ─────────────────────────────────────────────────────
+// Свёртка итогов группы: экстремумы и суммы по строкам шагов за один проход
+// ─────────────────────────────────────────────────────
+struct TotalFold
+{
+    // диапазон значений (min/max) с признаком «было хоть одно»
+    struct Range {
+        double lo = std::numeric_limits<double>::max();
+        double hi = std::numeric_limits<double>::lowest();
+        bool any = false;
+        void add(double l, double h) { lo = std::min(lo, l); hi = std::max(hi, h); any = true; }
+        double span() const { return any ? hi - lo : kNaN; }
+    };
+
+    Range meanF, meanB, meanAll, meanBi;                // E⁺, E⁻, E, M
+    Range bandF, bandB, bandAll;                        // A⁺, A⁻, A
+    double maxRF = kNaN, maxRB = kNaN, maxR = kNaN;     // R⁺, R⁻, R
+    double maxB = kNaN;                                 // B
+    double sumB = 0.0;                                  // B̄ = ΣBᵢ / m
+    int bidiSteps = 0;
+
+    static double maxOf(double acc, double v) { return std::isnan(acc) ? v : std::max(acc, v); }
+
+    void add(const AccuracyResult& r)
+    {
+        const bool f = r.countForward > 0;
+        const bool b = r.countBackward > 0;
+        if (f) {
+            meanF.add(r.meanForward, r.meanForward);
+            meanAll.add(r.meanForward, r.meanForward);
+            bandF.add(r.meanForward - 2.0 * r.stddevForward, r.meanForward + 2.0 * r.stddevForward);
+            maxRF = maxOf(maxRF, r.repeatabilityForward);
         }
-
-        for (const auto* s : bSeries) {
-            for (const auto& m : s->measurements)
-                if (!std::isnan(m.deviation))
-                    bValues.append(m.deviation);
+        if (b) {
+            meanB.add(r.meanBackward, r.meanBackward);
+            meanAll.add(r.meanBackward, r.meanBackward);
+            bandB.add(r.meanBackward - 2.0 * r.stddevBackward, r.meanBackward + 2.0 * r.stddevBackward);
+            maxRB = maxOf(maxRB, r.repeatabilityBackward);
         }
+        if (f && b) {
+            meanBi.add(r.meanBidirectional, r.meanBidirectional);
+            bandAll.add(std::min(r.meanForward - 2.0 * r.stddevForward, r.meanBackward - 2.0 * r.stddevBackward),
+                        std::max(r.meanForward + 2.0 * r.stddevForward, r.meanBackward + 2.0 * r.stddevBackward));
+            maxR = maxOf(maxR, r.repeatabilityBidirectional);
+            maxB = maxOf(maxB, std::abs(r.reversalError));
+            sumB += r.reversalError;
+            ++bidiSteps;
+        }
+    }
 
-        if (fValues.isEmpty() || bValues.isEmpty())
-            continue;
-
-        AccuracyResult r;
-        r.stepNumber = step;
-        r.expectedPosition = expected;
-
-        auto mean = [](const QVector<double>& v) {
-            return std::accumulate(v.begin(), v.end(), 0.0) / v.size();
-        };
-        auto stddev = [](const QVector<double>& v, double m) {
-            if (v.size() < 2) return 0.0;
-            double sum = 0.0;
-            for (double x : v) sum += qPow(x - m, 2);
-            return qSqrt(sum / (v.size() - 1));
-        };
-
-        r.meanForward  = mean(fValues);
-        r.meanBackward = mean(bValues);
-        r.meanBidirectional = (r.meanForward + r.meanBackward) / 2.0;
-        r.reversalError     = r.meanForward - r.meanBackward;
-
-        r.stddevForward  = stddev(fValues, r.meanForward);
-        r.stddevBackward = stddev(bValues, r.meanBackward);
-
-        r.repeatabilityForward  = 4.0 * r.stddevForward;
-        r.repeatabilityBackward = 4.0 * r.stddevBackward;
-        r.repeatabilityBidirectional = std::max({
-            r.repeatabilityForward,
-            r.repeatabilityBackward,
-            2.0 * r.stddevForward + 2.0 * r.stddevBackward + qAbs(r.reversalError)
-        });
-
-        r.systematicError = qAbs(r.reversalError);
-        r.positioningAccuracy = std::max(
-            r.meanForward + 2.0 * r.stddevBackward,
-            r.meanBackward + 2.0 * r.stddevForward)
-            -
-            std::min(
-            r.meanForward - 2.0 * r.stddevBackward,
-            r.meanBackward - 2.0 * r.stddevForward
-        );
-
-        // пока meanRange = 0.0, т.к. считается потом
-        results.append(r);
+    AccuracyResult finish() const
+    {
+        AccuracyResult t;
+        t.stepNumber = -1;
+        t.meanForward = t.meanBackward = t.meanBidirectional = t.reversalError = kNaN;
+        t.stddevForward = t.stddevBackward = kNaN;
+
+        t.systematicForward       = meanF.span();       // E⁺
+        t.systematicBackward      = meanB.span();       // E⁻
+        t.systematicBidirectional = bidiSteps ? meanAll.span() : kNaN; // E — только при двух направлениях
+        t.meanRange               = meanBi.span();      // M
+        t.systematicError         = maxB;               // B
+        t.meanReversal            = bidiSteps ? sumB / bidiSteps : kNaN; // B̄
+        t.repeatabilityForward    = maxRF;              // R⁺
+        t.repeatabilityBackward   = maxRB;              // R⁻
+        t.repeatabilityBidirectional = maxR;            // R
+        t.accuracyForward         = bandF.span();       // A⁺
+        t.accuracyBackward        = bandB.span();       // A⁻
+        t.positioningAccuracy     = bandAll.span();     // A
+        return t;
     }
+};
 
-    // ─────────────────────────────────────
-    // 3. Интегральные параметры (по всей группе)
-    // ─────────────────────────────────────
-    if (!results.isEmpty()) {
-        AccuracyResult total;
-        total.stepNumber = -1;
-
-        // E — диапазон средних значений
-        double minMean = results.first().meanBidirectional;
-        double maxMean = results.first().meanBidirectional;
-        double maxB    = 0.0;
-        double maxR    = 0.0;
-        double maxPos  = std::numeric_limits<double>::lowest();
-        double minPos  = std::numeric_limits<double>::max();
-
-        for (const auto& r : results) {
-            minMean = std::min(minMean, r.meanBidirectional);
-            maxMean = std::max(maxMean, r.meanBidirectional);
-            maxB    = std::max(maxB, std::abs(r.reversalError));
-            maxR    = std::max(maxR, r.repeatabilityBidirectional);
-
-            double hi = std::max(
-                r.meanForward + 2.0 * r.stddevBackward,
-                r.meanBackward + 2.0 * r.stddevForward);
-            double lo = std::min(
-                r.meanForward - 2.0 * r.stddevBackward,
-                r.meanBackward - 2.0 * r.stddevForward);
-
-            maxPos = std::max(maxPos, hi);
-            minPos = std::min(minPos, lo);
-        }
+} // namespace
 
-        total.meanRange            = maxMean - minMean; // E
-        total.systematicError      = maxB;              // M
-        total.repeatabilityBidirectional = maxR;        // Rmax
-        total.positioningAccuracy  = maxPos - minPos;   // A
+// ─────────────────────────────────────────────────────
+// Весь набор по группе: каждый шаг считается и сразу сворачивается в итог
+// ─────────────────────────────────────────────────────
+AccuracyResultList AccuracyCalculator::computeGroup(const StepStatistics::GroupStats& steps)
+{
+    AccuracyResultList results;
+    results.reserve(steps.size() + 1);
 
-        results.append(total);
+    TotalFold fold;
+    for (auto it = steps.cbegin(); it != steps.cend(); ++it) {
+        AccuracyResult r;
+        if (!computeStep(it.key(), it.value(), r))
+            continue;
+        fold.add(r);
+        results.append(r);
     }
 
+    if (!results.isEmpty())
+        results.append(fold.finish());
+
     return results;
 }
 
+// ─────────────────────────────────────────────────────
+// Показатели одного шага (одно- и двунаправленные)
+// ─────────────────────────────────────────────────────
+bool AccuracyCalculator::computeStep(int stepNumber, const StepAccumulator& acc, AccuracyResult& r)
+{
+    if (acc.forward.n == 0 && acc.backward.n == 0)
+        return false;
+
+    r = AccuracyResult();
+    r.stepNumber = stepNumber;
+    r.expectedPosition = acc.expected;
+    r.countForward  = acc.forward.n;
+    r.countBackward = acc.backward.n;
+
+    // ───── Однонаправленные: по каждой стороне, где есть подходы ─────
+    r.meanForward  = acc.forward.n  ? acc.forward.mean     : kNaN;
+    r.meanBackward = acc.backward.n ? acc.backward.mean    : kNaN;
+    r.stddevForward  = acc.forward.n  ? acc.forward.stddev()  : kNaN;
+    r.stddevBackward = acc.backward.n ? acc.backward.stddev() : kNaN;
+    r.repeatabilityForward  = 4.0 * r.stddevForward;
+    r.repeatabilityBackward = 4.0 * r.stddevBackward;
+
+    // ───── Двунаправленные: только при подходах с обеих сторон ─────
+    if (acc.forward.n == 0 || acc.backward.n == 0) {
+        r.meanBidirectional = r.reversalError = kNaN;
+        r.repeatabilityBidirectional = r.systematicError = kNaN;
+        r.positioningAccuracy = acc.forward.n
+            ? 4.0 * r.stddevForward
+            : 4.0 * r.stddevBackward;                       // ширина полосы ±2s одной стороны
+        r.meanRange = r.systematicForward = r.systematicBackward = kNaN;
+        r.systematicBidirectional = r.meanReversal = kNaN;
+        r.accuracyForward = r.accuracyBackward = kNaN;
+        return true;
+    }
 
+    r.meanBidirectional = (r.meanForward + r.meanBackward) / 2.0;
+    r.reversalError     = r.meanForward - r.meanBackward;
+
+    r.repeatabilityBidirectional = std::max({
+        r.repeatabilityForward,
+        r.repeatabilityBackward,
+        2.0 * r.stddevForward + 2.0 * r.stddevBackward + qAbs(r.reversalError)
+    });
+
+    r.systematicError = qAbs(r.reversalError);
+    r.positioningAccuracy = std::max(
+        r.meanForward + 2.0 * r.stddevForward,
+        r.meanBackward + 2.0 * r.stddevBackward)
+        -
+        std::min(
+        r.meanForward - 2.0 * r.stddevForward,
+        r.meanBackward - 2.0 * r.stddevBackward
+    );
+
+    // итоговые поля у строки шага не используются
+    r.meanRange = r.systematicForward = r.systematicBackward = kNaN;
+    r.systematicBidirectional = r.meanReversal = kNaN;
+    r.accuracyForward = r.accuracyBackward = kNaN;
+    return true;
+}
 
-
+// ─────────────────────────────────────────────────────
+// Итог группы по строкам шагов (та же свёртка, что в computeGroup)
+// ─────────────────────────────────────────────────────
+AccuracyResult AccuracyCalculator::computeTotal(const AccuracyResultList& results)
+{
+    TotalFold fold;
+    for (const auto& r : results)
+        fold.add(r);
+    return fold.finish();
+}
@@ -2,14 +2,20 @@
 #define ACCURACYCALCULATOR_H
 
 #include "datameasurement.h"
+#include "measurementsnapshot.h"
 #include <QVector>
 #include <limits>
 
-// Структура результатов расчёта по ГОСТ ISO 230-2—2016
+// Структура результатов расчёта по ГОСТ ISO 230-2—2016.
+// Строка шага (stepNumber ≥ 0) и итоговая строка группы (stepNumber = -1).
+// Величина, для которой нет данных (нет подходов с одной из сторон), — NaN.
 struct AccuracyResult
 {
     int stepNumber = 0;
 
+    int countForward = 0;                // n⁺ — подходов вперёд
+    int countBackward = 0;               // n⁻ — подходов назад
+
     double meanForward = 0.0;            // x⁺
     double meanBackward = 0.0;           // x⁻
     double meanBidirectional = 0.0;      // x̄ᵢ
@@ -18,13 +24,21 @@ struct AccuracyResult
     double stddevForward = 0.0;          // s⁺
     double stddevBackward = 0.0;         // s⁻
 
-    double repeatabilityForward = 0.0;   // R⁺ = 4s⁺
-    double repeatabilityBackward = 0.0;  // R⁻ = 4s⁻
-    double repeatabilityBidirectional = 0.0; // Ri
+    double repeatabilityForward = 0.0;   // R⁺ = 4s⁺ (в итоге — R⁺max)
+    double repeatabilityBackward = 0.0;  // R⁻ = 4s⁻ (в итоге — R⁻max)
+    double repeatabilityBidirectional = 0.0; // Ri (в итоге — R)
+
+    double systematicError = 0.0;        // итог: B — наибольший |Bᵢ|
+    double meanRange = 0.0;              // итог: M — диапазон x̄ᵢ
+    double positioningAccuracy = 0.0;    // A (у шага — по его полосе ±2s)
 
-    double systematicError = 0.0;        // E
-    double meanRange = 0.0;              // M
-    double positioningAccuracy = 0.0;    // A
+    // ——— Однонаправленные и остальные итоги группы ———
+    double systematicForward = 0.0;      // E⁺ — диапазон x⁺
+    double systematicBackward = 0.0;     // E⁻ — диапазон x⁻
+    double systematicBidirectional = 0.0; // E — диапазон x⁺ и x⁻ вместе
+    double meanReversal = 0.0;           // B̄ — среднее Bᵢ
+    double accuracyForward = 0.0;        // A⁺
+    double accuracyBackward = 0.0;       // A⁻
 
     // ——— Новое поле: ожидаемое значение позиции ———
     double expectedPosition = std::numeric_limits<double>::quiet_NaN();
@@ -42,9 +56,17 @@ public:
     // Главный метод: принимает данные и номера групп
     static AccuracyResultList compute(const DataMeasurement& measurement);
 
-private:
-    // Эталонный расчёт — по ГОСТ ISO 230-2 для всех шагов группы
-    static AccuracyResultList computeStrictBidirectional(const MeasurementGroup& group);
+    // То же по неизменяемому снимку — можно вызывать из рабочего потока
+    static AccuracyResultList compute(const MeasurementSnapshot& snapshot);
+
+    // Показатели одного шага по его накопителям (false — шаг без подходов)
+    static bool computeStep(int stepNumber, const StepAccumulator& acc, AccuracyResult& out);
+
+    // Итог группы (E⁺, E⁻, E, M, B, B̄, R⁺, R⁻, R, A⁺, A⁻, A) по готовым строкам шагов, stepNumber = -1
+    static AccuracyResult computeTotal(const AccuracyResultList& steps);
+
+    // Весь набор ISO 230-2 одной группы: шаги и итог за один проход по накопителям
+    static AccuracyResultList computeGroup(const StepStatistics::GroupStats& steps);
 
 };
 
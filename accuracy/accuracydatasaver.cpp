@@ -1,16 +1,19 @@
 #include "accuracydatasaver.h"
 
 // ─────────────────────────────────────────────────────
-// Построение структуры DataMeasurement по модели таблицы
+// Построение снимка измерений по модели таблицы
 // ─────────────────────────────────────────────────────
-DataMeasurement AccuracyDataSaver::extractFromModel(const QVector<TableRow>& tableModel)
+MeasurementSnapshot AccuracyDataSaver::extractFromModel(const QVector<TableRow>& tableModel)
 
 {
-    DataMeasurement result;
-    QVector<MeasurementGroup> groups;
+    // колонки наполняются плоско: без вложенных QVector на каждую строку
+    MeasurementColumns cols;
+    cols.reserve(tableModel.size(), tableModel.size(), 0);
 
-    MeasurementGroup currentGroup;
+    // заголовок ждёт первой строки с данными — пустые группы не попадают в колонки
+    const TableRow* pendingHeader = nullptr;
     int lastGroupId = -1;
+    bool groupOpen = false;
 
     // ───── Проход по строкам слепка ─────
     for (const auto& row : tableModel)
@@ -20,17 +23,9 @@ DataMeasurement AccuracyDataSaver::extractFromModel(const QVector<TableRow>& tab
         // ───── Заголовок группы ─────
         case TableRow::Type::GroupHeader:
         {
-            if (!currentGroup.steps.isEmpty())
-                groups.append(currentGroup);
-
-            currentGroup = {};
-            currentGroup.groupId = row.groupId;
-            currentGroup.type = row.isBidirectional
-                ? MeasurementGroupType::Bidirectional
-                : MeasurementGroupType::Unidirectional;
-            currentGroup.mode = row.mode;
-            currentGroup.selectedFor = row.selectedFor;
+            pendingHeader = &row;
             lastGroupId = row.groupId;
+            groupOpen = false;
             break;
         }
 
@@ -42,22 +37,22 @@ DataMeasurement AccuracyDataSaver::extractFromModel(const QVector<TableRow>& tab
                 break;
 
             if (row.groupId != lastGroupId) {
-                if (!currentGroup.steps.isEmpty())
-                    groups.append(currentGroup);
-
-                currentGroup = {};
-                currentGroup.groupId = row.groupId;
-                currentGroup.type = row.isBidirectional
-                    ? MeasurementGroupType::Bidirectional
-                    : MeasurementGroupType::Unidirectional;
-                currentGroup.mode = row.mode;
+                pendingHeader = nullptr;                 // группа без заголовка — выбор по умолчанию
                 lastGroupId = row.groupId;
+                groupOpen = false;
+            }
+
+            if (!groupOpen) {
+                const TableRow& h = pendingHeader ? *pendingHeader : row;
+                cols.appendGroup(h.groupId, h.mode,
+                                 h.isBidirectional ? MeasurementGroupType::Bidirectional
+                                                   : MeasurementGroupType::Unidirectional,
+                                 pendingHeader ? h.selectedFor : true);
+                groupOpen = true;
             }
 
-            // ——— Формируем MeasurementSeries напрямую из строки ———
-            MeasurementSeries step;
-            step.stepNumber = row.stepNumber;
-            step.direction = row.direction;
+            // ——— Каждая строка — отдельная серия из одного измерения ———
+            cols.appendSeries(row.stepNumber, row.direction);
 
             Measurement m;
             m.repeatIndex = row.repeatIndex;
@@ -65,9 +60,7 @@ DataMeasurement AccuracyDataSaver::extractFromModel(const QVector<TableRow>& tab
             m.expected = row.expected;
             m.deviation = row.deviation;
             m.raw = row.distance;
-
-            step.measurements.append(m);
-            currentGroup.steps.append(step);
+            cols.appendRow(m);
 
             break;
         }
@@ -79,12 +72,7 @@ DataMeasurement AccuracyDataSaver::extractFromModel(const QVector<TableRow>& tab
         }
     }
 
-    // ───── Финальный пуш группы ─────
-    if (!currentGroup.steps.isEmpty())
-        groups.append(currentGroup);
-
-    result.setGroups(groups);
-    return result;
+    return MeasurementSnapshot::fromColumns(cols);
 }
 
 
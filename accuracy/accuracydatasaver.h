@@ -1,18 +1,18 @@
 #ifndef ACCURACYDATASAVER_H
 #define ACCURACYDATASAVER_H
 
-#include "datameasurement.h"
+#include "measurementsnapshot.h"
 #include "accuracyvisualizer.h"
 
 // ─────────────────────────────────────────────────────
-// Класс преобразования модели таблицы в DataMeasurement
+// Класс преобразования модели таблицы в снимок измерений
 // ─────────────────────────────────────────────────────
 
 class AccuracyDataSaver
 {
 public:
-    // Основной метод: преобразует TableModel в DataMeasurement
-    static DataMeasurement extractFromModel(const QVector<TableRow>& tableModel);
+    // Основной метод: преобразует TableModel в снимок измерений
+    static MeasurementSnapshot extractFromModel(const QVector<TableRow>& tableModel);
 };
 
 #endif // ACCURACYDATASAVER_H
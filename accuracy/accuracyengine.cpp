@@ -0,0 +1,103 @@
+#include "accuracyengine.h"
+#include <QtConcurrent>
+
+// ─────────────────────────────────────────────────────
+// Точки входа: выбираем группы так же, как AccuracyCalculator::compute
+// ─────────────────────────────────────────────────────
+AccuracyResultList AccuracyEngine::compute(const DataMeasurement& measurement)
+{
+    const MeasurementColumns& cols = measurement.columns();
+    const StepStatistics& stats = measurement.stepStatistics();
+
+    QVector<const StepStatistics::GroupStats*> groups;
+    for (int g = 0; g < cols.groupCount() && g < stats.groupCount(); ++g)
+        if (cols.groupSelected[g])
+            groups.append(&stats.group(g));
+
+    return run(groups);
+}
+
+AccuracyResultList AccuracyEngine::compute(const MeasurementSnapshot& snapshot)
+{
+    QVector<const StepStatistics::GroupStats*> groups;
+    for (int g = 0; g < snapshot.groupCount(); ++g)
+        if (snapshot.group(g).groupSelected[0])
+            groups.append(&snapshot.groupStats(g));
+
+    return run(groups);
+}
+
+// ─────────────────────────────────────────────────────
+// Группы — параллельно (крупные — ещё и по шагам), сборка — по порядку
+// ─────────────────────────────────────────────────────
+AccuracyResultList AccuracyEngine::run(const QVector<const StepStatistics::GroupStats*>& groups)
+{
+    // ───── 1. Задачи: группа целиком, у крупной — шаги подряд по номеру ─────
+    QVector<GroupTask> totals(groups.size());
+    int stepCount = 0;
+    int splitSteps = 0;
+    for (int g = 0; g < groups.size(); ++g) {
+        totals[g].stats = groups[g];
+        totals[g].split = groups[g]->size() >= kChunkSteps;
+        stepCount += groups[g]->size();
+        if (totals[g].split)
+            splitSteps += groups[g]->size();
+    }
+
+    // строки шагов крупной группы пишутся сразу на свои места в её результатах
+    QVector<StepTask> steps;
+    steps.reserve(splitSteps);
+    for (GroupTask& t : totals) {
+        if (!t.split)
+            continue;
+        t.results.resize(t.stats->size());
+        t.taskBegin = steps.size();
+        int k = 0;
+        for (auto it = t.stats->cbegin(); it != t.stats->cend(); ++it, ++k) {
+            StepTask st;
+            st.acc = &it.value();
+            st.stepNumber = it.key();
+            st.out = &t.results[k];
+            steps.append(st);
+        }
+        t.taskEnd = steps.size();
+    }
+
+    // ───── 2. Показатели шагов крупных групп: каждая задача пишет только себя ─────
+    auto stepKernel = [](StepTask& t) {
+        t.valid = AccuracyCalculator::computeStep(t.stepNumber, *t.acc, *t.out);
+    };
+
+    // ───── 3. Группа: целиком тем же ядром или итог по готовым шагам в том же порядке ─────
+    auto totalKernel = [&steps](GroupTask& g) {
+        if (!g.split) {
+            g.results = AccuracyCalculator::computeGroup(*g.stats);
+            return;
+        }
+        int kept = 0;                                // шаги без подходов выпадают, порядок прежний
+        for (int i = g.taskBegin; i < g.taskEnd; ++i)
+            if (steps[i].valid) {
+                if (kept != i - g.taskBegin)
+                    g.results[kept] = g.results[i - g.taskBegin];
+                ++kept;
+            }
+        g.results.resize(kept);
+        if (!g.results.isEmpty())
+            g.results.append(AccuracyCalculator::computeTotal(g.results));
+    };
+
+    if (stepCount < kParallelSteps) {                // потоки дороже самой работы
+        for (StepTask& t : steps) stepKernel(t);
+        for (GroupTask& g : totals) totalKernel(g);
+    } else {
+        QtConcurrent::blockingMap(steps, stepKernel);
+        QtConcurrent::blockingMap(totals, totalKernel);
+    }
+
+    // ───── 4. Сборка в порядке групп ─────
+    AccuracyResultList all;
+    all.reserve(stepCount + totals.size());
+    for (const GroupTask& g : totals)
+        all += g.results;
+    return all;
+}
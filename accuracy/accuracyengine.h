@@ -0,0 +1,44 @@
+#ifndef ACCURACYENGINE_H
+#define ACCURACYENGINE_H
+
+#include "accuracycalculator.h"
+#include <QVector>
+
+// ─────────────────────────────────────────────
+// Параллельный расчёт точности на пуле потоков (QtConcurrent)
+// ─────────────────────────────────────────────
+// Выбранные группы считаются одновременно — задача на группу (AccuracyCalculator::computeGroup).
+// Группа от kChunkSteps шагов сама делится на задачи по шагу (computeStep), её итог
+// сводится по шагам в порядке возрастания номера, как в последовательном расчёте,
+// поэтому результат побитово совпадает с AccuracyCalculator::compute при любом числе потоков.
+// Накопители шагов к этому моменту уже готовы (RecalcEngine::rebuildStatistics).
+
+class AccuracyEngine
+{
+public:
+    static constexpr int kParallelSteps = 1 << 12;   // меньше шагов — считаем в одном потоке
+    static constexpr int kChunkSteps    = 1 << 10;   // группа от стольких шагов делится по шагам
+
+    static AccuracyResultList compute(const DataMeasurement& measurement);
+    static AccuracyResultList compute(const MeasurementSnapshot& snapshot);
+
+private:
+    struct StepTask {
+        const StepAccumulator* acc = nullptr;        // накопители (только чтение)
+        int stepNumber = 0;
+        AccuracyResult* out = nullptr;               // строка шага в результатах группы
+        bool valid = false;                          // есть учтённые подходы хотя бы с одной стороны
+    };
+
+    struct GroupTask {
+        const StepStatistics::GroupStats* stats = nullptr; // накопители группы (только чтение)
+        bool split = false;                          // шаги считаны отдельными задачами
+        int taskBegin = 0;                           // шаги группы в массиве задач (split)
+        int taskEnd = 0;
+        AccuracyResultList results;                  // строки шагов + итог
+    };
+
+    static AccuracyResultList run(const QVector<const StepStatistics::GroupStats*>& groups);
+};
+
+#endif // ACCURACYENGINE_H
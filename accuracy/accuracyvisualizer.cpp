@@ -6,6 +6,7 @@
 #include <QCheckBox>
 #include <QScrollBar>
 #include <QMessageBox>
+#include <QSignalBlocker>
 
 // ─────────────────────────────────────────────────────
 // Конструктор и базовая инициализация
@@ -39,6 +40,19 @@ void AccuracyVisualizer::setWidgets(QTableWidget* input, QTableWidget* result)
     }
 
     // ───── Настройка таблицы результатов ─────
+    setupIsoResultColumns();
+}
+
+
+
+// ─────────────────────────────────────────────────────
+// Колонки таблицы результатов под ГОСТ ISO 230-2
+// ─────────────────────────────────────────────────────
+void AccuracyVisualizer::setupIsoResultColumns()
+{
+    if (!resultTable)
+        return;
+
     resultTable->setColumnCount(12);
     QStringList labels;
     labels
@@ -153,42 +167,7 @@ void AccuracyVisualizer::AccuracyVisualizer::saveVisibleTable()
         }
 
         case TableRow::Type::Measurement: {
-            TableRow meas;
-            meas.type = type;
-            meas.groupId = currentGroupId;
-
-            // шаг.пвтор
-            auto* item0 = inputTable->item(row, 0);
-            if (item0) {
-                QStringList parts = item0->text().split(".");
-                if (parts.size() == 2) {
-                    meas.stepNumber = parts[0].toInt();
-                    meas.repeatIndex = parts[1].toInt();
-                }
-            }
-
-            // distance, expected, deviation
-            auto* d = inputTable->item(row, 1);
-            auto* e = inputTable->item(row, 2);
-            auto* dev = inputTable->item(row, 3);
-            QString distStr = d ? d->text().trimmed() : "";
-            QString expectedStr = e ? e->text().trimmed() : "";
-            QString deviationStr = dev ? dev->text().trimmed() : "";
-
-            meas.distance = distStr.isEmpty() ? std::numeric_limits<double>::quiet_NaN() : distStr.toDouble();
-            meas.expected = expectedStr.isEmpty() ? std::numeric_limits<double>::quiet_NaN() : expectedStr.toDouble();
-            meas.deviation = deviationStr.isEmpty() ? std::numeric_limits<double>::quiet_NaN() : deviationStr.toDouble();
-
-            // direction
-            if (auto* dir = qobject_cast<QComboBox*>(inputTable->cellWidget(row, 4))) {
-                meas.direction = directionFromString(dir->currentText());
-            }
-
-            // mode
-            if (auto* mode = qobject_cast<QComboBox*>(inputTable->cellWidget(row, 5))) {
-                meas.mode = modeFromString(mode->currentText());
-            }
-
+            TableRow meas = readMeasurementRow(row, currentGroupId);
             m_tableModel.append(meas);
             break;
         }
@@ -211,15 +190,76 @@ void AccuracyVisualizer::AccuracyVisualizer::saveVisibleTable()
     }
 }
 
+// ─────────────────────────────────────────────────────
+// Чтение строки измерения из таблицы ввода
+// ─────────────────────────────────────────────────────
+TableRow AccuracyVisualizer::readMeasurementRow(int row, int groupId) const
+{
+    TableRow meas;
+    meas.type = TableRow::Type::Measurement;
+    meas.groupId = groupId;
+
+    // шаг.пвтор
+    auto* item0 = inputTable->item(row, 0);
+    if (item0) {
+        QStringList parts = item0->text().split(".");
+        if (parts.size() == 2) {
+            meas.stepNumber = parts[0].toInt();
+            meas.repeatIndex = parts[1].toInt();
+        }
+    }
+
+    // distance, expected, deviation
+    auto* d = inputTable->item(row, 1);
+    auto* e = inputTable->item(row, 2);
+    auto* dev = inputTable->item(row, 3);
+    QString distStr = d ? d->text().trimmed() : "";
+    QString expectedStr = e ? e->text().trimmed() : "";
+    QString deviationStr = dev ? dev->text().trimmed() : "";
+
+    meas.distance = distStr.isEmpty() ? std::numeric_limits<double>::quiet_NaN() : distStr.toDouble();
+    meas.expected = expectedStr.isEmpty() ? std::numeric_limits<double>::quiet_NaN() : expectedStr.toDouble();
+    meas.deviation = deviationStr.isEmpty() ? std::numeric_limits<double>::quiet_NaN() : deviationStr.toDouble();
+
+    // direction
+    if (auto* dir = qobject_cast<QComboBox*>(inputTable->cellWidget(row, 4))) {
+        meas.direction = directionFromString(dir->currentText());
+    }
+
+    // mode
+    if (auto* mode = qobject_cast<QComboBox*>(inputTable->cellWidget(row, 5))) {
+        meas.mode = modeFromString(mode->currentText());
+    }
+
+    return meas;
+}
+
+// ─────────────────────────────────────────────────────
+// Фиксация правки строки в модели и уведомление живого расчёта
+// ─────────────────────────────────────────────────────
+void AccuracyVisualizer::commitRow(int row)
+{
+    if (!inputTable || row < 0 || row >= m_tableModel.size())
+        return;
+    if (m_tableModel[row].type != TableRow::Type::Measurement)
+        return;
+
+    m_tableModel[row] = readMeasurementRow(row, m_tableModel[row].groupId);
+    emit rowChanged(row, m_tableModel[row]);
+}
+
 // ─────────────────────────────────────────────────────
 // Основной метод отображения начальных данных
 // ─────────────────────────────────────────────────────
 
-void AccuracyVisualizer::setTable(const DataMeasurement& measurement)
+void AccuracyVisualizer::setTable(const MeasurementSnapshot& measurement)
 {
     if (!inputTable)
         return;
 
+    // построение — не правка: cellChanged и живой расчёт на каждую ячейку не нужны
+    const QSignalBlocker blocker(inputTable);
+
     // 0. Очистка визуального представления
     inputTable->clearContents();
     inputTable->setRowCount(0);
@@ -299,6 +339,13 @@ void AccuracyVisualizer::addGroupHeaderRow(int row, int groupId, bool isBidirect
 
     inputTable->setCellWidget(row, 0, container);
 
+    connect(includeBox, &QCheckBox::toggled, this, [=](bool on) {
+        for (auto& r : m_tableModel)
+            if (r.type == TableRow::Type::GroupHeader && r.groupId == groupId)
+                r.selectedFor = on;
+        emit groupSelectionChanged(groupId, on);
+    });
+
     // Чекбокс "двунаправленный"
     auto* check = new QCheckBox("Двунаправленный 🔁");
     check->setChecked(isBidirectional);
@@ -355,7 +402,9 @@ void AccuracyVisualizer::addMeasurementRow(int row,
     inputTable->setItem(row, 3, deviationItem);
 
     // ───── 5. Направление (ComboBox) ─────
-    inputTable->setCellWidget(row, 4, createDirectionComboBox(direction));
+    auto* directionBox = createDirectionComboBox(direction);
+    inputTable->setCellWidget(row, 4, directionBox);
+    connect(directionBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [=]() { commitRow(row); });
 
     // ───── 6. Режим (ComboBox) ─────
     inputTable->setCellWidget(row, 5, createModeComboBox(mode));
@@ -411,6 +460,8 @@ void AccuracyVisualizer::renderTable()
     if (!inputTable)
         return;
 
+    const QSignalBlocker blocker(inputTable);
+
     // 0. Очистка текущей таблицы
     int scrollPos = inputTable->verticalScrollBar()->value();
     inputTable->clearContents();
@@ -749,6 +800,7 @@ void AccuracyVisualizer::setResultTable(const AccuracyResultList& results)
     // ───── Подготовка таблицы ─────
     resultTable->clearContents();
     resultTable->setRowCount(0);
+    setupIsoResultColumns();                       // после отчёта другого стандарта
 
     int currentGroup = 1;
 
@@ -756,52 +808,38 @@ void AccuracyVisualizer::setResultTable(const AccuracyResultList& results)
         const AccuracyResult& r = results[i];
 
         // ───── Заголовок группы ─────
-        if (r.stepNumber != -1 && (i == 0 || results[i - 1].stepNumber == -1)) {
-            resultTable->insertRow(resultTable->rowCount());
-
-            auto* headerItem = new QTableWidgetItem(
-                QString("Расчёт для группы №%1").arg(currentGroup++));
-            headerItem->setTextAlignment(Qt::AlignCenter);
-            headerItem->setBackground(Qt::lightGray);
-            QFont font = headerItem->font();
-            font.setBold(true);
-            headerItem->setFont(font);
+        if (r.stepNumber != -1 && (i == 0 || results[i - 1].stepNumber == -1))
+            appendGroupHeader(currentGroup++);
 
-            resultTable->setSpan(resultTable->rowCount() - 1, 0, 1, resultTable->columnCount());
-            resultTable->setItem(resultTable->rowCount() - 1, 0, headerItem);
-        }
-
-        // ───── Строка с заголовками итогов группы ─────
+        // ───── Итоги группы: две пары строк (подписи + значения) ─────
         if (r.stepNumber == -1) {
-            resultTable->insertRow(resultTable->rowCount());
-            QStringList groupSummaryLabels = {
-                " ", " ",
-                "Диапазон средних (E), мм",
-                "Макс. реверс (Bmax), мм",
-                "Повторяемость по оси (R), мм",
-                "Двунапр. погрешность (A), мм"
-            };
-
-            for (int col = 0; col < groupSummaryLabels.size(); ++col) {
-                auto* item = new QTableWidgetItem(groupSummaryLabels[col]);
-                item->setTextAlignment(Qt::AlignCenter);
-                QFont font = item->font();
-                font.setBold(true);
-                item->setFont(font);
-                item->setBackground(QColor(235, 240, 255));
-                resultTable->setItem(resultTable->rowCount() - 1, col, item);
-            }
+            appendTotalRows("Итог ↑/↓ (однонапр.)", {
+                "E⁺ — диапазон x̄⁺, мм", "E⁻ — диапазон x̄⁻, мм",
+                "R⁺ max, мм", "R⁻ max, мм",
+                "A⁺, мм", "A⁻, мм"
+            }, {
+                r.systematicForward, r.systematicBackward,
+                r.repeatabilityForward, r.repeatabilityBackward,
+                r.accuracyForward, r.accuracyBackward
+            });
+            appendTotalRows("Итог двунапр.", {
+                "Сист. погрешность (E), мм", "Диапазон средних (M), мм",
+                "Макс. реверс (B), мм", "Средний реверс (B̄), мм",
+                "Повторяемость по оси (R), мм", "Двунапр. погрешность (A), мм"
+            }, {
+                r.systematicBidirectional, r.meanRange,
+                r.systematicError, r.meanReversal,
+                r.repeatabilityBidirectional, r.positioningAccuracy
+            });
+            continue;
         }
 
-        // ───── Строка с результатами ─────
+        // ───── Строка с результатами шага ─────
         resultTable->insertRow(resultTable->rowCount());
         int row = resultTable->rowCount() - 1;
 
-        // 1. Шаг (обычный или метка итогов)
-        QString stepText = (r.stepNumber == -1)
-            ? "Итог по группе"
-            : QString::number(r.stepNumber);
-        resultTable->setItem(row, 0, createReadonlyItem(stepText));
+        // 1. Шаг
+        resultTable->setItem(row, 0, createReadonlyItem(QString::number(r.stepNumber)));
 
         // 2. Ожидаемое значение (если есть)
         QString expText = qIsNaN(r.expectedPosition)
@@ -809,32 +847,77 @@ void AccuracyVisualizer::setResultTable(const AccuracyResultList& results)
             : QString::number(r.expectedPosition, 'f', 6);
         resultTable->setItem(row, 1, createReadonlyItem(expText));
 
-        // 3. Показатели по шагам (если stepNumber != -1)
-        if (r.stepNumber != -1) {
-            resultTable->setItem(row, 2,  createReadonlyItem(r.meanForward));         // x̄⁺
-            resultTable->setItem(row, 3,  createReadonlyItem(r.meanBackward));        // x̄⁻
-            resultTable->setItem(row, 4,  createReadonlyItem(r.meanBidirectional));   // x̄ᵢ
-            resultTable->setItem(row, 5,  createReadonlyItem(-r.meanBidirectional));  // Коррекция (−x̄ᵢ) ← новая
-            resultTable->setItem(row, 6,  createReadonlyItem(r.reversalError));       // Bᵢ
-            resultTable->setItem(row, 7,  createReadonlyItem(r.stddevForward));       // s⁺
-            resultTable->setItem(row, 8,  createReadonlyItem(r.stddevBackward));      // s⁻
-            resultTable->setItem(row, 9,  createReadonlyItem(r.repeatabilityForward));    // R⁺
-            resultTable->setItem(row, 10, createReadonlyItem(r.repeatabilityBackward));   // R⁻
-            resultTable->setItem(row, 11, createReadonlyItem(r.repeatabilityBidirectional)); // Rᵢ
+        // 3. Показатели шага (нет подходов с одной из сторон — «—»)
+        resultTable->setItem(row, 2,  createReadonlyItem(r.meanForward));         // x̄⁺
+        resultTable->setItem(row, 3,  createReadonlyItem(r.meanBackward));        // x̄⁻
+        resultTable->setItem(row, 4,  createReadonlyItem(r.meanBidirectional));   // x̄ᵢ
+        const double mean = !qIsNaN(r.meanBidirectional) ? r.meanBidirectional
+                          : !qIsNaN(r.meanForward)       ? r.meanForward
+                                                         : r.meanBackward;  // однонаправленный шаг — по своей стороне
+        resultTable->setItem(row, 5,  createReadonlyItem(-mean));                 // Коррекция (−x̄ᵢ)
+        resultTable->setItem(row, 6,  createReadonlyItem(r.reversalError));       // Bᵢ
+        resultTable->setItem(row, 7,  createReadonlyItem(r.stddevForward));       // s⁺
+        resultTable->setItem(row, 8,  createReadonlyItem(r.stddevBackward));      // s⁻
+        resultTable->setItem(row, 9,  createReadonlyItem(r.repeatabilityForward));    // R⁺
+        resultTable->setItem(row, 10, createReadonlyItem(r.repeatabilityBackward));   // R⁻
+        resultTable->setItem(row, 11, createReadonlyItem(r.repeatabilityBidirectional)); // Rᵢ
+    }
+
+    // ───── Подгонка ширины столбцов ─────
+    resultTable->resizeColumnsToContents();
+}
+
+// ─────────────────────────────────────────────────────
+// Отображение отчёта по выбранному стандарту оценки
+// ─────────────────────────────────────────────────────
+
+void AccuracyVisualizer::setStandardReport(const StandardReport& report)
+{
+    if (!resultTable)
+        return;
+
+    // ───── Подготовка таблицы: позиция, номинал и колонки стандарта ─────
+    resultTable->clearContents();
+    resultTable->setRowCount(0);
+    resultTable->clearSpans();
+    resultTable->setColumnCount(2 + report.stepColumns.size());
+    resultTable->setHorizontalHeaderLabels(QStringList()
+        << "Позиция (шаг)" << "Номинал, мм" << report.stepColumns);
+
+    int currentGroup = 1;
+    for (const StandardGroupReport& group : report.groups) {
+        if (group.steps.isEmpty())
+            continue;
+        appendGroupHeader(currentGroup++);
+
+        // ───── Строки шагов ─────
+        for (const StandardStepRow& step : group.steps) {
+            resultTable->insertRow(resultTable->rowCount());
+            int row = resultTable->rowCount() - 1;
+
+            resultTable->setItem(row, 0, createReadonlyItem(QString::number(step.stepNumber)));
+            QString expText = qIsNaN(step.expected)
+                ? QString("—")
+                : QString::number(step.expected, 'f', 6);
+            resultTable->setItem(row, 1, createReadonlyItem(expText));
+            for (int c = 0; c < step.values.size(); ++c)
+                resultTable->setItem(row, 2 + c, createReadonlyItem(step.values[c]));
         }
 
-        // 4. Итоги группы (если stepNumber == -1)
-        else {
-            resultTable->setItem(row, 0, createReadonlyItem("Итог по группе"));
-            resultTable->setItem(row, 1, createReadonlyItem("—"));
-            resultTable->setItem(row, 2, createReadonlyItem(r.meanRange));              // Eᵢ
-            resultTable->setItem(row, 3, createReadonlyItem(r.systematicError));        // M
-            resultTable->setItem(row, 4, createReadonlyItem(r.repeatabilityBidirectional)); // Rmax
-            resultTable->setItem(row, 5, createReadonlyItem(r.positioningAccuracy));    // A
+        // ───── Итоги: пары строк по ширине колонок стандарта ─────
+        const int perRow = qMax(1, int(report.stepColumns.size()));
+        for (int first = 0; first < group.totals.size(); first += perRow) {
+            QStringList labels;
+            QVector<double> values;
+            for (int k = first; k < qMin(first + perRow, int(group.totals.size())); ++k) {
+                labels << group.totals[k].label;
+                values << group.totals[k].value;
+            }
+            appendTotalRows(first == 0 ? QString("Итог (%1)").arg(report.title) : QString(),
+                            labels, values);
         }
     }
 
-    // ───── Подгонка ширины столбцов ─────
     resultTable->resizeColumnsToContents();
 }
 
@@ -883,6 +966,7 @@ void AccuracyVisualizer::onCellEdited(int row, int column)
             inputTable->blockSignals(false);
         }
 
+        commitRow(row);
         return;
     }
 
@@ -927,6 +1011,7 @@ void AccuracyVisualizer::onCellEdited(int row, int column)
         inputTable->blockSignals(true);
         devItem->setText("");
         inputTable->blockSignals(false);
+        commitRow(row);
         return;
     }
 
@@ -938,6 +1023,8 @@ void AccuracyVisualizer::onCellEdited(int row, int column)
         devItem->setText(QString::number(deviation, 'f', 6));
         inputTable->blockSignals(false);
     }
+
+    commitRow(row);
 }
 
 
@@ -958,7 +1045,7 @@ void AccuracyVisualizer::onCurrentCellChanged(int currentRow, int currentCol, in
 
 QTableWidgetItem* AccuracyVisualizer::createReadonlyItem(double value)
 {
-    auto* item = new QTableWidgetItem(QString::number(value, 'f', 6));
+    auto* item = new QTableWidgetItem(qIsNaN(value) ? QString("—") : QString::number(value, 'f', 6));
     item->setFlags(item->flags() ^ Qt::ItemIsEditable);
     item->setTextAlignment(Qt::AlignCenter);
     return item;
@@ -971,3 +1058,49 @@ QTableWidgetItem* AccuracyVisualizer::createReadonlyItem(const QString& text)
     item->setTextAlignment(Qt::AlignCenter);
     return item;
 }
+
+// ─────────────────────────────────────────────────────
+// Заголовок группы в таблице результатов (на всю ширину)
+// ─────────────────────────────────────────────────────
+void AccuracyVisualizer::appendGroupHeader(int groupNumber)
+{
+    resultTable->insertRow(resultTable->rowCount());
+
+    auto* headerItem = new QTableWidgetItem(
+        QString("Расчёт для группы №%1").arg(groupNumber));
+    headerItem->setTextAlignment(Qt::AlignCenter);
+    headerItem->setBackground(Qt::lightGray);
+    QFont font = headerItem->font();
+    font.setBold(true);
+    headerItem->setFont(font);
+
+    resultTable->setSpan(resultTable->rowCount() - 1, 0, 1, resultTable->columnCount());
+    resultTable->setItem(resultTable->rowCount() - 1, 0, headerItem);
+}
+
+// ─────────────────────────────────────────────────────
+// Пара строк итогов группы: подписи и значения с колонки 2
+// ─────────────────────────────────────────────────────
+void AccuracyVisualizer::appendTotalRows(const QString& title,
+                                         const QStringList& labels,
+                                         const QVector<double>& values)
+{
+    resultTable->insertRow(resultTable->rowCount());
+    int row = resultTable->rowCount() - 1;
+    for (int i = 0; i < labels.size(); ++i) {
+        auto* item = new QTableWidgetItem(labels[i]);
+        item->setTextAlignment(Qt::AlignCenter);
+        QFont font = item->font();
+        font.setBold(true);
+        item->setFont(font);
+        item->setBackground(QColor(235, 240, 255));
+        resultTable->setItem(row, 2 + i, item);
+    }
+
+    resultTable->insertRow(resultTable->rowCount());
+    row = resultTable->rowCount() - 1;
+    resultTable->setItem(row, 0, createReadonlyItem(title));
+    resultTable->setItem(row, 1, createReadonlyItem("—"));
+    for (int i = 0; i < values.size(); ++i)
+        resultTable->setItem(row, 2 + i, createReadonlyItem(values[i]));
+}
@@ -5,8 +5,9 @@
 #include <QTableWidget>
 #include <QPushButton>
 #include <QComboBox>
-#include "datameasurement.h"
+#include "measurementsnapshot.h"
 #include "accuracycalculator.h"
+#include "evaluationstandard.h"
 
 #include <QHBoxLayout>
 #include <QCheckBox>
@@ -52,12 +53,15 @@ public:
     // Установка виджетов (input table и таблицы с результатами)
     void setWidgets(QTableWidget* inputTable, QTableWidget* resultTableView);
 
-    // Основная перерисовка таблицы из DataMeasurement
-    void setTable(const DataMeasurement& measurement);
+    // Основная перерисовка таблицы из снимка измерений
+    void setTable(const MeasurementSnapshot& measurement);
 
     // Отображает таблицу resultTable по результатам расчёта
     void setResultTable(const AccuracyResultList& results);
 
+    // Отображает отчёт другого стандарта оценки (колонки — по стандарту)
+    void setStandardReport(const StandardReport& report);
+
     // Основной метод: сохранить таблицу и вернуть копию слепка
     QVector<TableRow> prepareSnapshot();
 
@@ -72,6 +76,7 @@ public slots:
 
     void onCellEdited(int row, int column);  // Обработка редактирования значений
     void onCurrentCellChanged(int currentRow, int currentCol, int previousRow, int previousCol); // Сохраняем текст текущей ячейки перед редактированием
+    void commitRow(int row);            // Перенести правку строки в модель и сообщить о ней
 
 signals:
     // Сигналы управления от пользователя
@@ -80,6 +85,10 @@ signals:
     void addRowToGroupRequested(int groupId);
     void addGroupRequested();
 
+    // Правки для живого расчёта
+    void rowChanged(int row, const TableRow& after);       // строка измерения изменена
+    void groupSelectionChanged(int groupId, bool selected); // группа включена/выключена
+
 private:
     QTableWidget* inputTable = nullptr;
     QTableWidget* resultTable = nullptr;
@@ -101,16 +110,25 @@ private:
     // Добавить финальную кнопку "Добавить новую группу"
     void addGlobalAddGroupRow(int row);
 
+    // Колонки и подсказки таблицы результатов под ГОСТ ISO 230-2
+    void setupIsoResultColumns();
+
     // Визуализировать таблицу из модели
     void renderTable();
 
     // Сохранить текущую таблицу (то, что видит пользователь) в m_tableModel
     void saveVisibleTable();
 
+    // Прочитать строку измерения из таблицы ввода
+    TableRow readMeasurementRow(int row, int groupId) const;
+
     // ──────────────────────── Компоненты построения строк ────────────────────────
 
     QTableWidgetItem* createReadonlyItem(double value);
     QTableWidgetItem* createReadonlyItem(const QString& text);// погрешность
+    void appendGroupHeader(int groupNumber);                          // заголовок группы результатов
+    void appendTotalRows(const QString& title, const QStringList& labels,
+                         const QVector<double>& values);  // подписи + значения итогов группы
     QComboBox* createDirectionComboBox(ApproachDirection dir);       // редактируемый выпадающий список направления
     QComboBox* createModeComboBox(StepMode mode);                    // редактируемый выпадающий список режима
     QPushButton* createDeleteButton();                               // кнопка удалить
@@ -3,6 +3,10 @@
 #include "accuracy/accuracyvisualizer.h"
 #include "accuracy/accuracydatasaver.h"
 #include "accuracy/accuracycalculator.h"
+#include "accuracy/accuracyengine.h"
+#include "accuracy/iso2302standard.h"
+#include "accuracy/uncertaintyengine.h"
+#include <QGuiApplication>
 #include <QMessageBox>
 
 
@@ -41,9 +45,21 @@ AccuracyWindow::AccuracyWindow(QWidget* parent)
     //Кнопка рассчета
     connect(ui->calculateButton, &QPushButton::clicked, this, &AccuracyWindow::onCalculateButtonClicked);
 
+    //Кнопка доверительных интервалов
+    connect(ui->uncertaintyButton, &QPushButton::clicked, this, &AccuracyWindow::onUncertaintyClicked);
+
     //Редактирование ячейки
     connect(ui->inputTable, &QTableWidget::cellChanged, this, &AccuracyWindow::onCellEdited);
 
+    //Живой расчёт: правки строк и включение групп
+    connect(visualizer, &AccuracyVisualizer::rowChanged, this, &AccuracyWindow::onRowChanged);
+    connect(visualizer, &AccuracyVisualizer::groupSelectionChanged, this, &AccuracyWindow::onGroupSelectionChanged);
+
+    //Стандарт оценки: смена перестраивает отчёт по уже накопленным шагам
+    for (const auto& s : EvaluationStandard::available())
+        ui->standardBox->addItem(s->title(), s->id());
+    standard = EvaluationStandard::available().first();
+    connect(ui->standardBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &AccuracyWindow::onStandardChanged);
 
 }
 
@@ -52,12 +68,12 @@ AccuracyWindow::~AccuracyWindow()
     delete ui;
 }
 
-void AccuracyWindow::setMeasurementData(const DataMeasurement& copiedMeasurement, double base)
+void AccuracyWindow::setMeasurementData(const MeasurementSnapshot& snapshot, double base)
 {
-    if (copiedMeasurement.groups().isEmpty()) {
+    if (snapshot.isEmpty()) {
         QMessageBox::warning(this, "Ошибка данных", "Измерения отсутствуют.");
     }
-    measurement = copiedMeasurement;
+    measurement = snapshot;
     basePoint = base;
 
     state->setState(AccuracyWindowState::Idle);
@@ -70,6 +86,7 @@ void AccuracyWindow::onStateChanged(AccuracyWindowState s)
     case AccuracyWindowState::Idle:
     {
         visualizer->setTable(measurement);
+        resetLiveAccuracy();
         break;
     }
     case AccuracyWindowState::Editing:
@@ -81,6 +98,7 @@ void AccuracyWindow::onStateChanged(AccuracyWindowState s)
     case AccuracyWindowState::Resetting:
     {
         visualizer->setTable(measurement);
+        resetLiveAccuracy();
         break;
     }
 
@@ -89,7 +107,7 @@ void AccuracyWindow::onStateChanged(AccuracyWindowState s)
         // 1. Получаем копию слепка из визуализатора
         QVector<TableRow> snapshot = visualizer->prepareSnapshot();
 
-        // 2. Парсим копию в новый DataMeasurement
+        // 2. Парсим копию в новый снимок
         measurement = AccuracyDataSaver::extractFromModel(snapshot);
 
         // 3. Назад в Idle
@@ -102,14 +120,11 @@ void AccuracyWindow::onStateChanged(AccuracyWindowState s)
         // 1. Получаем актуальный слепок с таблицы
         QVector<TableRow> snapshot = visualizer->prepareSnapshot();
 
-        // 2. Парсим в новый временный measurement
-        DataMeasurement tempMeasurement = AccuracyDataSaver::extractFromModel(snapshot);
-
-        // 3. Вызываем калькулятор
-        AccuracyResultList results = AccuracyCalculator::compute(tempMeasurement);
+        // 2. Парсим в новый снимок — он же источник для смены стандарта
+        calculated = AccuracyDataSaver::extractFromModel(snapshot);
 
-        // 4. Показываем результаты пользователю
-        visualizer->setResultTable(results);
+        // 3–4. Считаем по выбранному стандарту и показываем результаты
+        showCalculated();
 
         // 5. Сохраняем в history (можно потом использовать)
          //dataSaver.appendResult(tempMeasurement, results);
@@ -130,24 +145,30 @@ void AccuracyWindow::onStateChanged(AccuracyWindowState s)
 void AccuracyWindow::onAddRowToGroup(int groupId)
 {
     visualizer->addRowToGroup(groupId);
+    resetLiveAccuracy();
     state->setState(AccuracyWindowState::Editing);
 }
 
 void AccuracyWindow::onAddGroup()
 {
     visualizer->addGroup();
+    resetLiveAccuracy();
     state->setState(AccuracyWindowState::Editing);
 }
 
 void AccuracyWindow::onDeleteGroup(int groupId)
 {
     visualizer->deleteGroup(groupId);
+    resetLiveAccuracy();
+    showLiveResults();
     state->setState(AccuracyWindowState::Editing);
 }
 
 void AccuracyWindow::onDeleteRowClicked(int row)
 {
     visualizer->deleteRow(row);
+    liveAccuracy.removeRow(row);
+    showLiveResults();
     state->setState(AccuracyWindowState::Editing);
 }
 
@@ -166,8 +187,95 @@ void AccuracyWindow::onCalculateButtonClicked()
     state->setState(AccuracyWindowState::Calculating);
 }
 
+// ─────────────────────────────────────────────────────
+// Доверительные интервалы итогов по текущей таблице
+// ─────────────────────────────────────────────────────
+void AccuracyWindow::onUncertaintyClicked()
+{
+    // строки таблицы не несут сырых окон — только бутстреп повторов
+    const MeasurementSnapshot table = AccuracyDataSaver::extractFromModel(visualizer->prepareSnapshot());
+    UncertaintySettings settings;
+
+    QGuiApplication::setOverrideCursor(Qt::WaitCursor);
+    const UncertaintyReport report = UncertaintyEngine::estimate(table, settings);
+    QGuiApplication::restoreOverrideCursor();
+
+    if (report.isEmpty()) {
+        QMessageBox::warning(this, "Доверительные интервалы", "Нет выбранных групп с измерениями.");
+        return;
+    }
+
+    QString text = QString("Бутстреп повторов, %1 реализаций, уровень доверия %2 %\n")
+                       .arg(settings.draws).arg(settings.confidence * 100.0, 0, 'f', 0);
+    auto mm = [](double v) { return qIsNaN(v) ? QString("—") : QString::number(v, 'f', 4); };
+    for (const GroupUncertainty& g : report) {
+        text += QString("\nГруппа №%1\n").arg(g.groupId);
+        for (const UncertaintyInterval& f : g.figures)
+            text += QString("  %1 = %2 мм, интервал [%3; %4], СКО %5 мм\n")
+                        .arg(f.label, mm(f.estimate), mm(f.low), mm(f.high), mm(f.stddev));
+    }
+    QMessageBox::information(this, "Доверительные интервалы", text);
+}
+
 void AccuracyWindow::onCellEdited(int row, int column)
 {
     visualizer->onCellEdited(row, column);
     state->setState(AccuracyWindowState::Editing);
 }
+
+void AccuracyWindow::onRowChanged(int row, const TableRow& after)
+{
+    liveAccuracy.updateRow(row, after);
+    showLiveResults();
+}
+
+void AccuracyWindow::onGroupSelectionChanged(int groupId, bool selected)
+{
+    liveAccuracy.setGroupSelected(groupId, selected);
+    showLiveResults();
+}
+
+// ─────────────────────────────────────────────────────
+// Живой расчёт: пересборка после структурных правок и показ
+// ─────────────────────────────────────────────────────
+void AccuracyWindow::resetLiveAccuracy()
+{
+    liveAccuracy.reset(visualizer->m_tableModel);
+}
+
+void AccuracyWindow::showLiveResults()
+{
+    liveShown = true;
+    if (isIsoStandard())
+        visualizer->setResultTable(liveAccuracy.results());
+    else
+        visualizer->setStandardReport(standard->evaluate(liveAccuracy.selectedStats()));
+}
+
+// ─────────────────────────────────────────────────────
+// Стандарт оценки: расчёт по снимку и переключение
+// ─────────────────────────────────────────────────────
+bool AccuracyWindow::isIsoStandard() const
+{
+    return !standard || standard->id() == Iso2302Standard::kId;
+}
+
+void AccuracyWindow::showCalculated()
+{
+    liveShown = false;
+    if (isIsoStandard())
+        visualizer->setResultTable(AccuracyEngine::compute(calculated));
+    else
+        visualizer->setStandardReport(standard->evaluate(EvaluationStandard::selectedGroups(calculated)));
+}
+
+void AccuracyWindow::onStandardChanged(int index)
+{
+    standard = EvaluationStandard::byId(ui->standardBox->itemData(index).toString());
+
+    // накопители шагов уже есть — строки измерений не перечитываются
+    if (liveShown)
+        showLiveResults();
+    else if (!calculated.isEmpty())
+        showCalculated();
+}
@@ -2,8 +2,10 @@
 #define ACCURACYWINDOW_H
 
 #include <QMainWindow>
-#include "datameasurement.h"
+#include "measurementsnapshot.h"
 #include "accuracystate.h"
+#include "incrementalaccuracy.h"
+#include "evaluationstandard.h"
 
 class AccuracyVisualizer;
 namespace Ui { class AccuracyWindow; }
@@ -16,7 +18,7 @@ public:
     explicit AccuracyWindow(QWidget* parent = nullptr);
     ~AccuracyWindow();
 
-    void setMeasurementData(const DataMeasurement& copiedMeasurement, double basePoint);
+    void setMeasurementData(const MeasurementSnapshot& snapshot, double basePoint);
 
 private slots:
     void onDeleteRowClicked(int row);
@@ -30,17 +32,32 @@ private slots:
     void onStateChanged(AccuracyWindowState state);
 
     void onCalculateButtonClicked();
+    void onUncertaintyClicked();
 
     void onCellEdited(int row, int column);
 
+    void onRowChanged(int row, const TableRow& after);
+    void onGroupSelectionChanged(int groupId, bool selected);
+
+    void onStandardChanged(int index);
 
 private:
     Ui::AccuracyWindow* ui = nullptr;
     AccuracyState* state = nullptr;
     AccuracyVisualizer* visualizer = nullptr;
 
-    DataMeasurement measurement;
+    MeasurementSnapshot measurement;   // неизменяемый снимок — основное окно продолжает писать своё
     double basePoint = 0.0;
+
+    IncrementalAccuracy liveAccuracy;  // живой расчёт по правкам таблицы
+    void resetLiveAccuracy();          // пересобрать по модели таблицы (структурные правки)
+    void showLiveResults();            // показать текущий живой результат
+
+    EvaluationStandard::Ptr standard;  // выбранный стандарт оценки
+    MeasurementSnapshot calculated;    // снимок последнего «Рассчитать»
+    bool liveShown = false;            // на экране живой результат, а не calculated
+    bool isIsoStandard() const;        // ISO 230-2 — полная таблица AccuracyEngine
+    void showCalculated();             // показать calculated по выбранному стандарту
 };
 
 #endif // ACCURACYWINDOW_H
@@ -0,0 +1,45 @@
+#include "evaluationstandard.h"
+#include "iso2302standard.h"
+#include "vdi3441standard.h"
+#include "jisb6192standard.h"
+
+StandardReport EvaluationStandard::evaluate(const GroupList& groups) const
+{
+    StandardReport report;
+    report.title = title();
+    report.stepColumns = stepColumns();
+    report.groups.reserve(groups.size());
+    for (const auto* g : groups) {
+        StandardGroupReport r = evaluateGroup(*g);
+        if (!r.steps.isEmpty())                       // как в AccuracyCalculator: пустая группа не выводится
+            report.groups.append(r);
+    }
+    return report;
+}
+
+EvaluationStandard::GroupList EvaluationStandard::selectedGroups(const MeasurementSnapshot& snapshot)
+{
+    GroupList groups;
+    for (int g = 0; g < snapshot.groupCount(); ++g)
+        if (snapshot.group(g).groupSelected[0])
+            groups.append(&snapshot.groupStats(g));
+    return groups;
+}
+
+const QVector<EvaluationStandard::Ptr>& EvaluationStandard::available()
+{
+    static const QVector<Ptr> standards = {
+        std::make_shared<Iso2302Standard>(),
+        std::make_shared<Vdi3441Standard>(),
+        std::make_shared<JisB6192Standard>()
+    };
+    return standards;
+}
+
+EvaluationStandard::Ptr EvaluationStandard::byId(const QString& id)
+{
+    for (const Ptr& s : available())
+        if (s->id() == id)
+            return s;
+    return nullptr;
+}
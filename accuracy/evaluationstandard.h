@@ -0,0 +1,67 @@
+#ifndef EVALUATIONSTANDARD_H
+#define EVALUATIONSTANDARD_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <memory>
+#include "measurementsnapshot.h"
+#include "stepstatistics.h"
+
+// ─────────────────────────────────────────────────────
+// Отчёт по стандарту в общем виде: колонки шагов и итоги группы
+// ─────────────────────────────────────────────────────
+
+struct StandardFigure {
+    QString label;                       // обозначение и название, с единицами
+    double value = 0.0;                  // NaN — нет данных
+};
+
+struct StandardStepRow {
+    int stepNumber = 0;
+    double expected = 0.0;               // номинал (NaN — нет)
+    QVector<double> values;              // по StandardReport::stepColumns
+};
+
+struct StandardGroupReport {
+    QVector<StandardStepRow> steps;      // шаги по возрастанию номера
+    QVector<StandardFigure> totals;      // итоги по оси
+};
+
+struct StandardReport {
+    QString title;                       // название стандарта
+    QStringList stepColumns;             // подписи колонок шага
+    QVector<StandardGroupReport> groups; // выбранные группы по порядку
+};
+
+// ─────────────────────────────────────────────────────
+// Стандарт оценки точности позиционирования
+// ─────────────────────────────────────────────────────
+// Работает только по накопителям шагов (StepStatistics::GroupStats), которые уже
+// лежат в DataMeasurement, снимке и живом расчёте, — смена стандарта не
+// перечитывает строки измерений. Показатели шага берутся из общего ядра
+// AccuracyCalculator::computeStep.
+
+class EvaluationStandard
+{
+public:
+    using GroupList = QVector<const StepStatistics::GroupStats*>;
+
+    virtual ~EvaluationStandard() = default;
+
+    virtual QString id() const = 0;                   // ключ для настроек
+    virtual QString title() const = 0;                // название для пользователя
+    virtual QStringList stepColumns() const = 0;      // колонки строки шага
+    virtual StandardGroupReport evaluateGroup(const StepStatistics::GroupStats& steps) const = 0;
+
+    StandardReport evaluate(const GroupList& groups) const; // все выбранные группы
+
+    static GroupList selectedGroups(const MeasurementSnapshot& snapshot); // накопители выбранных групп
+
+    // ───── Реестр стандартов ─────
+    using Ptr = std::shared_ptr<const EvaluationStandard>;
+    static const QVector<Ptr>& available();           // в порядке показа, первый — по умолчанию
+    static Ptr byId(const QString& id);               // nullptr — нет такого
+};
+
+#endif // EVALUATIONSTANDARD_H
@@ -0,0 +1,181 @@
+#include "incrementalaccuracy.h"
+#include <QSet>
+#include <algorithm>
+#include <cmath>
+
+// ─────────────────────────────────────────────────────
+// Что задела одна правка
+// ─────────────────────────────────────────────────────
+struct IncrementalAccuracy::Delta
+{
+    QMap<int, QSet<int>> touched;                      // группа → шаги для пересчёта
+};
+
+// ─────────────────────────────────────────────────────
+// Строка участвует в расчёте так же, как через extractFromModel + StepStatistics
+// ─────────────────────────────────────────────────────
+bool IncrementalAccuracy::contributes(const TableRow& row)
+{
+    return row.type == TableRow::Type::Measurement
+        && !std::isnan(row.distance)
+        && StepAccumulator::counts(row.direction, row.deviation);
+}
+
+// ─────────────────────────────────────────────────────
+// Полная пересборка по модели таблицы
+// ─────────────────────────────────────────────────────
+void IncrementalAccuracy::reset(const QVector<TableRow>& tableModel)
+{
+    m_rows = tableModel;
+    m_groups.clear();
+
+    Delta delta;
+    for (int i = 0; i < m_rows.size(); ++i) {
+        const TableRow& r = m_rows[i];
+        if (r.type == TableRow::Type::GroupHeader)
+            m_groups[r.groupId].selected = r.selectedFor;
+        else
+            link(i, r, delta);
+    }
+    refresh(delta);
+}
+
+// ─────────────────────────────────────────────────────
+// Правка строки: она уходит из старого шага и приходит в новый
+// ─────────────────────────────────────────────────────
+void IncrementalAccuracy::updateRow(int row, const TableRow& after)
+{
+    if (row < 0 || row >= m_rows.size())
+        return;
+
+    Delta delta;
+    unlink(row, m_rows[row], delta);
+    m_rows[row] = after;
+    link(row, after, delta);
+    refresh(delta);
+}
+
+// ─────────────────────────────────────────────────────
+// Удаление строки
+// ─────────────────────────────────────────────────────
+void IncrementalAccuracy::removeRow(int row)
+{
+    if (row < 0 || row >= m_rows.size())
+        return;
+
+    Delta delta;
+    unlink(row, m_rows[row], delta);
+    m_rows.removeAt(row);
+
+    // строки ниже поднялись на одну — поправляем их номера в шагах
+    for (auto g = m_groups.begin(); g != m_groups.end(); ++g)
+        for (auto it = g->stepRows.begin(); it != g->stepRows.end(); ++it)
+            for (int& i : it.value())
+                if (i > row)
+                    --i;
+
+    refresh(delta);
+}
+
+// ─────────────────────────────────────────────────────
+// Включение группы — накопители не меняются
+// ─────────────────────────────────────────────────────
+void IncrementalAccuracy::setGroupSelected(int groupId, bool selected)
+{
+    m_groups[groupId].selected = selected;
+    for (TableRow& r : m_rows)
+        if (r.type == TableRow::Type::GroupHeader && r.groupId == groupId)
+            r.selectedFor = selected;
+}
+
+// ─────────────────────────────────────────────────────
+// Сборка результатов из готовых строк шагов и итогов
+// ─────────────────────────────────────────────────────
+AccuracyResultList IncrementalAccuracy::results() const
+{
+    AccuracyResultList all;
+    for (const GroupState& g : m_groups) {
+        if (!g.selected || g.stepResults.isEmpty())
+            continue;
+        for (const AccuracyResult& r : g.stepResults)
+            all.append(r);
+        all.append(g.total);
+    }
+    return all;
+}
+
+QVector<const StepStatistics::GroupStats*> IncrementalAccuracy::selectedStats() const
+{
+    QVector<const StepStatistics::GroupStats*> stats;
+    for (const GroupState& g : m_groups)
+        if (g.selected && !g.stepResults.isEmpty())
+            stats.append(&g.steps);
+    return stats;
+}
+
+// ─────────────────────────────────────────────────────
+// Строки шага хранятся по возрастанию номера — в порядке таблицы
+// ─────────────────────────────────────────────────────
+void IncrementalAccuracy::link(int row, const TableRow& r, Delta& delta)
+{
+    if (!contributes(r))
+        return;
+
+    QVector<int>& rows = m_groups[r.groupId].stepRows[r.stepNumber];
+    rows.insert(std::lower_bound(rows.begin(), rows.end(), row), row);
+    delta.touched[r.groupId].insert(r.stepNumber);
+}
+
+void IncrementalAccuracy::unlink(int row, const TableRow& r, Delta& delta)
+{
+    if (!contributes(r))
+        return;
+
+    auto g = m_groups.find(r.groupId);
+    if (g == m_groups.end())
+        return;
+    auto rows = g->stepRows.find(r.stepNumber);
+    if (rows == g->stepRows.end())
+        return;
+
+    auto it = std::lower_bound(rows->begin(), rows->end(), row);
+    if (it != rows->end() && *it == row)
+        rows->erase(it);
+    delta.touched[r.groupId].insert(r.stepNumber);
+}
+
+// ─────────────────────────────────────────────────────
+// Пересчёт затронутых шагов и итогов их групп. Накопители шага набираются
+// заново по его строкам: обратный шаг Уэлфорда дал бы другие биты, чем полный расчёт
+// ─────────────────────────────────────────────────────
+void IncrementalAccuracy::refresh(const Delta& delta)
+{
+    for (auto t = delta.touched.cbegin(); t != delta.touched.cend(); ++t) {
+        auto g = m_groups.find(t.key());
+        if (g == m_groups.end())
+            continue;
+
+        for (int stepNumber : t.value()) {
+            const QVector<int> rows = g->stepRows.value(stepNumber);
+            if (rows.isEmpty()) {                          // шаг опустел — убираем целиком
+                g->stepRows.remove(stepNumber);
+                g->steps.remove(stepNumber);
+            } else {
+                StepAccumulator acc;                       // ожидаемое — от первой прямой строки
+                for (int i : rows)
+                    acc.add(m_rows[i].direction, m_rows[i].deviation, m_rows[i].expected);
+                g->steps[stepNumber] = acc;
+            }
+
+            AccuracyResult r;
+            auto step = g->steps.constFind(stepNumber);
+            if (step != g->steps.cend() && AccuracyCalculator::computeStep(stepNumber, step.value(), r))
+                g->stepResults[stepNumber] = r;
+            else
+                g->stepResults.remove(stepNumber);
+        }
+
+        // E, M, R, A — экстремумы по шагам группы, их не снять обратным шагом
+        g->total = AccuracyCalculator::computeTotal(g->stepResults.values());
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef INCREMENTALACCURACY_H
+#define INCREMENTALACCURACY_H
+
+#include <QVector>
+#include <QMap>
+#include "accuracyvisualizer.h"
+#include "accuracycalculator.h"
+
+// ─────────────────────────────────────────────────────
+// Живой расчёт точности по правкам таблицы окна точности
+// ─────────────────────────────────────────────────────
+// Держит копию модели таблицы, строки каждого (группа, шаг) и их накопители.
+// Правка строки перестраивает накопители только затронутых шагов — заново по их
+// строкам в порядке таблицы, как StepStatistics::rebuild, — после чего пересчитываются
+// эти шаги и итог их группы (E, M, R, A). Порядок сложения тот же, поэтому результат
+// побитово совпадает с AccuracyDataSaver::extractFromModel → AccuracyCalculator::compute.
+
+class IncrementalAccuracy
+{
+public:
+    // Полная пересборка — после открытия таблицы и структурных правок (группы, новые строки)
+    void reset(const QVector<TableRow>& tableModel);
+
+    // Изменилась строка измерения с индексом row модели таблицы
+    void updateRow(int row, const TableRow& after);
+
+    // Удалена строка с индексом row (индексы ниже сдвигаются вверх)
+    void removeRow(int row);
+
+    // Включение/выключение группы в расчёт
+    void setGroupSelected(int groupId, bool selected);
+
+    // Результаты в формате AccuracyCalculator::compute (выбранные группы по порядку)
+    AccuracyResultList results() const;
+
+    // Накопители выбранных групп с результатом — для других стандартов оценки
+    QVector<const StepStatistics::GroupStats*> selectedStats() const;
+
+private:
+    struct GroupState {
+        bool selected = true;                          // участвует в расчёте
+        StepStatistics::GroupStats steps;              // шаг → накопители
+        QMap<int, QVector<int>> stepRows;              // шаг → строки с вкладом, по порядку таблицы
+        QMap<int, AccuracyResult> stepResults;         // шаг → готовая строка результата
+        AccuracyResult total;                          // итог группы
+    };
+
+    struct Delta;                                      // затронутые шаги одной правки
+
+    static bool contributes(const TableRow& row);      // строка попадает в расчёт
+
+    void link(int row, const TableRow& r, Delta& delta);   // строка даёт вклад в свой шаг
+    void unlink(int row, const TableRow& r, Delta& delta); // строка больше не даёт вклад
+    void refresh(const Delta& delta);                  // накопители, шаги и итоги затронутых групп
+
+    QVector<TableRow> m_rows;                          // копия модели таблицы
+    QMap<int, GroupState> m_groups;                    // по номеру группы
+};
+
+#endif // INCREMENTALACCURACY_H
@@ -0,0 +1,40 @@
+#include "iso2302standard.h"
+#include "accuracycalculator.h"
+
+QStringList Iso2302Standard::stepColumns() const
+{
+    return { "x̄⁺, мм", "x̄⁻, мм", "x̄ᵢ, мм", "Bᵢ, мм",
+             "s⁺, мм", "s⁻, мм", "R⁺, мм", "R⁻, мм", "Rᵢ, мм" };
+}
+
+StandardGroupReport Iso2302Standard::evaluateGroup(const StepStatistics::GroupStats& steps) const
+{
+    StandardGroupReport report;
+    const AccuracyResultList results = AccuracyCalculator::computeGroup(steps);
+
+    for (const AccuracyResult& r : results) {
+        if (r.stepNumber != -1) {
+            report.steps.append({ r.stepNumber, r.expectedPosition, {
+                r.meanForward, r.meanBackward, r.meanBidirectional, r.reversalError,
+                r.stddevForward, r.stddevBackward,
+                r.repeatabilityForward, r.repeatabilityBackward, r.repeatabilityBidirectional } });
+            continue;
+        }
+
+        report.totals = {
+            { "E⁺ — сист. погрешность ↑, мм", r.systematicForward },
+            { "E⁻ — сист. погрешность ↓, мм", r.systematicBackward },
+            { "R⁺ — повторяемость ↑, мм",      r.repeatabilityForward },
+            { "R⁻ — повторяемость ↓, мм",      r.repeatabilityBackward },
+            { "A⁺ — точность ↑, мм",           r.accuracyForward },
+            { "A⁻ — точность ↓, мм",           r.accuracyBackward },
+            { "E — сист. погрешность, мм",      r.systematicBidirectional },
+            { "M — диапазон средних, мм",       r.meanRange },
+            { "B — макс. реверс, мм",           r.systematicError },
+            { "B̄ — средний реверс, мм",         r.meanReversal },
+            { "R — повторяемость, мм",          r.repeatabilityBidirectional },
+            { "A — точность, мм",               r.positioningAccuracy }
+        };
+    }
+    return report;
+}
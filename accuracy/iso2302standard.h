@@ -0,0 +1,18 @@
+#ifndef ISO2302STANDARD_H
+#define ISO2302STANDARD_H
+
+#include "evaluationstandard.h"
+
+// ГОСТ ISO 230-2—2016: весь набор AccuracyCalculator::computeGroup в общем виде отчёта
+class Iso2302Standard : public EvaluationStandard
+{
+public:
+    static constexpr const char* kId = "iso230-2";
+
+    QString id() const override { return kId; }
+    QString title() const override { return "ГОСТ ISO 230-2—2016"; }
+    QStringList stepColumns() const override;
+    StandardGroupReport evaluateGroup(const StepStatistics::GroupStats& steps) const override;
+};
+
+#endif // ISO2302STANDARD_H
@@ -0,0 +1,34 @@
+#include "jisb6192standard.h"
+#include "accuracycalculator.h"
+
+QStringList JisB6192Standard::stepColumns() const
+{
+    return { "x̄⁺, мм", "x̄⁻, мм", "Потерянный ход Bᵢ, мм",
+             "Повторяемость ±R⁺/2, мм", "Повторяемость ±R⁻/2, мм", "Повторяемость ±Rᵢ/2, мм" };
+}
+
+StandardGroupReport JisB6192Standard::evaluateGroup(const StepStatistics::GroupStats& steps) const
+{
+    StandardGroupReport report;
+    const AccuracyResultList results = AccuracyCalculator::computeGroup(steps);
+
+    for (const AccuracyResult& r : results) {
+        if (r.stepNumber != -1) {
+            report.steps.append({ r.stepNumber, r.expectedPosition, {
+                r.meanForward, r.meanBackward, r.reversalError,
+                r.repeatabilityForward / 2.0, r.repeatabilityBackward / 2.0,
+                r.repeatabilityBidirectional / 2.0 } });
+            continue;
+        }
+
+        report.totals = {
+            { "Точность позиционирования A, мм",   r.positioningAccuracy },
+            { "Точность позиционирования ↑ A⁺, мм", r.accuracyForward },
+            { "Точность позиционирования ↓ A⁻, мм", r.accuracyBackward },
+            { "Повторяемость ±R/2, мм",            r.repeatabilityBidirectional / 2.0 },
+            { "Потерянный ход Bmax, мм",           r.systematicError },
+            { "Средний потерянный ход B̄, мм",      r.meanReversal }
+        };
+    }
+    return report;
+}
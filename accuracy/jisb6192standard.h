@@ -0,0 +1,18 @@
+#ifndef JISB6192STANDARD_H
+#define JISB6192STANDARD_H
+
+#include "evaluationstandard.h"
+
+// JIS B 6192 (редакция 1999 г. — принятие ISO 230-2:1997): формулы ISO по шагам
+// (ядро AccuracyCalculator), отчёт — в принятой в JIS форме: точность позиционирования
+// A (и по направлениям), повторяемость как ±R/2, потерянный ход (lost motion) — Bmax и B̄.
+class JisB6192Standard : public EvaluationStandard
+{
+public:
+    QString id() const override { return "jisb6192"; }
+    QString title() const override { return "JIS B 6192"; }
+    QStringList stepColumns() const override;
+    StandardGroupReport evaluateGroup(const StepStatistics::GroupStats& steps) const override;
+};
+
+#endif // JISB6192STANDARD_H
@@ -0,0 +1,265 @@
+#include "uncertaintyengine.h"
+#include "cycleplanner.h"
+#include <QtConcurrent>
+#include <QtMath>                         // M_PI
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// индекс в [0, n) без деления (умножение со сдвигом)
+inline int uniformIndex(quint32 x, int n)
+{
+    return int((quint64(x) * quint64(n)) >> 32);
+}
+
+// N(0, 1) по паре 32-битных чисел (Бокс — Мюллер), u1 ∈ (0, 1]
+inline double normal(quint32 a, quint32 b)
+{
+    const double u1 = (double(a) + 1.0) * (1.0 / 4294967296.0);
+    const double u2 = double(b) * (1.0 / 4294967296.0);
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+}
+
+// ─────────────────────────────────────────────────────
+// Показатели итога группы: двунаправленные или по единственному направлению
+// ─────────────────────────────────────────────────────
+struct FigureDef {
+    const char* label;
+    double AccuracyResult::* field;
+};
+
+const QVector<FigureDef> kBidirectional = {
+    { "A",  &AccuracyResult::positioningAccuracy },
+    { "E",  &AccuracyResult::systematicBidirectional },
+    { "M",  &AccuracyResult::meanRange },
+    { "R",  &AccuracyResult::repeatabilityBidirectional },
+    { "B",  &AccuracyResult::systematicError }
+};
+const QVector<FigureDef> kForward = {
+    { "A⁺", &AccuracyResult::accuracyForward },
+    { "E⁺", &AccuracyResult::systematicForward },
+    { "R⁺", &AccuracyResult::repeatabilityForward }
+};
+const QVector<FigureDef> kBackward = {
+    { "A⁻", &AccuracyResult::accuracyBackward },
+    { "E⁻", &AccuracyResult::systematicBackward },
+    { "R⁻", &AccuracyResult::repeatabilityBackward }
+};
+
+const QVector<FigureDef>& figuresFor(const AccuracyResult& total)
+{
+    if (!std::isnan(total.positioningAccuracy)) return kBidirectional;
+    if (!std::isnan(total.accuracyForward))     return kForward;
+    return kBackward;
+}
+
+AccuracyResult totalOf(const StepStatistics::GroupStats& stats)
+{
+    const AccuracyResultList results = AccuracyCalculator::computeGroup(stats);
+    if (results.isEmpty() || results.last().stepNumber != -1) {
+        AccuracyResult none;
+        none.positioningAccuracy = none.accuracyForward = none.accuracyBackward
+            = std::numeric_limits<double>::quiet_NaN();
+        return none;
+    }
+    return results.last();
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────
+// Точка входа: модели групп → реализации на пуле потоков → перцентили
+// ─────────────────────────────────────────────────────
+UncertaintyReport UncertaintyEngine::estimate(const MeasurementSnapshot& snapshot,
+                                              const UncertaintySettings& settings)
+{
+    UncertaintyReport report;
+    if (settings.draws <= 0)
+        return report;
+
+    // ───── 1. Исходные данные выбранных групп, как у AccuracyEngine ─────
+    QVector<GroupModel> models;
+    for (int g = 0; g < snapshot.groupCount(); ++g) {
+        if (!snapshot.group(g).groupSelected[0])
+            continue;
+        GroupModel m = buildModel(snapshot, g, settings);
+        if (m.pools.isEmpty())
+            continue;
+        m.estimate = totalOf(m.stats);
+        models.append(m);
+    }
+
+    // ───── 2. Место под реализации: каждая задача пишет только свои индексы ─────
+    QVector<QVector<QVector<double>>> draws(models.size());
+    QVector<QVector<double*>> out(models.size());
+    for (int g = 0; g < models.size(); ++g) {
+        const int figures = figuresFor(models[g].estimate).size();
+        draws[g].resize(figures);
+        for (int f = 0; f < figures; ++f) {
+            draws[g][f].fill(std::numeric_limits<double>::quiet_NaN(), settings.draws);
+            out[g].append(draws[g][f].data());
+        }
+    }
+
+    QVector<Chunk> chunks;
+    for (int b = 0; b < settings.draws; b += kChunkDraws)
+        chunks.append({ b, std::min(b + kChunkDraws, settings.draws) });
+
+    auto kernel = [&](const Chunk& c) {
+        for (int g = 0; g < models.size(); ++g)
+            runChunk(c, g, models[g], settings, out[g]);
+    };
+
+    if (settings.draws < kParallelDraws) {           // потоки дороже самой работы
+        for (const Chunk& c : chunks) kernel(c);
+    } else {
+        QtConcurrent::blockingMap(chunks, kernel);
+    }
+
+    // ───── 3. Интервалы ─────
+    for (int g = 0; g < models.size(); ++g) {
+        GroupUncertainty gu;
+        gu.groupId = models[g].groupId;
+        const QVector<FigureDef>& defs = figuresFor(models[g].estimate);
+        for (int f = 0; f < defs.size(); ++f)
+            gu.figures.append(summarize(QString::fromUtf8(defs[f].label),
+                                        models[g].estimate.*defs[f].field,
+                                        draws[g][f], settings.confidence));
+        report.append(gu);
+    }
+    return report;
+}
+
+// ─────────────────────────────────────────────────────
+// Модель группы: учтённые значения по (шаг, направление) и u каждого сохранения
+// ─────────────────────────────────────────────────────
+UncertaintyEngine::GroupModel UncertaintyEngine::buildModel(const MeasurementSnapshot& snapshot, int g,
+                                                            const UncertaintySettings& settings)
+{
+    const MeasurementColumns& cols = snapshot.group(g);
+    const RawRecordStore& raw = snapshot.rawRecords();
+    const bool monteCarlo = settings.method == UncertaintySettings::Method::MonteCarlo;
+
+    GroupModel m;
+    m.groupId = cols.groupId.value(0);
+    m.stats = snapshot.groupStats(g);
+
+    // выборки одного шага и направления из разных серий сливаются
+    QMap<QPair<int, int>, QVector<int>> rowsOf;
+    for (int s = 0; s < cols.seriesCount(); ++s) {
+        const ApproachDirection dir = cols.seriesDirection[s];
+        for (int i = cols.seriesBegin(s); i < cols.seriesEnd(s); ++i)
+            if (StepAccumulator::counts(dir, cols.deviation[i]))
+                rowsOf[qMakePair(cols.seriesStep[s], int(dir))].append(i);
+    }
+
+    for (auto it = rowsOf.cbegin(); it != rowsOf.cend(); ++it) {
+        Pool p;
+        p.stepNumber = it.key().first;
+        p.direction = ApproachDirection(it.key().second);
+        p.begin = m.values.size();
+        for (int i : it.value()) {
+            m.values.append(cols.deviation[i]);
+            if (!monteCarlo)
+                continue;
+            double u = settings.perSaveSigma;
+            const int w = cols.rawIndex[i];
+            if (w >= 0 && w < raw.size()) {
+                const QVector<double> window = raw.window(w);
+                if (window.size() >= 3)                  // σ среднего окна = σ шума / √n
+                    u = CyclePlanner::noiseFloor(window) / std::sqrt(double(window.size()));
+            }
+            m.sigma.append(u);
+        }
+        p.end = m.values.size();
+        m.pools.append(p);
+    }
+    return m;
+}
+
+// ─────────────────────────────────────────────────────
+// Реализации [begin, end) одной группы: накопители набираются заново и считаются ядром
+// ─────────────────────────────────────────────────────
+void UncertaintyEngine::runChunk(const Chunk& chunk, int g, const GroupModel& m,
+                                 const UncertaintySettings& settings, const QVector<double*>& out)
+{
+    const Philox rng(settings.seed);
+    const bool monteCarlo = settings.method == UncertaintySettings::Method::MonteCarlo;
+    const QVector<FigureDef>& defs = figuresFor(m.estimate);   // набор — по исходному итогу
+
+    // своя копия накопителей на задачу; ожидаемые значения шагов остаются исходными
+    StepStatistics::GroupStats stats = m.stats;
+    QVector<RunningStats*> target(m.pools.size());
+    for (int p = 0; p < m.pools.size(); ++p) {
+        StepAccumulator& acc = stats[m.pools[p].stepNumber];
+        target[p] = (m.pools[p].direction == ApproachDirection::Forward) ? &acc.forward : &acc.backward;
+    }
+
+    quint32 words[4];
+    for (int d = chunk.begin; d < chunk.end; ++d) {
+        for (RunningStats* rs : target)
+            *rs = RunningStats{};
+
+        for (int p = 0; p < m.pools.size(); ++p) {
+            const Pool& pool = m.pools[p];
+            const int n = pool.end - pool.begin;
+            RunningStats& rs = *target[p];
+
+            if (!monteCarlo) {                           // бутстреп: n индексов с возвращением
+                for (int k = 0; k < n; ++k) {
+                    if (k % 4 == 0)
+                        rng.block(quint32(d), quint32(g), quint32(p), quint32(k / 4), words);
+                    rs.add(m.values[pool.begin + uniformIndex(words[k % 4], n)]);
+                }
+            } else {                                     // u сохранения: значение + N(0, u²)
+                for (int k = 0; k < n; ++k) {
+                    if (k % 2 == 0)
+                        rng.block(quint32(d), quint32(g), quint32(p), quint32(k / 2), words);
+                    const double z = normal(words[2 * (k % 2)], words[2 * (k % 2) + 1]);
+                    rs.add(m.values[pool.begin + k] + m.sigma[pool.begin + k] * z);
+                }
+            }
+        }
+
+        const AccuracyResult total = totalOf(stats);
+        for (int f = 0; f < defs.size(); ++f)
+            out[f][d] = total.*defs[f].field;
+    }
+}
+
+// ─────────────────────────────────────────────────────
+// Перцентильный интервал по реализациям (линейная интерполяция между порядковыми статистиками)
+// ─────────────────────────────────────────────────────
+UncertaintyInterval UncertaintyEngine::summarize(const QString& label, double estimate,
+                                                 QVector<double> draws, double confidence)
+{
+    UncertaintyInterval iv;
+    iv.label = label;
+    iv.estimate = estimate;
+
+    draws.erase(std::remove_if(draws.begin(), draws.end(), [](double x) { return std::isnan(x); }),
+                draws.end());
+    iv.valid = draws.size();
+    if (draws.isEmpty())
+        return iv;
+
+    std::sort(draws.begin(), draws.end());
+
+    RunningStats rs;
+    for (double x : draws)
+        rs.add(x);
+    iv.mean = rs.mean;
+    iv.stddev = rs.stddev();
+
+    auto quantile = [&draws](double q) {
+        const double pos = q * (draws.size() - 1);
+        const int i = int(std::floor(pos));
+        const int j = std::min(i + 1, int(draws.size()) - 1);
+        return draws[i] + (pos - i) * (draws[j] - draws[i]);
+    };
+    const double tail = 0.5 * (1.0 - std::clamp(confidence, 0.0, 1.0));
+    iv.low = quantile(tail);
+    iv.high = quantile(1.0 - tail);
+    return iv;
+}
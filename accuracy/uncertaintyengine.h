@@ -0,0 +1,114 @@
+#ifndef UNCERTAINTYENGINE_H
+#define UNCERTAINTYENGINE_H
+
+#include <QString>
+#include <QVector>
+#include <limits>
+#include "accuracycalculator.h"
+
+// ─────────────────────────────────────────────
+// Доверительные интервалы итогов ISO 230-2 (A, E, M, R, B) методом Монте-Карло
+// ─────────────────────────────────────────────
+// Каждая реализация заново набирает значения шагов и считает группу тем же ядром
+// (AccuracyCalculator::computeGroup), интервал — перцентильный по всем реализациям.
+//   Bootstrap  — повторы каждого (шаг, направление) выбираются с возвращением;
+//   MonteCarlo — к каждому сохранению добавляется N(0, u²), u — по шуму его сырого окна
+//                (CyclePlanner::noiseFloor / √n), без окна — perSaveSigma.
+// Случайные числа — счётчиковый генератор Philox4x32-10: число определяется
+// (seed, реализация, группа, выборка, блок), а не историей потока, поэтому результат
+// не зависит от числа потоков и порядка выполнения реализаций.
+
+struct UncertaintySettings {
+    enum class Method { Bootstrap, MonteCarlo };
+
+    Method  method       = Method::Bootstrap;
+    int     draws        = 10000;                    // число реализаций (10⁴–10⁵)
+    double  confidence   = 0.95;                     // уровень доверия интервала
+    quint64 seed         = 0x43616C6962726978ull;    // ключ генератора
+    double  perSaveSigma = 0.0;                      // u сохранения без сырого окна, мм
+};
+
+struct UncertaintyInterval {
+    QString label;                                   // обозначение показателя
+    double estimate = std::numeric_limits<double>::quiet_NaN(); // по исходным данным
+    double mean     = std::numeric_limits<double>::quiet_NaN(); // среднее реализаций
+    double stddev   = std::numeric_limits<double>::quiet_NaN(); // СКО реализаций
+    double low      = std::numeric_limits<double>::quiet_NaN(); // нижняя граница
+    double high     = std::numeric_limits<double>::quiet_NaN(); // верхняя граница
+    int    valid    = 0;                             // реализаций с определённым значением
+};
+
+struct GroupUncertainty {
+    int groupId = 0;
+    QVector<UncertaintyInterval> figures;            // A, E, M, R, B (одно направление — A, E, R)
+};
+
+using UncertaintyReport = QVector<GroupUncertainty>;
+
+class UncertaintyEngine
+{
+public:
+    static constexpr int kParallelDraws = 1 << 8;    // меньше реализаций — в одном потоке
+    static constexpr int kChunkDraws    = 1 << 6;    // реализаций на задачу пула
+
+    static UncertaintyReport estimate(const MeasurementSnapshot& snapshot,
+                                      const UncertaintySettings& settings);
+
+    // Philox4x32-10 (Salmon et al., SC'11): блок из четырёх 32-битных чисел по счётчику и ключу
+    struct Philox {
+        quint32 k0, k1;
+
+        explicit Philox(quint64 seed) : k0(quint32(seed)), k1(quint32(seed >> 32)) {}
+
+        void block(quint32 c0, quint32 c1, quint32 c2, quint32 c3, quint32 out[4]) const
+        {
+            quint32 key0 = k0, key1 = k1;
+            for (int round = 0; round < 10; ++round) {
+                const quint64 p0 = quint64(0xD2511F53u) * c0;
+                const quint64 p1 = quint64(0xCD9E8D57u) * c2;
+                const quint32 n0 = quint32(p1 >> 32) ^ c1 ^ key0;
+                const quint32 n2 = quint32(p0 >> 32) ^ c3 ^ key1;
+                c1 = quint32(p1);
+                c3 = quint32(p0);
+                c0 = n0;
+                c2 = n2;
+                key0 += 0x9E3779B9u;                         // сдвиг ключа (Вейль)
+                key1 += 0xBB67AE85u;
+            }
+            out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+        }
+    };
+
+private:
+    // значения одного (шаг, направление) группы — диапазон в плоских массивах
+    struct Pool {
+        int stepNumber = 0;
+        ApproachDirection direction = ApproachDirection::Unknown;
+        int begin = 0;
+        int end = 0;
+    };
+
+    // исходные данные группы, общие для всех реализаций (только чтение)
+    struct GroupModel {
+        int groupId = 0;
+        StepStatistics::GroupStats stats;            // исходные накопители — шаблон реализации
+        AccuracyResult estimate;                     // итог по исходным данным
+        QVector<Pool> pools;
+        QVector<double> values;                      // учтённые отклонения по выборкам
+        QVector<double> sigma;                       // u сохранения (MonteCarlo)
+    };
+
+    struct Chunk {
+        int begin = 0;                               // реализации [begin, end)
+        int end = 0;
+    };
+
+    static GroupModel buildModel(const MeasurementSnapshot& snapshot, int g,
+                                 const UncertaintySettings& settings);
+    static void runChunk(const Chunk& chunk, int g, const GroupModel& m,
+                         const UncertaintySettings& settings, const QVector<double*>& out);
+    static UncertaintyInterval summarize(const QString& label, double estimate,
+                                         QVector<double> draws, double confidence);
+};
+
+#endif // UNCERTAINTYENGINE_H
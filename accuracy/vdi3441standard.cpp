@@ -0,0 +1,63 @@
+#include "vdi3441standard.h"
+#include "accuracycalculator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+QStringList Vdi3441Standard::stepColumns() const
+{
+    return { "x̄⁺, мм", "x̄⁻, мм", "x̄ⱼ, мм", "Uⱼ, мм", "s̄ⱼ, мм", "Psⱼ, мм" };
+}
+
+StandardGroupReport Vdi3441Standard::evaluateGroup(const StepStatistics::GroupStats& steps) const
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    StandardGroupReport report;
+
+    double meanLo = std::numeric_limits<double>::max(), meanHi = std::numeric_limits<double>::lowest();
+    double bandLo = meanLo, bandHi = meanHi;
+    double uMax = nan, uSum = 0.0, psMax = nan;
+    int uCount = 0;
+
+    for (auto it = steps.cbegin(); it != steps.cend(); ++it) {
+        AccuracyResult r;
+        if (!AccuracyCalculator::computeStep(it.key(), it.value(), r))
+            continue;
+
+        const bool both = r.countForward > 0 && r.countBackward > 0;
+        const bool fwd  = r.countForward > 0;
+        const double mean = both ? r.meanBidirectional : (fwd ? r.meanForward : r.meanBackward);
+        const double u    = both ? std::abs(r.reversalError) : nan;
+        const double s    = both ? 0.5 * (r.stddevForward + r.stddevBackward)
+                                 : (fwd ? r.stddevForward : r.stddevBackward);
+        const double ps   = 6.0 * s;
+
+        report.steps.append({ r.stepNumber, r.expectedPosition,
+                              { r.meanForward, r.meanBackward, mean, u, s, ps } });
+
+        // ───── свёртка итогов в том же проходе ─────
+        const double half = 0.5 * ((both ? u : 0.0) + ps);
+        meanLo = std::min(meanLo, mean);
+        meanHi = std::max(meanHi, mean);
+        bandLo = std::min(bandLo, mean - half);
+        bandHi = std::max(bandHi, mean + half);
+        psMax  = std::isnan(psMax) ? ps : std::max(psMax, ps);
+        if (both) {
+            uMax = std::isnan(uMax) ? u : std::max(uMax, u);
+            uSum += u;
+            ++uCount;
+        }
+    }
+
+    if (report.steps.isEmpty())
+        return report;
+
+    report.totals = {
+        { "Pa — отклонение позиции, мм",           meanHi - meanLo },
+        { "Umax — наиб. зона реверса, мм",         uMax },
+        { "Ū — средняя зона реверса, мм",          uCount ? uSum / uCount : nan },
+        { "Psmax — наиб. разброс позиции, мм",     psMax },
+        { "P — неопределённость позиционирования, мм", bandHi - bandLo }
+    };
+    return report;
+}
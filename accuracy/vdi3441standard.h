@@ -0,0 +1,20 @@
+#ifndef VDI3441STANDARD_H
+#define VDI3441STANDARD_H
+
+#include "evaluationstandard.h"
+
+// VDI/DGQ 3441: на позиции j — средние по направлениям, x̄ⱼ, зона реверса Uⱼ = |x̄⁺ − x̄⁻|,
+// средняя СКО s̄ⱼ = (s⁺ + s⁻)/2 и разброс позиции Psⱼ = 6·s̄ⱼ. Итоги оси: Pa — диапазон x̄ⱼ,
+// Umax, Ū, Psmax и неопределённость позиционирования
+// P = max(x̄ⱼ + (Uⱼ + Psⱼ)/2) − min(x̄ⱼ − (Uⱼ + Psⱼ)/2).
+// Позиция с одним направлением: x̄ⱼ и s̄ⱼ — по этому направлению, Uⱼ нет.
+class Vdi3441Standard : public EvaluationStandard
+{
+public:
+    QString id() const override { return "vdi3441"; }
+    QString title() const override { return "VDI/DGQ 3441"; }
+    QStringList stepColumns() const override;
+    StandardGroupReport evaluateGroup(const StepStatistics::GroupStats& steps) const override;
+};
+
+#endif // VDI3441STANDARD_H
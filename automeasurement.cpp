@@ -3,7 +3,7 @@
 #include "datameasurement.h"
 #include "typemeasurement.h"
 #include "settingsmanager.h"
-#include "calculatemesurement.h"
+#include "expectedtable.h"
 
 #include <algorithm>
 #include <QtGlobal>
@@ -39,28 +39,28 @@ AutoSavePlan AutoMeasurement::createPlan(const StepSettings& step_setting,
     plan.cfg.cooldownTicks     = 8;
     plan.cfg.exitSpeedMul      = 2.0;
     plan.cfg.exitDistance      = 0.005;
+    plan.cfg.useChangeDetector = true;
+    plan.cfg.changeDrift       = 0.5;
+    plan.cfg.changeArl         = 1000.0;
+    plan.cfg.settleSamples     = 16;
 
     // --- исходная точка: просто "последний шаг и сколько на нём уже измерений"
     int lastStep   = 1;
-        int measOnLast = 0;
-        if (data_mesurement && !data_mesurement->groups().isEmpty()) {
-            const auto& groups = data_mesurement->groups();
-            const auto& lastGroup = groups.last();
-            if (!lastGroup.steps.isEmpty()) {
-                const auto& lastSeries = lastGroup.steps.last();
-                lastStep   = std::max(1, lastSeries.stepNumber);
-                measOnLast = std::max(0, (int)lastSeries.measurements.size());
-            }
-     }
+    int measOnLast = 0;
+    if (data_mesurement) {
+        const DataMeasurement::Position last = data_mesurement->lastPosition(); // O(1) по хвосту колонок
+        if (last.series >= 0) {
+            lastStep   = std::max(1, last.step);
+            measOnLast = std::max(0, last.rows);
+        }
+    }
 
     // --- полезные локальные
     const int N = std::max(1, step_setting.count);                 // всего шагов
     const int repeatsTotal = std::max(1, step_setting.repeatCount);// повторов на шаг
 
-    auto expectedFor = [&](int s)->double {
-        return CalculateMesurement::expected(step_setting.mode, s, step_setting.step,
-                                             step_setting.manualText, step_setting.formula, step_setting.formulaCount);
-    };
+    const ExpectedTable::Ptr expected = ExpectedTable::forSettings(step_setting, N); // таблица шагов плана
+    auto expectedFor = [&](int s)->double { return expected->at(s); };
 
     // --- добавляем текущий шаг (остаток повторов = repeatsTotal - measOnLast, но не меньше 1 цикла)
     {
@@ -121,6 +121,14 @@ void AutoMeasurement::start(const AutoSavePlan& plan)
     m_cooldownLeft   = 0;
     m_saveRequested  = false;
 
+    // --- детектор скачков: порог из желаемого ARL0 (частоты ложных срабатываний)
+    ChangeDetector::Config dc;
+    dc.drift     = m_plan.cfg.changeDrift;
+    dc.threshold = ChangeDetector::thresholdForArl(m_plan.cfg.changeArl, dc.drift);
+    m_change.setConfig(dc);
+    m_change.reset();
+    m_changesAtSave = 0;
+
     // --- подключаемся к DataBuffer только здесь
     if (m_bufConn) {
         QObject::disconnect(m_bufConn);
@@ -150,12 +158,39 @@ void AutoMeasurement::stop()
     m_saveRequested = false;
     m_local.clear();
     m_lastSavedDistance = std::numeric_limits<double>::quiet_NaN();
-    m_prevGroups = m_prevSteps = m_prevMeas = 0;
+    m_prevSeries = -1;
+    m_prevMeas   = 0;
     m_stableTicksAcc = 0;
     m_cooldownLeft = 0;
+    m_change.reset();
+    m_changesAtSave = 0;
     m_plan = AutoSavePlan{};
 }
 
+// ===== setSource (переподключение к другому буферу, в т.ч. на ходу) =====
+void AutoMeasurement::setSource(DataBuffer* buffer)
+{
+    Q_ASSERT(buffer && "AutoMeasurement: buffer must not be null");
+    if (buffer == m_buffer) return;
+
+    const bool connected = bool(m_bufConn);
+    if (connected) QObject::disconnect(m_bufConn);                   // отписываемся от старого
+    m_buffer = buffer;
+    if (connected) {
+        m_bufConn = connect(m_buffer, &DataBuffer::updated,
+                            this,     &AutoMeasurement::onBufferUpdated,
+                            Qt::UniqueConnection);                   // и подписываемся на новый
+    }
+}
+
+// ===== currentDwell (выдержка записи для текущей зоны) =====
+double AutoMeasurement::currentDwell() const
+{
+    if (m_state == State::Idle || m_zoneIndex < 0 || m_zoneIndex >= m_plan.zones.size())
+        return 0.0;
+    return m_plan.zones[m_zoneIndex].dwellSec;
+}
+
 // ===== onBufferUpdated (сохраняем новые значения в локальный циклический буфер) =====
 void AutoMeasurement::onBufferUpdated(const QVector<double>& values)
 {
@@ -164,6 +199,7 @@ void AutoMeasurement::onBufferUpdated(const QVector<double>& values)
     const double x = values.back();                                  // берём последний сэмпл
     m_local.push_back(x);                                            // кладём в локальный буфер
     if (m_local.size() > AUTOMEAS_BUFFER_SIZE) m_local.remove(0);    // делаем буфер цикличным
+    m_change.update(x);                                              // детектор видит каждый сэмпл
 
     // --- параллельность "по факту": OnState сам себя перепланирует через QTimer
 }
@@ -221,11 +257,11 @@ void AutoMeasurement::OnState(State s)
     case State::Save: {
         if (!m_saveRequested) {
             // --- запомним "до" для верификации и отправим запрос на сейв
-            const auto& groups = m_storage->groups();
-            m_prevGroups = groups.size();
-            m_prevSteps  = (m_prevGroups > 0 ? groups.last().steps.size() : 0);
-            m_prevMeas   = (m_prevGroups > 0 && m_prevSteps > 0 ? groups.last().steps.last().measurements.size(): 0);
+            const DataMeasurement::Position last = m_storage->lastPosition();
+            m_prevSeries = last.series;
+            m_prevMeas   = last.rows;
             m_lastSavedDistance = distance;                          // точка сейва (для выхода в None)
+            m_changesAtSave = m_change.changeCount();                // скачки после этой точки = движение
             m_saveRequested = true;
             emit requestSaving();                                    // MainWindow начнёт сохранение
         }
@@ -271,6 +307,13 @@ bool AutoMeasurement::isZoneCorrect(double distance, double expected) const
 
 bool AutoMeasurement::isSpeedCorrect()
 {
+    if (m_plan.cfg.useChangeDetector) {
+        // ось стоит, если CUSUM не видел скачка последние settleSamples отсчётов
+        const bool settled = m_change.isSettled(m_plan.cfg.settleSamples);
+        accumulateStability(settled);
+        return settled;
+    }
+
     const double spd = robustSpeed();                                // робастная "скорость"
     const bool slow  = (spd <= m_plan.cfg.speedLimit);
     accumulateStability(slow);                                       // копим стабильность
@@ -291,7 +334,9 @@ bool AutoMeasurement::isOutZoneCorrect(double distance, double expected) const
         const bool fast = (spd >= m_plan.cfg.speedLimit * m_plan.cfg.exitSpeedMul);
         const bool moved = (!std::isnan(m_lastSavedDistance) &&
                             std::fabs(distance - m_lastSavedDistance) >= m_plan.cfg.exitDistance);
-        return fast || moved;
+        const bool jumped = (m_plan.cfg.useChangeDetector &&
+                             m_change.changeCount() > m_changesAtSave); // CUSUM увидел начало движения
+        return fast || moved || jumped;
     }
 }
 
@@ -340,17 +385,10 @@ void AutoMeasurement::scheduleNext(State s, int ms)
 
 bool AutoMeasurement::wasNewSaveCommitted() const
 {
-    const auto& groupsRef = m_storage->groups();
-    const int groups = groupsRef.size();
-    const int steps  = (groups > 0 ? groupsRef.last().steps.size() : 0);
-    const int meas   = (groups > 0 && steps > 0
-                        ? groupsRef.last().steps.last().measurements.size()
-                        : 0);
-
-    // --- сравниваем со "снимком" до сейва
-    if (groups > m_prevGroups) return true;
-    if (groups == m_prevGroups && steps > m_prevSteps) return true;
-    if (groups == m_prevGroups && steps == m_prevSteps && meas > m_prevMeas) return true;
+    // --- последняя позиция: новая серия или новое измерение в последней
+    const DataMeasurement::Position last = m_storage->lastPosition();
+    if (last.series > m_prevSeries) return true;
+    if (last.series == m_prevSeries && last.rows > m_prevMeas) return true;
     return false;
 }
 
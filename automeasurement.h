@@ -5,6 +5,7 @@
 #include <QObject>
 #include <QVector>
 #include <limits>
+#include "changedetector.h"
 
 // ----- параметры буфера и тиков
 #define AUTOMEAS_BUFFER_SIZE 100         // храним последние N значений
@@ -21,6 +22,7 @@ struct SaveZone {
     int    stepNumber = 1;                                       // номер шага
     double expected   = std::numeric_limits<double>::quiet_NaN();// целевое значение (NaN для None)
     int    repeatsTotal = 1;                                     // сколько раз сохранить в шаге
+    double dwellSec     = 0.0;                                   // выдержка на запись (0 — время сейва из настроек)
 };
 
 // ----- конфиг рантайма плана (самодостаточные пороги)
@@ -35,6 +37,10 @@ struct AutoPlanConfig {
     int    cooldownTicks     = 8;                                // антидребезг после сейва
     double exitSpeedMul      = 2.0;                              // множитель порога для выхода (None)
     double exitDistance      = 0.005;                            // мин. сдвиг для выхода (None)
+    bool   useChangeDetector = true;                             // вход/выход по CUSUM вместо "тихих тиков"
+    double changeDrift       = 0.5;                              // k детектора (в σ шума)
+    double changeArl         = 1000.0;                           // средний интервал ложных срабатываний, отсчётов
+    int    settleSamples     = 16;                               // отсчётов без скачка = ось стоит
 };
 
 // ----- сам план (самодостаточный контракт)
@@ -66,6 +72,12 @@ public:
     // 4) Публичный метод-град
     bool isRunning() const { return m_state != State::Idle; }
 
+    // 5) сменить источник онлайн-данных (например, сглаженный поток)
+    void setSource(DataBuffer* buffer);
+
+    // 6) выдержка текущей зоны плана (0 — не задана)
+    double currentDwell() const;
+
 signals:
     void requestSaving();                                        // просим MainWindow начать сохранение
     void planFinished();                                         // план окончен — сообщаем оркестратору
@@ -119,13 +131,16 @@ private:
     double            m_lastSavedDistance = std::numeric_limits<double>::quiet_NaN(); // для None
 
     // метрики для проверки коммита в DataMeasurement
-    int               m_prevGroups = 0;                           // счётчики "до сейва"
-    int               m_prevSteps  = 0;
+    int               m_prevSeries = -1;                          // курсор индекса "до сейва"
     int               m_prevMeas   = 0;
 
     // стабильность
     int               m_stableTicksAcc = 0;                       // копим "тихие тики"
     int               m_cooldownLeft   = 0;                       // антидребезг после сейва
+
+    // детектор скачков (CUSUM) по онлайн-потоку
+    ChangeDetector    m_change;                                   // вход/выход из зоны
+    int               m_changesAtSave  = 0;                       // число скачков на момент сейва
 };
 
 #endif // AUTOMEASUREMENT_H
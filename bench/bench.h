@@ -0,0 +1,27 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <QtGlobal>
+#include <functional>
+#include <string>
+
+// ----- общие утилиты замеров (bench/main.cpp)
+double bestOfMs(int runs, const std::function<void()>& body);   // лучшее время из runs прогонов, мс
+qint64 allocationCount();                                        // вызовов malloc/calloc/realloc с запуска (-1 — не считаем)
+qint64 peakRssBytes();                                           // пиковый резидентный объём процесса
+
+// точка масштабирования: числа для строки «pool N threads:» и совпадение с последовательным расчётом
+struct ScalePoint {
+    std::string numbers;
+    bool same = true;
+};
+// run на глобальном пуле с 1, 2, 4 … idealThreadCount потоками; MISMATCH — если результат разошёлся
+void scaleThreads(const std::function<ScalePoint()>& run);
+
+// ----- замеры, по файлу на стадию
+void benchDecimator();                                           // bench_decimator.cpp
+void benchRecalc();                                              // bench_recalc.cpp
+void benchAccuracy();                                            // bench_accuracy.cpp
+void benchArena();                                               // bench_arena.cpp
+
+#endif // BENCH_H
@@ -0,0 +1,48 @@
+# Консольные замеры производительности стадий Calibrix (без GUI).
+# Сборка: qmake bench/bench.pro && make; запуск: ./calibrix-bench [имя ...]
+
+QT       = core gui concurrent
+CONFIG  += console c++17
+CONFIG  -= app_bundle
+TARGET   = calibrix-bench
+
+INCLUDEPATH += .. ../accuracy
+win32: LIBS += -lpsapi
+
+SOURCES += \
+    main.cpp \
+    bench_decimator.cpp \
+    bench_recalc.cpp \
+    bench_accuracy.cpp \
+    bench_arena.cpp \
+    ../decimator.cpp \
+    ../recalcengine.cpp \
+    ../calculatemesurement.cpp \
+    ../expectedtable.cpp \
+    ../formulaexpression.cpp \
+    ../measurementcolumns.cpp \
+    ../stepstatistics.cpp \
+    ../measurementsnapshot.cpp \
+    ../datameasurement.cpp \
+    ../rawrecordstore.cpp \
+    ../bytearena.cpp \
+    ../driftmodel.cpp \
+    ../accuracy/accuracycalculator.cpp \
+    ../accuracy/accuracyengine.cpp
+
+HEADERS += \
+    bench.h \
+    ../decimator.h \
+    ../recalcengine.h \
+    ../calculatemesurement.h \
+    ../expectedtable.h \
+    ../formulaexpression.h \
+    ../measurementcolumns.h \
+    ../stepstatistics.h \
+    ../measurementsnapshot.h \
+    ../datameasurement.h \
+    ../rawrecordstore.h \
+    ../bytearena.h \
+    ../driftmodel.h \
+    ../accuracy/accuracycalculator.h \
+    ../accuracy/accuracyengine.h
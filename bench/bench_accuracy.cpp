@@ -0,0 +1,79 @@
+#include "bench.h"
+#include "accuracyengine.h"
+#include <cstdio>
+#include <cstring>
+
+// все числовые показатели строки — для побитовой сверки с последовательным расчётом
+static bool sameResult(const AccuracyResult& a, const AccuracyResult& b)
+{
+    static double AccuracyResult::* const kFields[] = {
+        &AccuracyResult::meanForward, &AccuracyResult::meanBackward,
+        &AccuracyResult::meanBidirectional, &AccuracyResult::reversalError,
+        &AccuracyResult::stddevForward, &AccuracyResult::stddevBackward,
+        &AccuracyResult::repeatabilityForward, &AccuracyResult::repeatabilityBackward,
+        &AccuracyResult::repeatabilityBidirectional, &AccuracyResult::systematicError,
+        &AccuracyResult::meanRange, &AccuracyResult::positioningAccuracy,
+        &AccuracyResult::systematicForward, &AccuracyResult::systematicBackward,
+        &AccuracyResult::systematicBidirectional, &AccuracyResult::meanReversal,
+        &AccuracyResult::accuracyForward, &AccuracyResult::accuracyBackward,
+        &AccuracyResult::expectedPosition
+    };
+    if (a.stepNumber != b.stepNumber || a.countForward != b.countForward || a.countBackward != b.countBackward)
+        return false;
+    for (double AccuracyResult::* f : kFields)
+        if (std::memcmp(&(a.*f), &(b.*f), sizeof(double)) != 0)
+            return false;
+    return true;
+}
+
+// Масштабирование AccuracyEngine на 200 двунаправленных группах × 10³ шагов
+// (по 3 подхода с каждой стороны, 2·10⁵ задач-шагов): AccuracyCalculator::compute
+// против пула с 1, 2, 4 … idealThreadCount потоками. Результат сверяется побитово.
+void benchAccuracy()
+{
+    const int kGroups  = 200;
+    const int kSteps   = 1000;
+    const int kRepeats = 3;
+
+    MeasurementColumns cols;
+    cols.reserve(kGroups * kSteps * 2 * kRepeats, kGroups * kSteps * 2, kGroups);
+    for (int g = 0; g < kGroups; ++g) {
+        cols.appendGroup(g + 1, StepMode::Uniform, MeasurementGroupType::Bidirectional, true);
+        for (int pass = 0; pass < 2; ++pass) {                   // вперёд 1…N, назад N…1
+            for (int k = 1; k <= kSteps; ++k) {
+                const int s = pass == 0 ? k : kSteps + 1 - k;
+                cols.appendSeries(s, pass == 0 ? ApproachDirection::Forward : ApproachDirection::Backward);
+                for (int r = 1; r <= kRepeats; ++r) {
+                    Measurement m{};
+                    m.repeatIndex = r;
+                    m.expected = s;
+                    m.deviation = 1e-3 * (((g * 7919 + s * 104729 + r * 31 + pass * 17) % 2001) - 1000) / 1000.0
+                                  + (pass ? 2e-4 : 0.0);
+                    m.distance = m.expected + m.deviation;
+                    m.raw = m.distance;
+                    m.rawIndex = -1;
+                    cols.appendRow(m);
+                }
+            }
+        }
+    }
+    const MeasurementSnapshot snapshot = MeasurementSnapshot::fromColumns(cols);
+
+    AccuracyResultList serial;
+    const double serialMs = bestOfMs(3, [&] { serial = AccuracyCalculator::compute(snapshot); });
+    std::printf("groups %d, steps %d, rows %d\n", kGroups, kGroups * kSteps, cols.rowCount());
+    std::printf("serial         : %8.1f ms\n", serialMs);
+
+    scaleThreads([&] {
+        AccuracyResultList parallel;
+        const double ms = bestOfMs(3, [&] { parallel = AccuracyEngine::compute(snapshot); });
+
+        bool same = parallel.size() == serial.size();
+        for (int i = 0; same && i < serial.size(); ++i)
+            same = sameResult(parallel[i], serial[i]);
+
+        char numbers[64];
+        std::snprintf(numbers, sizeof(numbers), "%8.1f ms (x%.2f)", ms, serialMs / ms);
+        return ScalePoint{ numbers, same };
+    });
+}
@@ -0,0 +1,81 @@
+#include "bench.h"
+#include "datameasurement.h"
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <cmath>
+#include <cstdio>
+
+// Сессия из 10⁶ сохранений через DataMeasurement::add с сырым окном по 64 отсчёта
+// (ISO 230-2: 100 шагов, 5 повторов, туда-обратно): выделений памяти на одну точку
+// и пиковый RSS процесса. Отдельно — то же для одного RawRecordStore::append.
+// Выделения считаются на уровне malloc (bench/main.cpp), вместе с QArrayData контейнеров Qt.
+// Пиковый RSS общий на процесс — запускайте этот замер отдельно: calibrix-bench arena
+namespace {
+
+// выделений на точку или n/a, если счётчик на этой платформе недоступен
+QByteArray perPoint(qint64 allocs, int points)
+{
+    return allocs < 0 ? QByteArray("n/a") : QByteArray::number(double(allocs) / points, 'f', 2);
+}
+
+} // namespace
+
+void benchArena()
+{
+    const int kPoints = 1000000;
+    const int kWindow = 64;
+
+    StepSettings st;
+    st.mode = StepMode::Uniform;
+    st.step = 10.0;
+    st.count = 100;
+    st.repeatCount = 5;
+    st.bidirectional = true;
+
+    // окно — медленный дрейф с шумом последнего знака, как после фильтра
+    QVector<double> window(kWindow);
+    auto fill = [&window](int point, double value) {
+        quint32 h = quint32(point) * 2654435761u;
+        for (int i = 0; i < window.size(); ++i) {
+            h ^= h << 13; h ^= h >> 17; h ^= h << 5;
+            window[i] = value + 1e-6 * i + 1e-7 * double(h % 1000);
+        }
+    };
+
+    const qint64 rssBefore = peakRssBytes();
+    DataMeasurement dm;
+    dm.setStepSettings(st);
+
+    const qint64 allocsBefore = allocationCount();
+    QElapsedTimer t;
+    t.start();
+    for (int p = 0; p < kPoints; ++p) {
+        const double value = 10.0 * (p % st.count) + 1e-4 * std::sin(p * 0.01);
+        fill(p, value);
+        dm.add(value, window, 1700000000000LL + p * 100LL);
+    }
+    const double ms = t.nsecsElapsed() / 1e6;
+    const qint64 allocs = allocsBefore < 0 ? -1 : allocationCount() - allocsBefore;
+
+    const MeasurementColumns& cols = dm.columns();
+    std::printf("DataMeasurement::add   : %d points, %d groups, %.2f us/point, %s allocations/point\n",
+                cols.rowCount(), cols.groupCount(), ms * 1e3 / kPoints, perPoint(allocs, kPoints).constData());
+    std::printf("raw windows            : %.1f MiB raw, %.1f MiB compressed, %.1f MiB arena\n",
+                dm.rawRecords().rawBytes() / 1048576.0, dm.rawRecords().compressedBytes() / 1048576.0,
+                dm.rawRecords().arenaBytes() / 1048576.0);
+    std::printf("peak RSS               : %.1f MiB (%.1f MiB before the session)\n",
+                peakRssBytes() / 1048576.0, rssBefore / 1048576.0);
+
+    {                                                            // только окна, без колонок и индекса
+        RawRecordStore store;
+        qint64 allocs = allocationCount();
+        for (int p = 0; p < kPoints; ++p) {
+            fill(p, 10.0 * (p % st.count) + 1e-4 * std::sin(p * 0.01));
+            store.append(window);
+        }
+        allocs = allocs < 0 ? -1 : allocationCount() - allocs;
+        std::printf("RawRecordStore::append : %s allocations/point, raw %.1f MiB, compressed %.1f MiB, arena %.1f MiB\n",
+                    perPoint(allocs, kPoints).constData(), store.rawBytes() / 1048576.0,
+                    store.compressedBytes() / 1048576.0, store.arenaBytes() / 1048576.0);
+    }
+}
@@ -0,0 +1,34 @@
+#include "bench.h"
+#include "decimator.h"
+#include <cmath>
+#include <cstdio>
+
+// Пропускная способность Decimator::process на блоках по 4096 отсчётов
+// (как приходят пачки от источника), МО/с — миллионов входных отсчётов в секунду.
+void benchDecimator()
+{
+    const int kSamples = 1 << 24;
+    const int kBlock   = 4096;
+
+    QVector<double> input(kSamples);
+    for (int i = 0; i < kSamples; ++i)
+        input[i] = std::sin(i * 1e-3) + 1e-3 * ((i * 2654435761u) % 1000);
+
+    struct Config { int ratio; int taps; };
+    const Config configs[] = { { 1, 8 }, { 2, 8 }, { 5, 8 }, { 10, 8 }, { 10, 16 } };
+
+    for (const Config& c : configs) {
+        Decimator dec(c.ratio, c.taps);
+        qint64 produced = 0;
+        const double ms = bestOfMs(3, [&] {
+            dec.reset();
+            produced = 0;
+            for (int b = 0; b < kSamples; b += kBlock) {
+                const QVector<double> block(input.begin() + b, input.begin() + b + kBlock);
+                produced += dec.process(block).size();
+            }
+        });
+        std::printf("ratio %2d, taps/phase %2d: %8.1f MS/s  (%lld out)\n",
+                    c.ratio, c.taps, kSamples / (ms * 1e3), (long long)produced);
+    }
+}
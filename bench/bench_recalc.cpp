@@ -0,0 +1,77 @@
+#include "bench.h"
+#include "recalcengine.h"
+#include "calculatemesurement.h"
+#include <cstdio>
+#include <cstring>
+
+static bool sameStats(const RunningStats& a, const RunningStats& b)
+{
+    return a.n == b.n && std::memcmp(&a.mean, &b.mean, sizeof(double)) == 0
+           && std::memcmp(&a.m2, &b.m2, sizeof(double)) == 0;
+}
+
+// Масштабирование RecalcEngine на сессии 10³ групп × 10³ шагов (по 2 повтора, 2·10⁶ строк):
+// последовательный путь (CalculateMesurement::recalcColumns, StepStatistics::rebuild)
+// против пула с 1, 2, 4 … idealThreadCount потоками. Результат пула сверяется побитово.
+void benchRecalc()
+{
+    const int kGroups  = 1000;
+    const int kSteps   = 1000;
+    const int kRepeats = 2;
+    const double kBase = 0.5;
+
+    MeasurementColumns cols;
+    cols.reserve(kGroups * kSteps * kRepeats, kGroups * kSteps, kGroups);
+    for (int g = 0; g < kGroups; ++g) {
+        cols.appendGroup(g + 1, StepMode::Uniform, MeasurementGroupType::Unidirectional, true);
+        for (int s = 1; s <= kSteps; ++s) {
+            cols.appendSeries(s, (g % 2) ? ApproachDirection::Backward : ApproachDirection::Forward);
+            for (int r = 1; r <= kRepeats; ++r) {
+                Measurement m{};
+                m.repeatIndex = r;
+                m.raw = kBase + s + 1e-3 * (((g * 7919 + s * 104729 + r) % 2001) - 1000) / 1000.0;
+                m.rawIndex = -1;
+                cols.appendRow(m);
+            }
+        }
+    }
+
+    StepSettings st;
+    st.mode = StepMode::Uniform;
+    st.step = 1.0;
+    st.count = kSteps;
+    const ExpectedTable table(st, kSteps);
+
+    // ----- эталон: последовательный путь
+    MeasurementColumns serialCols = cols;
+    StepStatistics serialStats;
+    const double serialCol = bestOfMs(3, [&] { CalculateMesurement::recalcColumns(serialCols, kBase, table); });
+    const double serialSt  = bestOfMs(3, [&] { serialStats.rebuild(serialCols); });
+    std::printf("rows %d, series %d, groups %d\n", cols.rowCount(), cols.seriesCount(), cols.groupCount());
+    std::printf("serial         : recalcColumns %8.1f ms, rebuildStatistics %8.1f ms\n", serialCol, serialSt);
+
+    scaleThreads([&] {
+        MeasurementColumns c = cols;
+        StepStatistics stats;
+        const double colMs = bestOfMs(3, [&] { RecalcEngine::recalcColumns(c, kBase, table); });
+        const double stMs  = bestOfMs(3, [&] { RecalcEngine::rebuildStatistics(stats, c); });
+
+        bool same = std::memcmp(c.deviation.constData(), serialCols.deviation.constData(),
+                                sizeof(double) * size_t(c.rowCount())) == 0
+                    && stats.groupCount() == serialStats.groupCount();
+        for (int g = 0; same && g < stats.groupCount(); ++g) {
+            const StepStatistics::GroupStats& a = stats.group(g);
+            const StepStatistics::GroupStats& b = serialStats.group(g);
+            same = a.size() == b.size();
+            for (auto ia = a.cbegin(), ib = b.cbegin(); same && ia != a.cend(); ++ia, ++ib)
+                same = ia.key() == ib.key()
+                       && sameStats(ia.value().forward, ib.value().forward)
+                       && sameStats(ia.value().backward, ib.value().backward);
+        }
+
+        char numbers[128];
+        std::snprintf(numbers, sizeof(numbers), "recalcColumns %8.1f ms (x%.2f), rebuildStatistics %8.1f ms (x%.2f)",
+                      colMs, serialCol / colMs, stMs, serialSt / stMs);
+        return ScalePoint{ numbers, same };
+    });
+}
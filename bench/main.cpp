@@ -0,0 +1,148 @@
+#include "bench.h"
+#include <QElapsedTimer>
+#include <QThread>
+#include <QThreadPool>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// ----- счётчик выделений на уровне malloc: контейнеры Qt (QArrayData) выделяют память
+// через malloc/realloc, а не operator new, поэтому считаем ниже — подменой malloc процесса.
+// glibc разрешает заменить malloc/calloc/realloc/free в исполняемом файле: вызовы из
+// libQt6Core и libstdc++ (operator new) приходят сюда и уходят в исходный распределитель.
+#if defined(__GLIBC__)
+static std::atomic<quint64> g_allocations{0};
+
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* p, std::size_t size);
+void  __libc_free(void* p);
+
+void* malloc(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+void* calloc(std::size_t count, std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+void* realloc(void* p, std::size_t size)                         // рост QVector/QByteArray — тоже выделение
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(p, size);
+}
+void free(void* p)
+{
+    __libc_free(p);
+}
+}
+
+qint64 allocationCount()
+{
+    return qint64(g_allocations.load(std::memory_order_relaxed));
+}
+#else
+qint64 allocationCount()
+{
+    return -1;                                                   // подмена malloc — только glibc
+}
+#endif
+
+qint64 peakRssBytes()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return qint64(pmc.PeakWorkingSetSize);
+    return -1;
+#else
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+#if defined(Q_OS_MACOS)
+    return qint64(ru.ru_maxrss);                                 // macOS — байты
+#else
+    return qint64(ru.ru_maxrss) * 1024;                          // Linux — КиБ
+#endif
+#endif
+}
+
+double bestOfMs(int runs, const std::function<void()>& body)
+{
+    double best = 0.0;
+    for (int r = 0; r < runs; ++r) {
+        QElapsedTimer t;
+        t.start();
+        body();
+        const double ms = t.nsecsElapsed() / 1e6;
+        if (r == 0 || ms < best) best = ms;
+    }
+    return best;
+}
+
+void scaleThreads(const std::function<ScalePoint()>& run)
+{
+    QThreadPool* pool = QThreadPool::globalInstance();
+    const int savedMax = pool->maxThreadCount();
+    const int ideal = QThread::idealThreadCount();
+
+    for (int threads = 1; ; threads *= 2) {
+        if (threads > ideal)
+            threads = ideal;
+        pool->setMaxThreadCount(threads);
+
+        const ScalePoint p = run();
+        std::printf("pool %2d threads: %s%s\n", threads, p.numbers.c_str(), p.same ? "" : "  MISMATCH");
+        if (threads == ideal)
+            break;
+    }
+    pool->setMaxThreadCount(savedMax);
+}
+
+// ----- реестр замеров: имя → функция
+struct BenchEntry {
+    const char* name;
+    void (*run)();
+};
+
+static const BenchEntry kBenches[] = {
+    { "decimator", benchDecimator },
+    { "recalc",    benchRecalc },
+    { "accuracy",  benchAccuracy },
+    { "arena",     benchArena },
+};
+
+// calibrix-bench [имя ...] — без имён запускает всё по порядку.
+// Пиковый RSS общий на процесс: замеры памяти запускайте по одному.
+int main(int argc, char* argv[])
+{
+    bool any = false;
+    for (const BenchEntry& b : kBenches) {
+        bool wanted = (argc < 2);
+        for (int i = 1; i < argc; ++i)
+            wanted = wanted || std::strcmp(argv[i], b.name) == 0;
+        if (!wanted)
+            continue;
+        std::printf("== %s\n", b.name);
+        b.run();
+        any = true;
+    }
+    if (!any) {
+        std::printf("usage: %s [", argv[0]);
+        for (const BenchEntry& b : kBenches)
+            std::printf(" %s", b.name);
+        std::printf(" ]\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+#ifndef BINARYIO_H
+#define BINARYIO_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <cstring>
+#include "settingsmanager.h"            // StepSettings, AutoSaveSettings
+#include "typemeasurement.h"            // ApproachDirection, MeasurementGroupType
+
+// общие помощники двоичных форматов (журнал сессии, файл .cbx):
+// поля пишутся в нативном порядке байт, как в RawRecordStore
+namespace BinaryIO {
+
+template <typename T>
+inline void put(QByteArray& out, T v)
+{
+    out.append(reinterpret_cast<const char*>(&v), int(sizeof(T)));
+}
+
+inline void putString(QByteArray& out, const QString& s)
+{
+    const QByteArray utf8 = s.toUtf8();
+    put<quint32>(out, quint32(utf8.size()));
+    out.append(utf8);
+}
+
+inline void putDoubles(QByteArray& out, const QVector<double>& v)
+{
+    put<quint32>(out, quint32(v.size()));
+    out.append(reinterpret_cast<const char*>(v.constData()), v.size() * int(sizeof(double)));
+}
+
+// перечисления на диске — числа; известные значения идут подряд с нуля до last.
+// Новый перечислитель добавляется в конец и переносит last сюда же
+template <typename E> struct EnumRange;
+template <> struct EnumRange<StepMode>             { static constexpr StepMode last = StepMode::Uniform; };
+template <> struct EnumRange<ApproachDirection>    { static constexpr ApproachDirection last = ApproachDirection::Backward; };
+template <> struct EnumRange<MeasurementGroupType> { static constexpr MeasurementGroupType last = MeasurementGroupType::Bidirectional; };
+template <> struct EnumRange<bool>                 { static constexpr bool last = true; };
+
+// значение с диска — одно из известных (иначе файл повреждён или записан более новой версией)
+template <typename E>
+inline bool isKnownEnum(qint64 v)
+{
+    return v >= 0 && v <= qint64(EnumRange<E>::last);
+}
+
+// чтение с проверкой границ: при выходе за конец ok = false, дальше читаются нули
+struct Reader
+{
+    const char* p;
+    const char* end;
+    bool ok = true;
+    bool badEnum = false;               // встретилось неизвестное значение перечисления
+
+    template <typename T>
+    T get()
+    {
+        T v{};
+        if (end - p < qptrdiff(sizeof(T))) { ok = false; return v; }
+        std::memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+        return v;
+    }
+
+    // перечисление в одном байте: неизвестное значение — ok = false
+    template <typename E>
+    E getEnum()
+    {
+        const quint8 v = get<quint8>();
+        if (!ok) return E{};
+        if (!isKnownEnum<E>(v)) { ok = false; badEnum = true; return E{}; }
+        return E(v);
+    }
+
+    QString getString()
+    {
+        const quint32 n = get<quint32>();
+        if (!ok || quint64(end - p) < n) { ok = false; return {}; }
+        const QString s = QString::fromUtf8(QByteArray(p, int(n)));
+        p += n;
+        return s;
+    }
+
+    QVector<double> getDoubles()
+    {
+        const quint32 n = get<quint32>();
+        if (!ok || quint64(end - p) < quint64(n) * sizeof(double)) { ok = false; return {}; }
+        QVector<double> v(static_cast<int>(n));
+        std::memcpy(v.data(), p, n * sizeof(double));
+        p += n * sizeof(double);
+        return v;
+    }
+};
+
+inline void putStepSettings(QByteArray& out, const StepSettings& s)
+{
+    put<quint8>(out, quint8(s.mode));
+    put<double>(out, s.base);
+    put<double>(out, s.step);
+    put<qint32>(out, s.count);
+    putString(out, s.manualText);
+    putString(out, s.formula);
+    put<qint32>(out, s.formulaCount);
+    put<qint32>(out, s.repeatCount);
+    put<quint8>(out, s.bidirectional ? 1 : 0);
+}
+
+inline StepSettings getStepSettings(Reader& r)
+{
+    StepSettings s;
+    s.mode          = r.getEnum<StepMode>();
+    s.base          = r.get<double>();
+    s.step          = r.get<double>();
+    s.count         = r.get<qint32>();
+    s.manualText    = r.getString();
+    s.formula       = r.getString();
+    s.formulaCount  = r.get<qint32>();
+    s.repeatCount   = r.get<qint32>();
+    s.bidirectional = r.get<quint8>() != 0;
+    return s;
+}
+
+inline void putAutoSaveSettings(QByteArray& out, const AutoSaveSettings& s)
+{
+    put<quint8>(out, s.autoGroup ? 1 : 0);
+    put<double>(out, s.positiveTolerance);
+    put<double>(out, s.negativeTolerance);
+    put<double>(out, s.speedLimit);
+}
+
+inline AutoSaveSettings getAutoSaveSettings(Reader& r)
+{
+    AutoSaveSettings s;
+    s.autoGroup         = r.get<quint8>() != 0;
+    s.positiveTolerance = r.get<double>();
+    s.negativeTolerance = r.get<double>();
+    s.speedLimit        = r.get<double>();
+    return s;
+}
+
+} // namespace BinaryIO
+
+#endif // BINARYIO_H
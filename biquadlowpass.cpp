@@ -0,0 +1,177 @@
+#include "biquadlowpass.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+BiquadLowpass::BiquadLowpass(double cutoffHz, double sampleRateHz, int order, QObject* parent)
+    : QObject(parent)
+    , m_cutoff(cutoffHz)
+    , m_fixedRate(sampleRateHz)
+    , m_rate(sampleRateHz)
+    , m_order(std::max(2, order + (order % 2)))        // только чётный порядок: целые секции
+{
+    m_clock.start();
+    design();
+}
+
+void BiquadLowpass::setCutoff(double cutoffHz)
+{
+    m_cutoff = cutoffHz;
+    design();
+}
+
+void BiquadLowpass::setSampleRate(double sampleRateHz)
+{
+    m_fixedRate = sampleRateHz;
+    m_rate = sampleRateHz;
+    m_dtCount = 0;
+    m_lastNs = -1;
+    design();
+}
+
+void BiquadLowpass::usePrecision(bool useDouble)
+{
+    if (m_double == useDouble)
+        return;
+    // состояние переносим в другой путь — при смене частоты на лету выход не скачет
+    for (int i = 0; i < m_state.size(); ++i) {
+        if (useDouble) m_state[i] = double(m_stateF[i]);
+        else m_stateF[i] = float(m_state[i]);
+    }
+    m_double = useDouble;
+}
+
+void BiquadLowpass::reset()
+{
+    std::fill(m_state.begin(), m_state.end(), 0.0);
+    std::fill(m_stateF.begin(), m_stateF.end(), 0.0f);
+    m_primed = false;
+    m_lastNs = -1;
+}
+
+void BiquadLowpass::design()
+{
+    const int n = m_order / 2;
+    m_coeffs.resize(n);
+    m_coeffsF.resize(n);
+    m_state.resize(2 * n);
+    m_stateF.resize(2 * n);
+
+    if (m_rate <= 0.0 || m_cutoff <= 0.0) {
+        // частота ещё неизвестна — секции работают как провод
+        for (int k = 0; k < n; ++k) {
+            m_coeffs[k] = { 1.0, 0.0, 0.0, 0.0, 0.0 };
+            m_coeffsF[k] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+        }
+        usePrecision(false);
+        return;
+    }
+
+    // билинейное преобразование с предыскажением, срез не выше 0.45·fs
+    const double fc = std::min(m_cutoff, 0.45 * m_rate);
+    const double K = std::tan(M_PI * fc / m_rate);
+    const double K2 = K * K;
+    usePrecision(fc / m_rate < kFloatMinRatio);
+
+    for (int k = 0; k < n; ++k) {
+        // добротность k-й пары полюсов Баттерворта порядка m_order
+        const double Q = 1.0 / (2.0 * std::cos((2.0 * k + 1.0) * M_PI / (2.0 * m_order)));
+        const double norm = 1.0 / (1.0 + K / Q + K2);
+
+        Coeffs c;
+        c.b0 = K2 * norm;
+        c.b1 = 2.0 * c.b0;
+        c.b2 = c.b0;
+        c.a1 = 2.0 * (K2 - 1.0) * norm;
+        c.a2 = (1.0 - K / Q + K2) * norm;
+
+        m_coeffs[k] = c;
+        m_coeffsF[k] = { float(c.b0), float(c.b1), float(c.b2), float(c.a1), float(c.a2) };
+    }
+}
+
+void BiquadLowpass::trackRate(int samples)
+{
+    if (m_fixedRate > 0.0 || samples <= 0)
+        return;
+
+    const qint64 now = m_clock.nsecsElapsed();
+    if (m_lastNs >= 0) {
+        const double dt = (now - m_lastNs) * 1e-9 / samples;
+        if (m_dtCount == 0) m_dtEstimate = dt;
+        else m_dtEstimate += 0.05 * (dt - m_dtEstimate);   // сглаживаем джиттер прихода
+        ++m_dtCount;
+    }
+    m_lastNs = now;
+
+    // после разгона перестраиваем коэффициенты, если частота ушла больше чем на 10%
+    if (m_dtCount >= 16 && m_dtEstimate > 0.0) {
+        const double est = 1.0 / m_dtEstimate;
+        if (m_rate <= 0.0 || std::fabs(est - m_rate) > 0.1 * m_rate) {
+            m_rate = est;
+            design();
+        }
+    }
+}
+
+double BiquadLowpass::step(double x)
+{
+    const int n = m_coeffs.size();
+
+    if (!m_primed) {
+        // работаем относительно первого отсчёта: нулевое состояние = установившийся
+        // режим (нет переходного от нуля), а float не теряет разрядность на больших
+        // абсолютных значениях дистанции
+        m_offset = x;
+        std::fill(m_state.begin(), m_state.end(), 0.0);
+        std::fill(m_stateF.begin(), m_stateF.end(), 0.0f);
+        m_primed = true;
+    }
+    x -= m_offset;
+
+    if (m_double) {
+        double v = x;
+        double* z = m_state.data();
+        for (int k = 0; k < n; ++k, z += 2) {
+            const Coeffs& c = m_coeffs[k];
+            const double y = c.b0 * v + z[0];
+            z[0] = c.b1 * v - c.a1 * y + z[1];
+            z[1] = c.b2 * v - c.a2 * y;
+            v = y;
+        }
+        return m_offset + v;
+    }
+
+    float v = float(x);
+    float* z = m_stateF.data();
+    for (int k = 0; k < n; ++k, z += 2) {
+        const CoeffsF& c = m_coeffsF[k];
+        const float y = c.b0 * v + z[0];
+        z[0] = c.b1 * v - c.a1 * y + z[1];
+        z[1] = c.b2 * v - c.a2 * y;
+        v = y;
+    }
+    return m_offset + double(v);
+}
+
+QVector<double> BiquadLowpass::process(const QVector<double>& input)
+{
+    QVector<double> out(input.size());
+    for (int i = 0; i < input.size(); ++i)
+        out[i] = step(input[i]);
+    return out;
+}
+
+void BiquadLowpass::push(double value)
+{
+    trackRate(1);
+    emit sampleReady(step(value));
+}
+
+void BiquadLowpass::processBlock(const QVector<double>& values)
+{
+    if (values.isEmpty())
+        return;
+    trackRate(values.size());
+    emit blockReady(process(values));
+}
@@ -0,0 +1,71 @@
+#ifndef BIQUADLOWPASS_H
+#define BIQUADLOWPASS_H
+
+#include <QObject>
+#include <QVector>
+#include <QElapsedTimer>
+
+// Каскад биквадратных секций (ФНЧ Баттерворта чётного порядка) для сглаживания
+// онлайн-потока. O(1) на отсчёт, у каждой секции своё состояние (транспонированная
+// прямая форма II). Состояние и коэффициенты во float; при очень низком срезе
+// (fc/fs < kFloatMinRatio) полюса у единицы во float неточны — секции считаются в double.
+class BiquadLowpass : public QObject
+{
+    Q_OBJECT
+public:
+    // sampleRateHz = 0 — частота оценивается по времени прихода отсчётов
+    explicit BiquadLowpass(double cutoffHz = 1.0,
+                           double sampleRateHz = 0.0,
+                           int order = 4,
+                           QObject* parent = nullptr);
+
+    void setCutoff(double cutoffHz);                   // срез, Гц
+    void setSampleRate(double sampleRateHz);           // известная частота, Гц (0 — оценка)
+    void reset();                                      // сброс состояний секций
+
+    double cutoff() const { return m_cutoff; }
+    double sampleRate() const { return m_rate; }       // частота, под которую рассчитаны коэффициенты
+    int sections() const { return m_coeffs.size(); }
+
+    QVector<double> process(const QVector<double>& input); // блок без сигналов
+
+public slots:
+    void push(double value);
+    void processBlock(const QVector<double>& values);
+
+signals:
+    void sampleReady(double value);
+    void blockReady(const QVector<double>& values);
+
+private:
+    struct Coeffs { double b0, b1, b2, a1, a2; };
+    struct CoeffsF { float b0, b1, b2, a1, a2; };
+
+    double step(double x);                             // один отсчёт через все секции
+    void design();                                     // коэффициенты по m_cutoff и m_rate
+    void usePrecision(bool useDouble);                 // переключить путь, перенеся состояние секций
+    void trackRate(int samples);                       // оценка частоты по времени прихода
+
+    double m_cutoff = 1.0;
+    double m_fixedRate = 0.0;                          // заданная частота (0 — оценка)
+    double m_rate = 0.0;                               // частота текущих коэффициентов
+    int    m_order = 4;
+    bool   m_double = false;                           // выбирается в design() по fc/fs
+
+    static constexpr double kFloatMinRatio = 0.01;     // ниже — double-путь
+
+    QVector<Coeffs>  m_coeffs;                         // коэффициенты секций (double)
+    QVector<CoeffsF> m_coeffsF;                        // те же во float
+    QVector<double>  m_state;                          // z1, z2 каждой секции (double-путь)
+    QVector<float>   m_stateF;                         // z1, z2 каждой секции (float-путь)
+    bool m_primed = false;                             // опорный уровень выставлен по первому отсчёту
+    double m_offset = 0.0;                             // опорный уровень (первый отсчёт)
+
+    // оценка частоты дискретизации
+    QElapsedTimer m_clock;
+    qint64 m_lastNs = -1;
+    double m_dtEstimate = 0.0;                         // сглаженный интервал, с
+    int    m_dtCount = 0;
+};
+
+#endif // BIQUADLOWPASS_H
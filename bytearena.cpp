@@ -0,0 +1,31 @@
+#include "bytearena.h"                  // заголовок арены
+#include <cstring>                      // memcpy
+
+// скопировать блок в арену
+const char* ByteArena::store(const char* data, int size)
+{
+    if (size <= 0) return m_cursor;
+
+    if (size > m_free) {
+        // блок крупнее обычного куска получает собственный кусок, текущий остаётся открытым
+        if (size > m_chunkSize / 4) {
+            m_chunks.emplace_back(new char[size]);
+            m_reserved += size;
+            m_usedTotal += size;
+            char* p = m_chunks.back().get();
+            std::memcpy(p, data, size_t(size));
+            return p;
+        }
+        m_chunks.emplace_back(new char[m_chunkSize]);           // новый кусок, старые не трогаем
+        m_reserved += m_chunkSize;
+        m_cursor = m_chunks.back().get();
+        m_free = m_chunkSize;
+    }
+
+    char* p = m_cursor;
+    std::memcpy(p, data, size_t(size));
+    m_cursor += size;
+    m_free -= size;
+    m_usedTotal += size;
+    return p;
+}
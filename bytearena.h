@@ -0,0 +1,36 @@
+#ifndef BYTEARENA_H
+#define BYTEARENA_H
+
+#include <QtGlobal>                     // qint64
+#include <memory>                       // владение кусками
+#include <vector>                       // список кусков (move-only элементы)
+
+// монотонная арена байтов: данные дописываются в куски фиксированного размера,
+// записанное никогда не перемещается (рост — новый кусок, без копирования старых)
+// и не освобождается поштучно — вся арена уходит разом вместе с последним владельцем.
+// Дописывать может один поток; уже выданные байты можно читать из любых потоков.
+class ByteArena
+{
+public:
+    static constexpr int kDefaultChunk = 256 * 1024;        // байт в куске
+
+    explicit ByteArena(int chunkSize = kDefaultChunk) : m_chunkSize(chunkSize) {}
+    ByteArena(const ByteArena&) = delete;
+    ByteArena& operator=(const ByteArena&) = delete;
+
+    const char* store(const char* data, int size);          // скопировать в арену, вернуть постоянный адрес
+
+    int chunkCount() const { return int(m_chunks.size()); } // выделено кусков
+    qint64 reservedBytes() const { return m_reserved; }     // память под куски
+    qint64 usedBytes() const { return m_usedTotal; }        // занято данными
+
+private:
+    std::vector<std::unique_ptr<char[]>> m_chunks;          // куски (адреса постоянны)
+    int    m_chunkSize;                                     // размер обычного куска
+    int    m_free = 0;                                      // свободно в текущем куске
+    char*  m_cursor = nullptr;                              // куда писать в текущем куске
+    qint64 m_reserved = 0;
+    qint64 m_usedTotal = 0;
+};
+
+#endif // BYTEARENA_H
@@ -1,4 +1,6 @@
 #include "calculatemesurement.h"        // заголовок калькулятора
+#include "formulaexpression.h"          // компилятор формул шагов
+#include "expectedtable.h"              // ожидаемые по шагам одной таблицей
 #include <QStringList>                   // разбиение строки
 #include <QRegularExpression>            // разделители
 #include <cmath>                         // isnan/abs
@@ -24,12 +26,13 @@ double CalculateMesurement::expected(StepMode mode,
                                      double uniformStep,
                                      const QString& manualText,
                                      const QString& formula,
-                                     int n)
+                                     int n,
+                                     double base)
 {
     switch (mode) {                       // выбираем ветку по режиму
         case StepMode::Uniform: return expectedUniform(stepNumber, uniformStep); // равномерно
         case StepMode::Manual:  return expectedManual (stepNumber, manualText);  // вручную
-        case StepMode::Formula: return expectedFormula(stepNumber, formula, n);  // формула
+        case StepMode::Formula: return expectedFormula(stepNumber, formula, n, base, uniformStep); // формула
         case StepMode::None:
         default:                return std::numeric_limits<double>::quiet_NaN(); // нет ожидаемого
     }
@@ -49,24 +52,28 @@ double CalculateMesurement::expectedManual(int stepNumber, const QString& text)
     return list[stepNumber - 1];                              // берём нужный элемент
 }
 
-double CalculateMesurement::expectedFormula(int /*stepNumber*/, const QString& /*f*/, int /*n*/)
+double CalculateMesurement::expectedFormula(int stepNumber, const QString& f, int n,
+                                            double base, double step)
 {
-    return 0.0;                            // заглушка под формулы
+    if (stepNumber <= 0) return 0.0;                          // защита от нуля и ниже (как у остальных режимов)
+
+    thread_local FormulaExpression compiled;                  // последняя формула потока — без повторного разбора
+    if (compiled.text() != f)
+        compiled = FormulaExpression::compile(f);
+    if (!compiled.isValid()) return std::numeric_limits<double>::quiet_NaN(); // ошибка — ожидаемого нет
+
+    return compiled.evaluate({ double(stepNumber), double(n), base, step });
 }
 
 CalculateMesurement::Values
 CalculateMesurement::compute(double raw,
                              double base,
-                             StepMode mode,
-                             int    stepNumber,
-                             double uniformStep,
-                             const QString& manualText,
-                             const QString& formula,
-                             int    formulaCount)
+                             const ExpectedTable& table,
+                             int    stepNumber)
 {
     Values v;                              // собираем пакет значений
     v.distance  = distance(raw, base);     // смещение от базы
-    v.expected  = expected(mode, stepNumber, uniformStep, manualText, formula, formulaCount); // ожидаемое
+    v.expected  = table.at(stepNumber);    // ожидаемое — из таблицы
     v.deviation = deviation(v.distance, v.expected); // погрешность
     return v;                              // возвращаем пакет
 }
@@ -81,26 +88,25 @@ CalculateMesurement::determineSeriesDirection(const MeasurementSeries& prevSerie
     if (prevSeries.measurements.isEmpty() || currSeries.measurements.isEmpty())
         return ApproachDirection::Unknown; // если нет данных
 
-    if (bidirectional) {                   // логика для пинг-понга
-        const int prevN = prevSeries.stepNumber;              // прошлый номер шага
-        const int currN = currSeries.stepNumber;              // текущий номер шага
-
-        if (currN > prevN) return ApproachDirection::Forward; // рост номера = вперёд
-        if (currN < prevN) return ApproachDirection::Backward;// падение номера = назад
-
-        if (maxStepForBidi > 0) {                             // обработка дублей на границах
-            if (currN == maxStepForBidi) return ApproachDirection::Backward; // N->N = назад
-            if (currN == 1)             return ApproachDirection::Forward;   // 1->1 = вперёд
-        }
+    return directionByMeans(prevSeries.stepNumber, averageRaw(prevSeries),
+                            currSeries.stepNumber, averageRaw(currSeries),
+                            bidirectional, maxStepForBidi, eps); // общая логика
+}
 
-        const double p = averageRaw(prevSeries);              // среднее прошлого шага
-        const double c = averageRaw(currSeries);              // среднее текущего шага
-        return deltaToDirection(c - p, eps);                  // fallback по данным
-    }
+ApproachDirection
+CalculateMesurement::determineSeriesDirection(const MeasurementColumns& cols,
+                                              int prevSeries,
+                                              int currSeries,
+                                              bool bidirectional,
+                                              int maxStepForBidi,
+                                              double eps)
+{
+    if (cols.seriesRows(prevSeries) == 0 || cols.seriesRows(currSeries) == 0)
+        return ApproachDirection::Unknown; // если нет данных
 
-    const double prevAvg = averageRaw(prevSeries);            // среднее прошлого шага
-    const double currAvg = averageRaw(currSeries);            // среднее текущего шага
-    return deltaToDirection(currAvg - prevAvg, eps);          // знак дельты задаёт направление
+    return directionByMeans(cols.seriesStep[prevSeries], cols.seriesMeanRaw(prevSeries),
+                            cols.seriesStep[currSeries], cols.seriesMeanRaw(currSeries),
+                            bidirectional, maxStepForBidi, eps); // общая логика
 }
 
 // -------------------------------------------------------
@@ -108,33 +114,12 @@ CalculateMesurement::determineSeriesDirection(const MeasurementSeries& prevSerie
 // -------------------------------------------------------
 
 void CalculateMesurement::recalcAllGroups(QVector<MeasurementGroup>& groups,
-                                          StepMode mode,
                                           double base,
-                                          double uniformStep,
-                                          const QString& manualText,
-                                          const QString& formula,
-                                          int    n)
-{
-    QVector<double> manualList;            // кэш значений для Manual
-    if (mode == StepMode::Manual) manualList = parseManual(manualText); // парсим один раз
-
-    auto expectedFor = [&](int stepNumber)->double {          // быстрый выбор ожидаемого
-        switch (mode) {
-            case StepMode::Uniform: return expectedUniform(stepNumber, uniformStep); // равномерно
-            case StepMode::Manual:  {
-                if (stepNumber <= 0) return 0.0;                                // защита
-                if (stepNumber > manualList.size()) return 0.0;                 // границы
-                return manualList[stepNumber - 1];                               // значение
-            }
-            case StepMode::Formula: return expectedFormula(stepNumber, formula, n); // формула
-            case StepMode::None:
-            default:                return std::numeric_limits<double>::quiet_NaN(); // нет ожидаемого
-        }
-    };
-
+                                          const ExpectedTable& table)
+{
     for (auto& g : groups) {                       // идём по группам
         for (auto& s : g.steps) {                  // идём по шагам
-            const double exp = expectedFor(s.stepNumber);     // ожидаемое шага
+            const double exp = table.at(s.stepNumber);        // ожидаемое шага
             for (auto& m : s.measurements) {       // идём по измерениям
                 m.distance  = distance(m.raw, base);          // смещение от базы
                 m.expected  = exp;                            // ожидаемое по шагу
@@ -163,6 +148,57 @@ void CalculateMesurement::recalcDirectionsInGroups(QVector<MeasurementGroup>& gr
     }
 }
 
+void CalculateMesurement::recalcColumns(MeasurementColumns& cols,
+                                        double base,
+                                        const ExpectedTable& table)
+{
+    const int rows = cols.rowCount();      // число измерений
+    const double* raw = cols.raw.constData();
+    double* dist = cols.distance.data();
+    double* exp  = cols.expected.data();
+    double* dev  = cols.deviation.data();
+
+    // ожидаемое зависит только от шага — заполняем диапазоны серий
+    for (int s = 0; s < cols.seriesCount(); ++s) {
+        const double e = table.at(cols.seriesStep[s]);
+        std::fill(exp + cols.seriesBegin(s), exp + cols.seriesEnd(s), e);
+    }
+
+    // остальное — плоские проходы без ветвлений (векторизуются)
+    for (int i = 0; i < rows; ++i) dist[i] = raw[i] - base;      // смещение от базы
+    for (int i = 0; i < rows; ++i) dev[i]  = dist[i] - exp[i];   // погрешность
+}
+
+void CalculateMesurement::recalcDirectionsInColumns(MeasurementColumns& cols,
+                                                    int maxStepForBidi,
+                                                    double eps)
+{
+    // среднее каждой серии считаем один раз
+    const int nSeries = cols.seriesCount();
+    QVector<double> means(nSeries);
+    for (int s = 0; s < nSeries; ++s) means[s] = cols.seriesMeanRaw(s);
+
+    for (int g = 0; g < cols.groupCount(); ++g) {   // идём по группам
+        const int b = cols.groupBegin(g);
+        const int e = cols.groupEnd(g);
+        if (b == e) continue;                       // пропускаем пустые
+
+        cols.seriesDirection[b] = ApproachDirection::Unknown; // первый шаг = Unknown
+
+        const bool isBidi = (cols.groupType[g] == MeasurementGroupType::Bidirectional); // флаг bidi
+
+        for (int s = b + 1; s < e; ++s) {           // по остальным шагам
+            if (cols.seriesRows(s - 1) == 0 || cols.seriesRows(s) == 0) {
+                cols.seriesDirection[s] = ApproachDirection::Unknown; // нет данных
+                continue;
+            }
+            cols.seriesDirection[s] = directionByMeans(cols.seriesStep[s - 1], means[s - 1],
+                                                       cols.seriesStep[s], means[s],
+                                                       isBidi, maxStepForBidi, eps); // единый метод
+        }
+    }
+}
+
 // -------------------------------------------------------
 // БЛОК 3. ПАРСЕР
 // -------------------------------------------------------
@@ -213,3 +249,22 @@ CalculateMesurement::deltaToDirection(double delta, double eps)
     if (delta < -eps) return ApproachDirection::Backward;    // падение = назад
     return ApproachDirection::Unknown;                        // мелочь = неясно
 }
+
+ApproachDirection CalculateMesurement::directionByMeans(int prevStep, double prevAvg,
+                                                        int currStep, double currAvg,
+                                                        bool bidirectional,
+                                                        int maxStepForBidi,
+                                                        double eps)
+{
+    if (bidirectional) {                   // логика для пинг-понга
+        if (currStep > prevStep) return ApproachDirection::Forward; // рост номера = вперёд
+        if (currStep < prevStep) return ApproachDirection::Backward;// падение номера = назад
+
+        if (maxStepForBidi > 0) {                             // обработка дублей на границах
+            if (currStep == maxStepForBidi) return ApproachDirection::Backward; // N->N = назад
+            if (currStep == 1)             return ApproachDirection::Forward;   // 1->1 = вперёд
+        }
+    }
+
+    return deltaToDirection(currAvg - prevAvg, eps);          // знак дельты задаёт направление
+}
@@ -5,6 +5,9 @@
 #include <QString>                      // строки Qt
 #include <limits>                       // NaN/Inf
 #include "typemeasurement.h"            // общие типы и StepMode
+#include "measurementcolumns.h"         // колоночное хранилище
+
+class ExpectedTable;                    // готовые ожидаемые по шагам (expectedtable.h)
 
 // независимый калькулятор без доступа к настройкам и складу
 class CalculateMesurement
@@ -29,20 +32,18 @@ public:
                            double uniformStep,
                            const QString& manualText,
                            const QString& formula,
-                           int formulaCount);                           // считаем ожидаемое
+                           int formulaCount,
+                           double base = 0.0);                          // считаем ожидаемое
 
     static double expectedUniform(int stepNumber, double step);         // ожидаемое для Uniform
     static double expectedManual (int stepNumber, const QString& text); // ожидаемое для Manual
-    static double expectedFormula(int stepNumber, const QString& f, int n); // ожидаемое для Formula
+    static double expectedFormula(int stepNumber, const QString& f, int n,
+                                  double base, double step);            // ожидаемое для Formula
 
     static Values compute(double raw,
                           double base,
-                          StepMode mode,
-                          int    stepNumber,
-                          double uniformStep,
-                          const QString& manualText,
-                          const QString& formula,
-                          int    formulaCount);                         // считаем всё разом
+                          const ExpectedTable& table,
+                          int    stepNumber);                           // считаем всё разом
 
     static ApproachDirection determineSeriesDirection(const MeasurementSeries& prevSeries,
                                                       const MeasurementSeries& currSeries,
@@ -50,22 +51,33 @@ public:
                                                       int maxStepForBidi,
                                                       double eps = 1e-4); // единая логика направления
 
+    static ApproachDirection determineSeriesDirection(const MeasurementColumns& cols,
+                                                      int prevSeries,
+                                                      int currSeries,
+                                                      bool bidirectional,
+                                                      int maxStepForBidi,
+                                                      double eps = 1e-4); // то же по индексам серий
+
     // -------------------------------------------------------
     // БЛОК 2. ПУБЛИЧНЫЕ ПЕРЕСЧЁТЫ
     // -------------------------------------------------------
 
     static void recalcAllGroups(QVector<MeasurementGroup>& groups,
-                                StepMode mode,
                                 double base,
-                                double uniformStep,
-                                const QString& manualText,
-                                const QString& formula,
-                                int    formulaCount);                   // пересчёт чисел по всем
+                                const ExpectedTable& table);            // пересчёт чисел по всем
 
     static void recalcDirectionsInGroups(QVector<MeasurementGroup>& groups,
                                          int maxStepForBidi,
                                          double eps = 1e-4);            // пересчёт направлений по всем
 
+    static void recalcColumns(MeasurementColumns& cols,
+                              double base,
+                              const ExpectedTable& table);              // пересчёт чисел по колонкам
+
+    static void recalcDirectionsInColumns(MeasurementColumns& cols,
+                                          int maxStepForBidi,
+                                          double eps = 1e-4);           // пересчёт направлений по колонкам
+
     // -------------------------------------------------------
     // БЛОК 3. ПАРСЕР
     // -------------------------------------------------------
@@ -74,12 +86,19 @@ public:
     static int             manualCount(const QString& manualText);      // считаем элементы Manual
 
 private:
+    friend class RecalcEngine;                                          // параллельный путь с теми же помощниками
+
     // -------------------------------------------------------
     // БЛОК 4. ПРИВАТНЫЕ ПОМОЩНИКИ
     // -------------------------------------------------------
 
     static double averageRaw(const MeasurementSeries& s);               // среднее raw по шагу
     static ApproachDirection deltaToDirection(double delta, double eps);// дельта -> направление
+    static ApproachDirection directionByMeans(int prevStep, double prevAvg,
+                                              int currStep, double currAvg,
+                                              bool bidirectional,
+                                              int maxStepForBidi,
+                                              double eps);              // логика направления по средним
 };
 
 #endif // CALCULATEMESUREMENT_H
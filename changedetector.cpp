@@ -0,0 +1,110 @@
+#include "changedetector.h"               // заголовок детектора
+#include <algorithm>                      // std::max
+#include <QtMath>                         // M_PI
+#include <cmath>                          // fabs/exp/sqrt
+
+// новый отсчёт; true — обнаружен скачок
+bool ChangeDetector::update(double x)
+{
+    if (!m_hasPrev) {                                               // первый отсчёт
+        m_prev = x;
+        m_hasPrev = true;
+        restartSegment(x);                                          // участок начинается с него
+        m_sinceChange = 1;
+        return false;
+    }
+
+    // оценка шума по модулю приращений (устойчива к медленному дрейфу)
+    const double d = std::fabs(x - m_prev);
+    m_prev = x;
+    if (!m_hasDiff) { m_absDiff = d; m_hasDiff = true; }            // первое приращение
+    else m_absDiff += m_cfg.sigmaAlpha * (d - m_absDiff);           // экспоненциальное сглаживание
+
+    // пока среднее нового участка не набрано — только копим его
+    if (m_n < m_cfg.warmup) {
+        ++m_n;
+        m_mean += (x - m_mean) / m_n;
+        ++m_sinceChange;
+        return false;
+    }
+
+    // нормированное отклонение от среднего участка
+    const double z = (x - m_mean) / sigma();
+
+    // двусторонний CUSUM (Page-Hinkley с нулевым опорным сдвигом)
+    m_gPos = std::max(0.0, m_gPos + z - m_cfg.drift);               // накопление вверх
+    m_gNeg = std::max(0.0, m_gNeg - z - m_cfg.drift);               // накопление вниз
+
+    if (m_gPos > m_cfg.threshold || m_gNeg > m_cfg.threshold) {     // порог превышен
+        ++m_changes;                                                // считаем скачок
+        restartSegment(x);                                          // новый участок с текущего отсчёта
+        m_sinceChange = 0;
+        return true;
+    }
+
+    ++m_n;                                                          // Уэлфорд для среднего
+    m_mean += (x - m_mean) / m_n;
+    ++m_sinceChange;
+    return false;
+}
+
+// полный сброс
+void ChangeDetector::reset()
+{
+    m_mean = 0.0;
+    m_n = 0;
+    m_gPos = m_gNeg = 0.0;
+    m_absDiff = 0.0;
+    m_prev = 0.0;
+    m_hasPrev = false;
+    m_hasDiff = false;
+    m_sinceChange = 0;
+    m_changes = 0;
+}
+
+// нет скачков последние minSamples отсчётов
+bool ChangeDetector::isSettled(int minSamples) const
+{
+    return m_hasPrev && m_sinceChange >= minSamples;
+}
+
+// текущая σ шума
+double ChangeDetector::sigma() const
+{
+    if (m_cfg.sigma > 0.0)
+        return std::max(m_cfg.sigma, m_cfg.sigmaFloor);             // задана вручную
+    // для нормального шума E|Δx| = 2σ/√π
+    return std::max(m_absDiff * std::sqrt(M_PI) / 2.0, m_cfg.sigmaFloor);
+}
+
+// ARL0 двустороннего CUSUM (приближение Зигмунда)
+double ChangeDetector::averageRunLength(double threshold, double drift)
+{
+    const double b = threshold + 1.166;                             // поправка на перескок порога
+    double arlOneSided = b * b;                                     // предел при k → 0
+    if (drift > 1e-9) {
+        const double a = 2.0 * drift * b;
+        arlOneSided = (std::exp(a) - a - 1.0) / (2.0 * drift * drift);
+    }
+    return arlOneSided / 2.0;                                       // две стороны срабатывают независимо
+}
+
+// h под заданный ARL0 (ARL монотонно растёт по h — бисекция)
+double ChangeDetector::thresholdForArl(double arl0, double drift)
+{
+    double lo = 0.0, hi = 50.0;
+    for (int i = 0; i < 60; ++i) {
+        const double mid = 0.5 * (lo + hi);
+        if (averageRunLength(mid, drift) < arl0) lo = mid;
+        else hi = mid;
+    }
+    return hi;
+}
+
+// начать новый участок с x
+void ChangeDetector::restartSegment(double x)
+{
+    m_mean = x;
+    m_n = 1;
+    m_gPos = m_gNeg = 0.0;
+}
@@ -0,0 +1,56 @@
+#ifndef CHANGEDETECTOR_H
+#define CHANGEDETECTOR_H
+
+// потоковый детектор скачков (двусторонний CUSUM / Page-Hinkley), состояние O(1)
+// используется AutoMeasurement (вход/выход из зоны) и фильтрами (отсечение окна сохранения)
+class ChangeDetector
+{
+public:
+    // параметры детектора (в единицах σ шума)
+    struct Config {
+        double drift      = 0.5;      // k: допустимый дрейф среднего, половина искомого скачка
+        double threshold  = 5.0;      // h: порог срабатывания
+        double sigma      = 0.0;      // σ шума; 0 — оценивать на лету по |Δx|
+        double sigmaFloor = 1e-9;     // нижняя граница σ (квантованный сигнал)
+        double sigmaAlpha = 0.02;     // коэффициент сглаживания оценки σ
+        int    warmup     = 16;       // отсчётов на оценку среднего нового участка до проверки
+    };
+
+    ChangeDetector() = default;                                     // пустой конструктор
+    explicit ChangeDetector(const Config& cfg) : m_cfg(cfg) {}      // с параметрами
+
+    void setConfig(const Config& cfg) { m_cfg = cfg; }              // поставить параметры
+    const Config& config() const { return m_cfg; }                  // текущие параметры
+
+    bool update(double x);                                          // новый отсчёт; true — обнаружен скачок
+    void reset();                                                   // полный сброс
+
+    bool isSettled(int minSamples) const;                           // нет скачков последние minSamples отсчётов
+    int  samplesSinceChange() const { return m_sinceChange; }       // отсчётов после последнего скачка
+    int  changeCount() const { return m_changes; }                  // сколько скачков найдено с reset
+    double mean() const { return m_mean; }                          // среднее текущего участка
+    double sigma() const;                                           // текущая σ шума
+
+    // калибровка ложных срабатываний (нормальный шум, приближение Зигмунда)
+    static double averageRunLength(double threshold, double drift); // ARL0 двустороннего CUSUM
+    static double thresholdForArl(double arl0, double drift);       // h под заданный ARL0
+
+private:
+    void restartSegment(double x);                                  // начать новый участок с x
+
+    Config m_cfg{};                                                 // параметры
+
+    double m_mean = 0.0;                                            // среднее участка (Уэлфорд)
+    int    m_n = 0;                                                 // отсчётов в участке
+    double m_gPos = 0.0;                                            // накопитель вверх
+    double m_gNeg = 0.0;                                            // накопитель вниз
+    double m_absDiff = 0.0;                                         // сглаженное |x[i] - x[i-1]|
+    double m_prev = 0.0;                                            // прошлый отсчёт
+    bool   m_hasPrev = false;                                       // есть ли прошлый отсчёт
+    bool   m_hasDiff = false;                                       // есть ли оценка |Δx|
+
+    int    m_sinceChange = 0;                                       // отсчётов после скачка
+    int    m_changes = 0;                                           // найдено скачков
+};
+
+#endif // CHANGEDETECTOR_H
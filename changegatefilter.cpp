@@ -0,0 +1,47 @@
+#include "changegatefilter.h"
+
+ChangeGateFilter::ChangeGateFilter(Filter* next, const ChangeDetector::Config& cfg, QObject* parent)
+    : Filter(parent)
+    , m_next(next)
+    , m_detector(cfg)
+{
+    Q_ASSERT(m_next && "ChangeGateFilter: next stage must not be null");
+    m_next->setParent(this);
+}
+
+void ChangeGateFilter::clear()
+{
+    Filter::clear();
+    m_detector.reset();
+    m_window.clear();
+    m_dropped = 0;
+    m_next->clear();
+}
+
+void ChangeGateFilter::processData(const QVector<double>& values)
+{
+    // DataBuffer присылает всё окно целиком — новым всегда является последний отсчёт
+    if (values.isEmpty())
+        return;
+
+    processSamples(QVector<double>{ values.back() });
+}
+
+void ChangeGateFilter::processSamples(const QVector<double>& samples)
+{
+    for (double x : samples) {
+        if (m_detector.update(x)) {
+            // всё, что было до скачка, к новому положению не относится
+            m_dropped += m_window.size();
+            m_window.clear();
+        }
+        m_window.append(x);
+    }
+}
+
+double ChangeGateFilter::compute()
+{
+    m_next->clear();
+    m_next->processSamples(m_window);
+    return m_next->result();
+}
@@ -0,0 +1,36 @@
+#ifndef CHANGEGATEFILTER_H
+#define CHANGEGATEFILTER_H
+
+#include "filter.h"
+#include "changedetector.h"
+
+// Отсечение окна сохранения по детектору скачков: в следующую стадию уходят
+// только отсчёты после последнего обнаруженного скачка (ось уже стоит)
+class ChangeGateFilter : public Filter
+{
+    Q_OBJECT
+
+public:
+    // next — следующая стадия (например AverageFilter), владение переходит к ChangeGateFilter
+    explicit ChangeGateFilter(Filter* next,
+                              const ChangeDetector::Config& cfg = ChangeDetector::Config(),
+                              QObject* parent = nullptr);
+
+    void clear() override;
+    void processData(const QVector<double>& values) override;
+    void processSamples(const QVector<double>& samples) override;
+
+    int droppedCount() const { return m_dropped; }      // сколько отсчётов отброшено до скачка
+    int keptCount() const { return m_window.size(); }   // сколько отсчётов уйдёт в расчёт
+
+protected:
+    double compute() override;
+
+private:
+    Filter* m_next = nullptr;
+    ChangeDetector m_detector;
+    QVector<double> m_window;             // отсчёты после последнего скачка
+    int m_dropped = 0;
+};
+
+#endif // CHANGEGATEFILTER_H
@@ -0,0 +1,222 @@
+#include "cycleplanner.h"
+#include "expectedtable.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// медиана копии (n маленькое — окно буфера)
+double median(QVector<double> v)
+{
+    if (v.isEmpty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    const int m = v.size() / 2;
+    return (v.size() % 2) ? v[m] : 0.5 * (v[m - 1] + v[m]);
+}
+
+// построитель перемещений с оценкой времени
+struct Builder {
+    const CycleSettings& cfg;
+    CyclePlan& plan;
+    double pos = 0.0;                                            // где ось сейчас
+    bool   placed = false;                                       // начальная точка ещё не задана
+
+    void move(double to, bool rapid, int step = 0, ApproachDirection dir = ApproachDirection::Unknown)
+    {
+        CycleMove m;
+        m.position = to;
+        m.rapid = rapid;
+        m.stepNumber = step;
+        m.direction = dir;
+        if (step > 0) m.dwellSec = plan.dwellSec;
+        if (placed)
+            plan.travelTime += CyclePlanner::moveTime(std::fabs(to - pos), rapid ? cfg.rapidRate : cfg.feedRate,
+                                                      cfg.acceleration);
+        pos = to;
+        placed = true;
+        plan.moves.append(m);
+        if (step > 0)                                            // остановка: успокоение и записи
+            plan.stopTime += cfg.settleTime + plan.repeats * plan.dwellSec;
+    }
+
+    // подход к точке измерения со стороны sign: переезд ускоренным ходом до точки
+    // подхода, если так быстрее, и последний перебег — рабочей подачей
+    void approach(double target, double sign, int step, ApproachDirection dir)
+    {
+        const double o = std::max(0.0, cfg.overshoot);
+        const double d = std::fabs(target - pos);
+        const bool sameSide = (target - pos) * sign > 0.0;      // едем уже в нужную сторону
+        if (placed && sameSide && d > o && o > 0.0) {
+            const double direct = CyclePlanner::moveTime(d, cfg.feedRate, cfg.acceleration);
+            const double split  = CyclePlanner::moveTime(d - o, cfg.rapidRate, cfg.acceleration)
+                                + CyclePlanner::moveTime(o, cfg.feedRate, cfg.acceleration);
+            if (split < direct)
+                move(target - sign * o, true);
+        }
+        move(target, false, step, dir);
+    }
+};
+
+} // namespace
+
+int CyclePlan::measurements() const
+{
+    int n = 0;
+    for (const auto& m : moves)
+        if (m.stepNumber > 0) n += repeats;
+    return n;
+}
+
+double CyclePlanner::moveTime(double distance, double feedPerMin, double accel)
+{
+    if (distance <= 0.0 || feedPerMin <= 0.0) return 0.0;
+    const double v = feedPerMin / 60.0;                          // ед./с
+    if (accel <= 0.0) return distance / v;
+    if (distance >= v * v / accel)                               // выходит на подачу
+        return distance / v + v / accel;
+    return 2.0 * std::sqrt(distance / accel);                    // треугольный профиль
+}
+
+double CyclePlanner::noiseFloor(const QVector<double>& samples)
+{
+    if (samples.size() < 3) return 0.0;
+    QVector<double> d;
+    d.reserve(samples.size() - 1);
+    for (int i = 1; i < samples.size(); ++i)
+        d.append(samples[i] - samples[i - 1]);                   // разности убирают медленное движение
+    const double med = median(d);
+    for (double& x : d) x = std::fabs(x - med);
+    return 1.4826 * median(d) / std::sqrt(2.0);                  // MAD → σ, разность двух отсчётов — √2σ
+}
+
+double CyclePlanner::dwellFor(double noiseSigma, double sampleRateHz,
+                              double targetSigma, double fallbackDwellSec)
+{
+    if (noiseSigma <= 0.0 || sampleRateHz <= 0.0 || targetSigma <= 0.0)
+        return fallbackDwellSec;                                 // шум неизвестен — как при ручном сейве
+    const double ratio = noiseSigma / targetSigma;
+    const int samples = std::max(3, int(std::ceil(ratio * ratio))); // σ среднего = σ/√n
+    return samples / sampleRateHz;
+}
+
+CyclePlan CyclePlanner::optimize(const StepSettings& steps,
+                                 const CycleSettings& cycle,
+                                 double noiseSigma,
+                                 double sampleRateHz,
+                                 double fallbackDwellSec)
+{
+    CyclePlan plan;
+    if (steps.mode == StepMode::None) {
+        plan.error = "Цикл невозможен: не заданы шаги.";
+        return plan;
+    }
+    const int N = steps.count;                                   // край пинг-понга DataMeasurement, как в createPlan
+    if (N < 2) {
+        plan.error = "Цикл невозможен: нужно хотя бы две точки.";
+        return plan;
+    }
+
+    const ExpectedTable::Ptr table = ExpectedTable::forSettings(steps, N);
+    QVector<double> target(N + 1);
+    for (int s = 1; s <= N; ++s) {
+        target[s] = table->at(s);
+        if (!std::isfinite(target[s])) {
+            plan.error = QString("Цикл невозможен: шаг %1 без целевого значения.").arg(s);
+            return plan;
+        }
+    }
+
+    plan.cycles   = std::max(kIsoMinCycles, cycle.cycles);
+    plan.targets  = N;
+    plan.repeats  = std::max(1, steps.repeatCount);
+    plan.dwellSec = dwellFor(noiseSigma, sampleRateHz, cycle.targetSigma, fallbackDwellSec);
+
+    const double sign = (target[N] >= target[1]) ? 1.0 : -1.0;  // «вперёд» — от шага 1 к шагу N
+    const double o = std::max(0.0, cycle.overshoot);
+
+    Builder b{ cycle, plan };
+    b.move(target[1] - sign * o, true);                          // исходная точка перед первым подходом
+
+    for (int c = 0; c < plan.cycles; ++c) {
+        if (c > 0 && !steps.bidirectional)
+            b.move(target[1] - sign * o, true);                  // возврат к началу ускоренным ходом
+        for (int s = 1; s <= N; ++s)                             // проход вперёд
+            b.approach(target[s], sign, s, ApproachDirection::Forward);
+        if (!steps.bidirectional)
+            continue;
+
+        b.move(target[N] + sign * o, true);                      // перебег за N — выборка люфта
+        for (int s = N; s >= 1; --s)                             // проход назад
+            b.approach(target[s], -sign, s, ApproachDirection::Backward);
+        if (c + 1 < plan.cycles)
+            b.move(target[1] - sign * o, true);                  // перебег перед 1 — следующий цикл
+    }
+    return plan;
+}
+
+AutoSavePlan CyclePlanner::toAutoSavePlan(const CyclePlan& plan, const AutoPlanConfig& cfg)
+{
+    AutoSavePlan out;
+    out.cfg = cfg;
+    for (const auto& m : plan.moves) {
+        if (m.stepNumber <= 0) continue;                         // перебеги автомат не ждёт
+        SaveZone z;
+        z.stepNumber   = m.stepNumber;
+        z.expected     = m.position;
+        z.repeatsTotal = plan.repeats;
+        z.dwellSec     = m.dwellSec;
+        out.zones.push_back(z);
+    }
+    return out;
+}
+
+// Программа только в ASCII: стойки Fanuc и совместимые не принимают другие символы
+// даже в комментариях. Выдержка — словом из CycleSettings::dwellWord.
+QString CyclePlanner::toGCode(const CyclePlan& plan, const CycleSettings& cycle)
+{
+    QString axis;                                                // только латинская буква оси
+    for (const QChar c : cycle.axis.trimmed().toUpper())
+        if (c >= QChar('A') && c <= QChar('Z'))
+            axis += c;
+    if (axis.isEmpty()) axis = "X";
+    const int sec = int(std::ceil(plan.totalTime()));
+    const QString total = QString("%1:%2:%3").arg(sec / 3600, 2, 10, QChar('0'))
+                                             .arg(sec / 60 % 60, 2, 10, QChar('0'))
+                                             .arg(sec % 60, 2, 10, QChar('0'));
+    auto coord = [&](double p) { return QString::number(cycle.machineOrigin + p, 'f', 4); };
+    auto dwell = [&](double seconds) {
+        if (cycle.dwellWord == DwellWord::SecondsX)
+            return QString("G4 X%1").arg(seconds, 0, 'f', 3);
+        return QString("G4 P%1").arg(qRound64(seconds * 1000.0));
+    };
+
+    QString g;
+    g += QString("(CALIBRIX ISO 230-2 CYCLE, AXIS %1, CYCLES %2, TARGETS %3)\n")
+             .arg(axis).arg(plan.cycles).arg(plan.targets);
+    g += QString("(DWELL %1 S PER SAVE, %2 SAVES, ESTIMATED TIME %3)\n")
+             .arg(plan.dwellSec, 0, 'f', 2).arg(plan.repeats).arg(total);
+    g += "G21 G90 G94\n";
+
+    bool feedSet = false;
+    for (const auto& m : plan.moves) {
+        if (m.rapid) {
+            g += QString("G0 %1%2\n").arg(axis, coord(m.position));
+            continue;
+        }
+        g += QString("G1 %1%2").arg(axis, coord(m.position));
+        if (!feedSet) {                                          // подача модальна
+            g += QString(" F%1").arg(cycle.feedRate, 0, 'f', 1);
+            feedSet = true;
+        }
+        g += "\n";
+        if (m.stepNumber > 0) {
+            const double stop = cycle.settleTime + plan.repeats * m.dwellSec;
+            g += QString("%1 (STEP %2 %3)\n")
+                     .arg(dwell(stop))
+                     .arg(m.stepNumber)
+                     .arg(m.direction == ApproachDirection::Backward ? "BWD" : "FWD");
+        }
+    }
+    g += "M30\n";
+    return g;
+}
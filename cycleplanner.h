@@ -0,0 +1,64 @@
+#ifndef CYCLEPLANNER_H
+#define CYCLEPLANNER_H
+
+#include <QVector>
+#include <QString>
+#include "settingsmanager.h"            // StepSettings, CycleSettings
+#include "typemeasurement.h"            // ApproachDirection
+#include "automeasurement.h"            // AutoSavePlan
+
+// ----- одно перемещение цикла (координаты — относительно базы, как expected)
+struct CycleMove {
+    double position   = 0.0;                                     // куда едем
+    int    stepNumber = 0;                                       // шаг измерения (0 — перебег/переезд)
+    ApproachDirection direction = ApproachDirection::Unknown;    // подход к точке измерения
+    bool   rapid      = false;                                   // ускоренный ход (G0), без измерения
+    double dwellSec   = 0.0;                                     // выдержка на запись в точке
+};
+
+// ----- готовый цикл и оценка его длительности
+struct CyclePlan {
+    QVector<CycleMove> moves;                                    // перемещения по порядку
+    int    cycles     = 0;                                       // число циклов
+    int    targets    = 0;                                       // точек на цикл
+    int    repeats    = 1;                                       // записей на одну остановку
+    double dwellSec   = 0.0;                                     // выдержка на запись
+    double travelTime = 0.0;                                     // переезды, с
+    double stopTime   = 0.0;                                     // успокоение + выдержки, с
+    QString error;                                               // почему план не построен
+
+    bool isValid() const { return error.isEmpty() && !moves.isEmpty(); }
+    double totalTime() const { return travelTime + stopTime; }
+    int measurements() const;                                    // точек измерения во всём плане
+};
+
+// ----- оптимизатор цикла ISO 230-2 (чистый калькулятор, без состояния)
+// Порядок обхода — линейный цикл стандарта: 1..N вперёд, перебег за N, N..1 назад,
+// перебег перед 1 (однонаправленный — только вперёд с возвратом ускоренным ходом).
+// Этот порядок совпадает с тем, как DataMeasurement нумерует шаги новой группы (край —
+// StepSettings::count), поэтому автомат исполняет план с новой группы
+// (DataMeasurement::requestNewGroup). Внутри порядка время минимизируется:
+// выдержка — минимальная для заданной СКО среднего по шуму потока, переезды — ускоренным
+// ходом до точки подхода и рабочей подачей только на последнем перебеге (направление
+// подхода сохраняется), число циклов — не меньше минимума стандарта.
+class CyclePlanner
+{
+public:
+    static constexpr int kIsoMinCycles = 5;                      // ISO 230-2 для осей до 2000 мм
+
+    static CyclePlan optimize(const StepSettings& steps,
+                              const CycleSettings& cycle,
+                              double noiseSigma,                 // σ шума потока (0 — неизвестна)
+                              double sampleRateHz,               // частота потока (0 — неизвестна)
+                              double fallbackDwellSec);          // выдержка, если шум неизвестен
+
+    static double dwellFor(double noiseSigma, double sampleRateHz,
+                           double targetSigma, double fallbackDwellSec); // выдержка по шуму
+    static double noiseFloor(const QVector<double>& samples);   // σ шума по первым разностям (MAD)
+    static double moveTime(double distance, double feedPerMin, double accel); // трапеция скорости, с
+
+    static AutoSavePlan toAutoSavePlan(const CyclePlan& plan, const AutoPlanConfig& cfg); // для автомата
+    static QString toGCode(const CyclePlan& plan, const CycleSettings& cycle); // программа для стойки (ASCII)
+};
+
+#endif // CYCLEPLANNER_H
@@ -1,38 +1,57 @@
 #include "databuffer.h"
+#include <QMetaMethod>
+#include <algorithm>
 
 DataBuffer::DataBuffer(QObject *parent, int capacity)
     : QObject(parent), m_capacity(capacity)
 {
-    m_buffer.reserve(m_capacity);
+    m_ring.resize(m_capacity);
+    m_linear.reserve(m_capacity);
 }
 
 void DataBuffer::append(double value)
 {
-    if (m_buffer.size() < m_capacity) {
-        m_buffer.append(value*1000.000000);
+    if (m_count < m_capacity) {
+        m_ring[(m_head + m_count) % m_capacity] = value*1000.000000;
+        ++m_count;
     } else {
-        // Сдвигаем влево и добавляем новое значение в конец
-        for (int i = 0; i < m_capacity - 1; ++i)
-            m_buffer[i] = m_buffer[i + 1];
-        m_buffer[m_capacity - 1] = value*1000.000000;
+        // Затираем самое старое значение и сдвигаем голову — без сдвига окна
+        m_ring[m_head] = value*1000.000000;
+        m_head = (m_head + 1) % m_capacity;
     }
-    emit updated(m_buffer);
+    m_linearDirty = true;
+
+    // Окно по порядку собираем, только если его кто-то получит
+    static const QMetaMethod updatedSignal = QMetaMethod::fromSignal(&DataBuffer::updated);
+    if (isSignalConnected(updatedSignal))
+        emit updated(values());
 }
 
 void DataBuffer::clear()
 {
-    m_buffer.clear();
-    emit updated(m_buffer);
+    m_head = 0;
+    m_count = 0;
+    m_linear.clear();
+    m_linearDirty = false;
+    emit updated(m_linear);
 }
 
 QVector<double> DataBuffer::values() const
 {
-    return m_buffer;
+    if (m_linearDirty) {
+        // Разворачиваем кольцо: хвост от головы до конца, затем начало
+        m_linear.resize(m_count);
+        const int tail = std::min(m_count, m_capacity - m_head);
+        std::copy_n(m_ring.constData() + m_head, tail, m_linear.data());
+        std::copy_n(m_ring.constData(), m_count - tail, m_linear.data() + tail);
+        m_linearDirty = false;
+    }
+    return m_linear;
 }
 
 int DataBuffer::size() const
 {
-    return m_buffer.size();
+    return m_count;
 }
 
 int DataBuffer::capacity() const
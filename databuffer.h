@@ -12,7 +12,7 @@ public:
 
     void append(double value);          // Добавить новое измерение
     void clear();                       // Очистить буфер
-    QVector<double> values() const;     // Получить текущие значения буфера
+    QVector<double> values() const;     // Получить текущие значения буфера (от старого к новому)
     int size() const;                   // Количество элементов в буфере
     int capacity() const;               // Максимальная вместимость
 
@@ -20,8 +20,12 @@ signals:
     void updated(const QVector<double>& values); // Сигнал: буфер обновлён
 
 private:
-    QVector<double> m_buffer;
+    QVector<double> m_ring;             // Кольцо: новое значение пишется на место самого старого
+    int m_head = 0;                     // Индекс самого старого значения
+    int m_count = 0;                    // Заполненность кольца
     int m_capacity;
+    mutable QVector<double> m_linear;   // Окно по порядку — собирается только при чтении
+    mutable bool m_linearDirty = false;
 };
 
 #endif // DATABUFFER_H
@@ -1,5 +1,7 @@
 #include "datameasurement.h"            // заголовок класса
 #include "calculatemesurement.h"        // независимый калькулятор
+#include "recalcengine.h"               // параллельный пересчёт колонок
+#include <QDateTime>                    // время сохранения по умолчанию
 #include <algorithm>                    // std::max
 #include <cmath>                        // isnan
 
@@ -28,30 +30,24 @@ bool DataMeasurement::isStepStructureChanged(const StepSettings& a,
 // поставить новые настройки (с учётом пересчёта при смене базы)
 void DataMeasurement::setStepSettings(const StepSettings& settings)
 {
-    // вычисляем флаги изменений
-    m_stepStructureChanged = isStepStructureChanged(m_settings, settings);
+    // вычисляем флаги изменений; уже запрошенная новая группа (смена структуры, план цикла,
+    // откат к снимку) остаётся в силе до первого add, повторная установка тех же настроек её не снимает
+    const bool structureChanged = isStepStructureChanged(m_settings, settings);
+    m_stepStructureChanged = m_stepStructureChanged || structureChanged;
     m_baseChanged          = (m_settings.base != settings.base);
 
+    // отложенный пересчёт должен пройти по тем настройкам, при которых его запросили
+    if (structureChanged && derivedStale())
+        ensureDerived();
+
     // сохраняем старые и применяем новые
     m_prevSettings = m_settings;                                          // прошлые
     m_settings     = settings;                                            // текущие
+    m_expected     = ExpectedTable::forSettings(m_settings);              // таблица шагов — один раз на настройки
 
-    // если база изменилась и есть данные — пересчитать все значения и направления
-    if (m_baseChanged && !m_groups.isEmpty()) {
-        CalculateMesurement::recalcAllGroups(                              // пересчёт чисел
-            m_groups,
-            m_settings.mode,
-            m_settings.base,
-            m_settings.step,
-            m_settings.manualText,
-            m_settings.formula,
-            m_settings.formulaCount
-        );
-        CalculateMesurement::recalcDirectionsInGroups(                     // пересчёт направлений
-            m_groups,
-            /*maxStepForBidi*/ m_settings.count,
-            /*eps*/ 1e-4
-        );
+    // если база изменилась и есть данные — значения пересчитаются при первом чтении
+    if (m_baseChanged && m_cols.groupCount() > 0) {
+        invalidateDerived();                                               // O(1) вместо перезаписи всех измерений
         m_baseChanged = false;                                             // сбрасываем флаг базы
     }
 }
@@ -60,7 +56,7 @@ void DataMeasurement::setStepSettings(const StepSettings& settings)
 DataMeasurement::AddAction DataMeasurement::logicalAdd() const
 {
     // если нет ни одной группы
-    if (m_groups.isEmpty())
+    if (m_cols.groupCount() == 0)
         return AddAction::NewGroup;                                        // создаём первую группу
 
     // если поменялась структура шагов
@@ -84,7 +80,7 @@ DataMeasurement::AddAction DataMeasurement::logicalAdd() const
 
 
 // добавить новое значение
-void DataMeasurement::add(double value)
+void DataMeasurement::add(double value, const QVector<double>& rawWindow, qint64 timeMs)
 {
     AddAction what = logicalAdd();                                         // решаем что делать
 
@@ -92,7 +88,7 @@ void DataMeasurement::add(double value)
         case AddAction::NewGroup:
             startNewGroup(value);                                          // группа → шаг → измерение
             m_stepStructureChanged = false;                                 // сбрасываем флаг структуры
-            return;
+            break;
         case AddAction::NewStep:
             startNewStep(value);                                           // стартуем новый шаг
             break;
@@ -100,6 +96,207 @@ void DataMeasurement::add(double value)
             addNewMeasurement(value);                                      // дописываем повтор
             break;
     }
+
+    // новое измерение всегда последнее в текущем шаге — привязываем к нему сырое окно
+    if (!rawWindow.isEmpty())
+        m_cols.rawIndex.last() = m_raw.append(rawWindow);
+    m_cols.timeMs.last() = timeMs >= 0 ? timeMs                            // и время сохранения
+                                       : QDateTime::currentMSecsSinceEpoch();
+    thawGroup(m_cols.groupCount() - 1);                                    // меняется только последняя группа
+
+    // направление шага уже известно — учитываем измерение в накопителях
+    // (если кэш устарел, накопители всё равно пересоберутся при чтении)
+    if (derivedStale()) return;
+    const int last = m_cols.rowCount() - 1;                                // новая строка
+    const int g = m_cols.groupCount() - 1;
+    bool regrouped = false;                                                // поправки в хвосте группы сменились
+    if (!m_driftDirty && DriftModel::isReturn(m_cols, m_cols.seriesCount() - 1))
+        regrouped = addDriftReturn(last);                                  // возврат — узел модели без пересборки
+    if (m_driftCompensation) {
+        if (m_driftDirty) return;                                          // поправки всех строк — при чтении
+        m_cols.drift[last] = m_driftModel.at(g, m_cols.timeMs[last]);      // после последнего узла — его дрейф
+        m_cols.deviation[last] = CalculateMesurement::deviation(m_cols.distance[last] - m_cols.drift[last],
+                                                                m_cols.expected[last]);
+    }
+    if (regrouped) {                                                       // накопители группы — заново,
+        m_stats.rebuildGroup(m_cols, g);                                   // новая строка учтётся в них же
+        return;
+    }
+    m_stats.add(g,
+                m_cols.seriesStep.last(),
+                m_cols.seriesDirection.last(),
+                m_cols.deviation[last],
+                m_cols.expected[last]);
+}
+
+// строка возврата: узел модели группы дописывается на месте; при компенсации поправки
+// меняются только у её строк после предпоследнего узла (новая строка — в add)
+bool DataMeasurement::addDriftReturn(int row)
+{
+    const int series = m_cols.seriesCount() - 1;
+    const int g = m_cols.seriesGroup[series];
+    if (!m_driftModel.addReturnRow(g, series, m_cols.timeMs[row], DriftModel::rowLevel(m_cols, row))) {
+        m_driftDirty = true;                                               // возврат не по времени — модель заново
+        return false;
+    }
+    if (!m_driftCompensation) return false;
+
+    const qint64 since = m_driftModel.stableUntil(g);
+    bool changed = false;
+    for (int i = row - 1; i >= m_cols.seriesBegin(m_cols.groupBegin(g)); --i) { // записи идут по времени — с конца
+        const qint64 t = m_cols.timeMs[i];
+        if (t <= 0) continue;                                              // без времени дрейф 0
+        if (t <= since) break;                                             // дальше интерполяция прежняя
+        const double d = m_driftModel.at(g, t);
+        if (d == m_cols.drift[i]) continue;
+        m_cols.drift[i] = d;
+        m_cols.deviation[i] = CalculateMesurement::deviation(m_cols.distance[i] - d, m_cols.expected[i]);
+        changed = true;
+    }
+    return changed;
+}
+
+// заменить raw по rawIndex (результат другого фильтра) и пересчитать производные
+void DataMeasurement::reevaluateRaw(const QVector<double>& rawByIndex)
+{
+    const int rows = m_cols.rowCount();                                    // число измерений
+    for (int i = 0; i < rows; ++i) {                                       // один проход по колонке
+        const int ri = m_cols.rawIndex[i];
+        if (ri >= 0 && ri < rawByIndex.size())
+            m_cols.raw[i] = rawByIndex[ri];                                // новое значение фильтра
+    }
+
+    invalidateDerived();                                                   // пересчёт чисел и направлений — при чтении
+}
+
+// пометить производные колонки устаревшими
+void DataMeasurement::invalidateDerived()
+{
+    ++m_settingsVersion;                                                   // новая версия
+    m_derivedSettings = m_settings;                                        // по каким настройкам считать
+    m_derivedExpected = m_expected;                                        // и по какой таблице
+    m_groupsDirty = true;                                                  // представление устарело
+    m_frozen.clear();                                                      // все блоки снимков устарели
+}
+
+// включить/выключить компенсацию дрейфа — поправки перепишутся при первом чтении
+void DataMeasurement::setDriftCompensation(bool on)
+{
+    if (on == m_driftCompensation) return;
+    m_driftCompensation = on;
+    m_driftDirty = true;
+}
+
+// модель дрейфа заново по колонкам и поправки во все строки
+bool DataMeasurement::applyDrift() const
+{
+    m_driftDirty = false;
+    return applyDrift(m_cols, m_driftModel, m_driftCompensation, m_driftApplied);
+}
+
+bool DataMeasurement::applyDrift(MeasurementColumns& cols, DriftModel& model,
+                                 bool compensation, bool& applied)
+{
+    model = DriftModel::fromColumns(cols);                                 // узлы — по сырым уровням возвратов
+    if (!compensation && !applied) return false;                           // поправок нет и не было — колонки те же
+
+    for (int s = 0; s < cols.seriesCount(); ++s) {                         // один проход по колонкам
+        const int g = cols.seriesGroup[s];                                 // цепочка своей группы
+        for (int i = cols.seriesBegin(s); i < cols.seriesEnd(s); ++i) {
+            const double d = compensation ? model.at(g, cols.timeMs[i]) : 0.0;
+            cols.drift[i] = d;
+            cols.deviation[i] = CalculateMesurement::deviation(cols.distance[i] - d, cols.expected[i]);
+        }
+    }
+    applied = compensation;
+    return true;
+}
+
+// досчитать производные колонки по текущей версии настроек
+void DataMeasurement::ensureDerived() const
+{
+    const bool stale = derivedStale();
+    if (!stale && !m_driftDirty) return;                                   // кэш актуален
+    if (!stale) {
+        if (!applyDrift()) return;                                         // изменилась только модель
+        RecalcEngine::rebuildStatistics(m_stats, m_cols);                  // погрешности с новыми поправками
+        m_groupsDirty = true;
+        m_frozen.clear();
+        return;
+    }
+
+    recalcDerived(m_cols, m_stats, m_driftModel, m_derivedSettings, m_derivedExpected,
+                  m_driftCompensation, m_driftApplied);
+    m_driftDirty = false;
+    m_derivedVersion = m_settingsVersion;                                  // кэш соответствует версии
+    m_groupsDirty = true;                                                  // представление устарело
+    m_frozen.clear();                                                      // числа поменялись во всех группах
+}
+
+// производные по настройкам версии: числа, направления, дрейф, накопители (без членов —
+// одно ядро для ensureDerived и для задания вне GUI-потока)
+void DataMeasurement::recalcDerived(MeasurementColumns& cols, StepStatistics& stats, DriftModel& drift,
+                                    const StepSettings& settings, const ExpectedTable::Ptr& expected,
+                                    bool driftCompensation, bool& driftApplied)
+{
+    int maxStep = 0;                                                       // таблица должна покрыть все шаги данных
+    for (int st : cols.seriesStep) maxStep = std::max(maxStep, st);
+    ExpectedTable::Ptr table = expected;
+    if (table->maxStep() < maxStep)
+        table = ExpectedTable::forSettings(settings, maxStep);             // шаги сверх настроек — тоже из массива
+
+    RecalcEngine::recalcColumns(                                           // пересчёт чисел
+        cols,
+        settings.base,
+        *table
+    );
+    RecalcEngine::recalcDirectionsInColumns(                               // пересчёт направлений
+        cols,
+        /*maxStepForBidi*/ settings.count,
+        /*eps*/ 1e-4
+    );
+    applyDrift(cols, drift, driftCompensation, driftApplied);              // возвраты по новым числам и направлениям
+    RecalcEngine::rebuildStatistics(stats, cols);                          // накопители по новым числам
+}
+
+// задание пересчёта: колонки копируются неявно (O(1)), отделяются уже в рабочем потоке
+DataMeasurement::DerivedJob DataMeasurement::derivedJob() const
+{
+    DerivedJob job;
+    job.version = m_settingsVersion;
+    job.settings = m_derivedSettings;
+    job.expected = m_derivedExpected;
+    job.driftCompensation = m_driftCompensation;
+    job.driftApplied = m_driftApplied;
+    job.cols = m_cols;
+    return job;
+}
+
+// выполнить задание — в любом потоке, объект DataMeasurement не трогается
+void DataMeasurement::runDerived(DerivedJob& job)
+{
+    recalcDerived(job.cols, job.stats, job.drift, job.settings, job.expected,
+                  job.driftCompensation, job.driftApplied);
+    job.done = true;
+}
+
+// принять результат, если за время пересчёта не менялись ни версия, ни состав колонок
+bool DataMeasurement::adoptDerived(const DerivedJob& job)
+{
+    if (!job.done || !derivedStale() || job.version != m_settingsVersion
+        || job.cols.rowCount() != m_cols.rowCount() || job.cols.seriesCount() != m_cols.seriesCount()
+        || job.cols.groupCount() != m_cols.groupCount())
+        return false;                                                      // устарело — досчитается при чтении
+
+    m_cols = job.cols;
+    m_stats = job.stats;
+    m_driftModel = job.drift;
+    m_driftApplied = job.driftApplied;
+    m_driftDirty = job.driftCompensation != m_driftCompensation;           // режим дрейфа успели переключить
+    m_derivedVersion = m_settingsVersion;
+    m_groupsDirty = true;
+    m_frozen.clear();
+    return true;
 }
 
 // создать новую группу и сразу начать шаг
@@ -110,14 +307,11 @@ void DataMeasurement::startNewGroup(double firstValue)
     m_currentRepeat = 0;                                                   // сбрасываем повтор
     m_currentStep = 0;
 
-    MeasurementGroup g;                                                    // создаём группу
-    g.groupId = m_groupIdCounter;                                          // проставляем id
-    g.mode    = m_settings.mode;                                           // копируем режим
-    g.type    = m_settings.bidirectional
-              ? MeasurementGroupType::Bidirectional
-              : MeasurementGroupType::Unidirectional;                      // ставим тип
-
-    m_groups.append(g);                                                    // сохраняем группу
+    m_cols.appendGroup(m_groupIdCounter,                                   // проставляем id
+                       m_settings.mode,                                    // копируем режим
+                       m_settings.bidirectional
+                       ? MeasurementGroupType::Bidirectional
+                       : MeasurementGroupType::Unidirectional);            // ставим тип
     startNewStep(firstValue);                                              // создаём первый шаг
 }
 
@@ -126,7 +320,7 @@ DataMeasurement::StepAction DataMeasurement::logicalStartNewStep() const
 {
 
     // если шага ещё не было
-    if (m_groups.isEmpty() || currentGroup().steps.isEmpty()|| m_currentStep == 0)
+    if (m_cols.groupCount() == 0 || currentGroupSeries() == 0 || m_currentStep == 0)
         return StepAction::StartStep;                                      // начинаем с 1
 
     // если ограничений по шагам нет
@@ -140,16 +334,17 @@ DataMeasurement::StepAction DataMeasurement::logicalStartNewStep() const
     // ниже — логика пинг‑понга
     const int N = m_settings.count;                                        // крайний шаг
     const int cur = m_currentStep;                                         // текущий номер
-    const auto& steps = currentGroup().steps;                              // ссылка на шаги
-    const int prev  = steps.isEmpty() ? 0 : steps.last().stepNumber;       // предыдущий номер
-    const int prev2 = steps.size() >= 2 ? steps[steps.size() - 2].stepNumber : 0; // предпредыдущий
+    const int nSteps = currentGroupSeries();                               // шагов в группе
+    const int last = m_cols.seriesCount() - 1;                             // индекс последнего шага
+    const int prev  = nSteps >= 1 ? m_cols.seriesStep[last] : 0;           // предыдущий номер
+    const int prev2 = nSteps >= 2 ? m_cols.seriesStep[last - 1] : 0;       // предпредыдущий
 
     // если количество шагов не задано
     if (N <= 0)
         return StepAction::ContinueStepPlus;                               // как без лимита
 
     // левая граница: сначала дубль 1, затем вправо
-    if (cur <= 1  && !steps.isEmpty()) {
+    if (cur <= 1  && nSteps > 0) {
         if (prev2 == 0)                 return StepAction::ContinueStepPlus;  // старт группы: 1 → 2
         if (prev == 1 && prev2 == 1) return StepAction::ContinueStepPlus; // после дубля 1 → вправо
         if (prev == 1)                 return StepAction::ContinueStepConst; // первое касание 1 → дубль
@@ -195,40 +390,31 @@ void DataMeasurement::startNewStep(double firstValue)
             break;
     }
 
-    MeasurementSeries series;                                              // создаём шаг
-    series.stepNumber = m_currentStep;                                     // проставляем номер
-    series.direction  = ApproachDirection::Unknown;                        // направление определим позже
-
-    currentGroup().steps.append(series);                                   // кладём шаг в группу
+    m_cols.appendSeries(m_currentStep);                                    // кладём шаг в группу, направление позже
     addNewMeasurement(firstValue);                                         // записываем первое измерение
 
     // после первого измерения можно определить направление
-    if (currentGroup().steps.size() >= 2) {
-        const auto& prevS = currentGroup().steps[currentGroup().steps.size() - 2]; // предыдущий шаг
-        const auto& currS = currentSeries();                                        // текущий шаг
-        const bool isBidi = (currentGroup().type == MeasurementGroupType::Bidirectional); // флаг bidi
+    if (currentGroupSeries() >= 2) {
+        const int curr = m_cols.seriesCount() - 1;                                  // текущий шаг
+        const bool isBidi = (m_cols.groupType.last() == MeasurementGroupType::Bidirectional); // флаг bidi
         auto dir = CalculateMesurement::determineSeriesDirection(                    // единый метод
-                     prevS, currS, isBidi, /*maxStep*/ m_settings.count, /*eps*/1e-4);
-        currentSeries().direction = dir;                                             // записываем направление
+                     m_cols, curr - 1, curr, isBidi, /*maxStep*/ m_settings.count, /*eps*/1e-4);
+        m_cols.seriesDirection[curr] = dir;                                          // записываем направление
     }
 }
 
 // добавить одно измерение в текущий шаг
 void DataMeasurement::addNewMeasurement(double value)
 {
-    MeasurementSeries& series = currentSeries();                         // берём текущий шаг
+    const int stepNumber = m_cols.seriesStep.last();                     // номер текущего шага
 
     ++m_currentRepeat;                                                   // увеличиваем номер повтора
 
     auto v = CalculateMesurement::compute(                               // считаем три значения
         /*raw*/         value,
         /*base*/        m_settings.base,
-        /*mode*/        m_settings.mode,
-        /*stepNumber*/  series.stepNumber,
-        /*uniformStep*/ m_settings.step,
-        /*manualText*/  m_settings.manualText,
-        /*formula*/     m_settings.formula,
-        /*formulaCnt*/  m_settings.formulaCount
+        /*table*/       *m_expected,                                     // ожидаемое — O(1) из таблицы
+        /*stepNumber*/  stepNumber
     );
 
     Measurement m;                                                       // собираем запись
@@ -238,24 +424,86 @@ void DataMeasurement::addNewMeasurement(double value)
     m.expected    = v.expected;                                          // ожидаемое
     m.deviation   = v.deviation;                                         // погрешность
 
-    series.measurements.append(m);                                       // сохраняем запись
+    m_cols.appendRow(m);                                                 // сохраняем запись
+    m_groupsDirty = true;                                                // представление устарело
 }
 
 // загрузить группы извне
 void DataMeasurement::setGroups(const QVector<MeasurementGroup>& groups)
 {
-    m_groups = groups;                                                   // копируем склад
+    m_cols = MeasurementColumns::fromGroups(groups);                     // раскладываем в колонки
+    m_groupsView = groups;                                               // представление уже готово
+    RecalcEngine::rebuildStatistics(m_stats, m_cols);                    // накопители по шагам
+    m_frozen.clear();                                                    // блоки снимков — заново
+    m_derivedVersion = m_settingsVersion;                                // числа пришли готовыми
+    m_driftDirty = m_driftApplied = true;                                // поправки — по текущему режиму
+    m_groupsDirty = false;
     int maxId = 0;                                                       // ищем максимальный id
-    for (const auto& g : m_groups) maxId = std::max(maxId, g.groupId);   // обновляем максимум
+    for (int id : m_cols.groupId) maxId = std::max(maxId, id);           // обновляем максимум
     m_groupIdCounter = maxId;                                            // ставим счётчик
     m_currentStep = 0;                                                   // сбрасываем шаг
     m_currentRepeat = 0;                                                 // сбрасываем повтор
 }
 
+// загрузить сохранённую сессию целиком
+void DataMeasurement::load(const StepSettings& settings,
+                           const MeasurementColumns& cols,
+                           const RawRecordStore& raw,
+                           const MeasurementSnapshot::Cursor& cursor)
+{
+    clear();                                                             // с чистого листа
+    m_settings = settings;                                               // настройки сессии
+    m_expected = ExpectedTable::forSettings(m_settings);
+    m_prevSettings = settings;
+    m_cols = cols;                                                       // колонки как есть
+    m_raw = raw;                                                         // сырые окна (возможно, отображённые)
+    RecalcEngine::rebuildStatistics(m_stats, m_cols);                    // накопители по шагам
+    m_derivedVersion = m_settingsVersion;                                // числа пришли готовыми
+    m_driftDirty = m_driftApplied = true;                                // поправки — по текущему режиму
+    m_groupsDirty = true;                                                // представление соберём по запросу
+    int maxId = 0;                                                       // ищем максимальный id
+    for (int id : m_cols.groupId) maxId = std::max(maxId, id);           // обновляем максимум
+    m_groupIdCounter = std::max(maxId, cursor.groupIdCounter);           // ставим счётчик
+    m_currentStep = cursor.currentStep;                                  // конвейер add — как был
+    m_currentRepeat = cursor.currentRepeat;
+    m_stepStructureChanged = cursor.stepStructureChanged;
+}
+
+// последняя позиция записи: номер шага и число строк не зависят от настроек
+DataMeasurement::Position DataMeasurement::lastPosition() const
+{
+    Position p;
+    p.series = m_cols.seriesCount() - 1;
+    if (p.series >= 0) {
+        p.step = m_cols.seriesStep[p.series];
+        p.rows = m_cols.seriesRows(p.series);
+    }
+    return p;
+}
+
+// состояние конвейера add (для снимка и журнала)
+MeasurementSnapshot::Cursor DataMeasurement::cursor() const
+{
+    MeasurementSnapshot::Cursor c;
+    c.currentStep = m_currentStep;
+    c.currentRepeat = m_currentRepeat;
+    c.groupIdCounter = m_groupIdCounter;
+    c.stepStructureChanged = m_stepStructureChanged;
+    return c;
+}
+
 // очистить всё
 void DataMeasurement::clear()
 {
-    m_groups.clear();                                                    // чистим склад
+    m_cols.clear();                                                      // чистим склад
+    m_groupsView.clear();                                                // и его представление
+    m_groupsDirty = false;
+    m_raw.clear();                                                       // чистим сырые окна
+    m_stats.clear();                                                     // чистим накопители
+    m_frozen.clear();                                                    // и блоки снимков
+    m_driftModel.clear();                                                // и модель дрейфа
+    m_driftDirty = m_driftApplied = false;
+    m_derivedVersion = m_settingsVersion;                                // пустой кэш актуален
     m_currentStep = 0;                                                   // сбрасываем шаг
     m_currentRepeat = 0;                                                 // сбрасываем повтор
     m_groupIdCounter = 0;                                                // сбрасываем счётчик
@@ -263,28 +511,68 @@ void DataMeasurement::clear()
     m_baseChanged = false;                                               // сбрасываем флаг
     m_prevSettings = StepSettings{};                                     // сбрасываем прошлые
     m_settings     = StepSettings{};                                     // сбрасываем текущие
+    m_expected     = ExpectedTable::forSettings(m_settings);
 }
 
-// доступ к последней группе (non-const)
-MeasurementGroup& DataMeasurement::currentGroup()
+// снимок: общие блоки групп, пересобираются только изменённые после прошлого снимка
+MeasurementSnapshot DataMeasurement::snapshot() const
 {
-    return m_groups.last();
+    ensureDerived();                                                     // числа по текущей версии
+    const int groups = m_cols.groupCount();
+    m_frozen.resize(groups);                                             // новые группы — пустые блоки
+    for (int g = 0; g < groups; ++g)
+        if (!m_frozen[g])
+            m_frozen[g] = MeasurementSnapshot::freeze(m_cols, m_stats, g); // копируем только изменённые
+
+    MeasurementSnapshot s;
+    s.m_blocks = m_frozen;                                               // QVector указателей — O(1)
+    s.m_settings = m_settings;
+    s.m_raw = m_raw;                                                     // неявно разделяемые окна
+    s.m_cursor = cursor();
+    return s;
 }
 
-// доступ к последнему шагу (non-const)
-MeasurementSeries& DataMeasurement::currentSeries()
+// вернуться к снимку: колонки склеиваются из блоков, блоки остаются общими
+void DataMeasurement::restore(const MeasurementSnapshot& snapshot)
 {
-    return m_groups.last().steps.last();
+    m_cols = snapshot.columns();                                         // колонки из блоков
+    m_raw = snapshot.rawRecords();                                       // окна на момент снимка
+    m_settings = snapshot.stepSettings();                                // числа посчитаны по этим настройкам
+    m_expected = ExpectedTable::forSettings(m_settings);
+    m_prevSettings = m_settings;
+    RecalcEngine::rebuildStatistics(m_stats, m_cols);                    // накопители по шагам
+    m_frozen = snapshot.m_blocks;                                        // следующий снимок их переиспользует
+    m_derivedVersion = m_settingsVersion;                                // числа пришли готовыми
+    m_driftDirty = m_driftApplied = true;                                // поправки — по текущему режиму
+    m_groupsDirty = true;                                                // представление соберём по запросу
+    m_currentStep = snapshot.cursor().currentStep;                       // конвейер add — как был
+    m_currentRepeat = snapshot.cursor().currentRepeat;
+    m_groupIdCounter = snapshot.cursor().groupIdCounter;
+    m_stepStructureChanged = snapshot.cursor().stepStructureChanged;
+    m_baseChanged = false;
 }
 
-// доступ к последней группе (const)
-const MeasurementGroup& DataMeasurement::currentGroup() const
+// группа g изменилась — её блок снимка больше не годится
+void DataMeasurement::thawGroup(int g)
 {
-    return m_groups.last();
+    if (g >= 0 && g < m_frozen.size())
+        m_frozen[g].reset();
+}
+
+// вложенное представление: перестраивается только после изменений
+const QVector<MeasurementGroup>& DataMeasurement::groups() const
+{
+    ensureDerived();                                                     // производные колонки по текущей версии
+    if (m_groupsDirty) {
+        m_groupsView = m_cols.toGroups();                                // собираем из колонок
+        m_groupsDirty = false;
+    }
+    return m_groupsView;
 }
 
-// доступ к последнему шагу (const)
-const MeasurementSeries& DataMeasurement::currentSeries() const
+// число шагов в последней группе
+int DataMeasurement::currentGroupSeries() const
 {
-    return m_groups.last().steps.last();
+    const int g = m_cols.groupCount();
+    return g > 0 ? m_cols.groupSeries(g - 1) : 0;
 }
@@ -4,6 +4,12 @@
 #include <QVector>                      // контейнер для данных
 #include <QString>                      // строки для настроек
 #include "typemeasurement.h"            // Measurement*, Direction, Group types
+#include "rawrecordstore.h"             // сжатые сырые окна сохранений
+#include "measurementcolumns.h"         // колоночное хранилище
+#include "stepstatistics.h"             // накопители по шагам
+#include "measurementsnapshot.h"        // неизменяемые снимки
+#include "expectedtable.h"              // ожидаемые по шагам для текущих настроек
+#include "driftmodel.h"                 // дрейф по возвратам в опорную позицию
 
 // основное хранилище и логика добавления
 class DataMeasurement
@@ -15,10 +21,54 @@ public:
     bool isStepStructureChanged(const StepSettings& oldS,     // публичная проверка структуры
                                 const StepSettings& newS) const;
 
-    void add(double value);                                   // добавить новое значение
+    void add(double value,                                    // добавить новое значение
+             const QVector<double>& rawWindow = QVector<double>(), // и сырое окно, из которого оно получено
+             qint64 timeMs = -1);                             // время сохранения (-1 — сейчас)
     void clear();                                             // очистить всё
+    void requestNewGroup() { m_stepStructureChanged = true; } // следующий add откроет новую группу с шага 1
     void setGroups(const QVector<MeasurementGroup>& groups);  // загрузить группы
-    const QVector<MeasurementGroup>& groups() const { return m_groups; } // доступ к данным
+    const QVector<MeasurementGroup>& groups() const;          // вложенное представление (строится лениво)
+    const MeasurementColumns& columns() const { ensureDerived(); return m_cols; } // колоночный доступ к данным
+    const StepSettings& stepSettings() const { return m_settings; }      // текущие настройки
+    const ExpectedTable& expectedTable() const { return *m_expected; }   // ожидаемые по шагам для них
+    const RawRecordStore& rawRecords() const { return m_raw; }          // сырые окна сохранений
+    const StepStatistics& stepStatistics() const { ensureDerived(); return m_stats; } // накопители по (группа, шаг, направление)
+    struct Position {                                         // последняя позиция записи
+        int series = -1;                                      // индекс последней серии (-1 — данных нет)
+        int step   = 0;                                       // её номер шага
+        int rows   = 0;                                       // измерений в ней
+    };
+    Position lastPosition() const;                            // O(1) по хвосту колонок, без пересчёта производных
+    quint64 settingsVersion() const { return m_settingsVersion; }        // версия настроек для производных колонок
+    void setDriftCompensation(bool on);                       // вычитать дрейф из погрешностей
+    bool driftCompensation() const { return m_driftCompensation; }
+    const DriftModel& driftModel() const { ensureDerived(); return m_driftModel; } // узлы дрейфа для графика
+    void reevaluateRaw(const QVector<double>& rawByIndex);    // заменить raw по rawIndex и пересчитать
+    void load(const StepSettings& settings,                   // загрузить сохранённую сессию целиком
+              const MeasurementColumns& cols,                 // (числа уже посчитаны — без пересчёта)
+              const RawRecordStore& raw,
+              const MeasurementSnapshot::Cursor& cursor = {}); // конвейер add (по умолчанию — с начала)
+    MeasurementSnapshot::Cursor cursor() const;               // состояние конвейера add
+
+    // пересчёт производных вне GUI-потока: derivedJob() в GUI-потоке, runDerived() — в любом,
+    // adoptDerived() снова в GUI-потоке (false — данные успели измениться, досчитаются при чтении)
+    struct DerivedJob {
+        quint64 version = 0;                                  // версия настроек задания
+        StepSettings settings;                                // настройки версии
+        ExpectedTable::Ptr expected;                          // и их таблица
+        bool driftCompensation = false;                       // режим дрейфа на момент задания
+        bool driftApplied = false;                            // поправки в колонке drift
+        MeasurementColumns cols;                              // копия колонок → результат
+        StepStatistics stats;                                 // накопители результата
+        DriftModel drift;                                     // модель дрейфа результата
+        bool done = false;                                    // runDerived отработал
+    };
+    bool derivedPending() const { return derivedStale(); }    // производные ждут пересчёта
+    DerivedJob derivedJob() const;                            // задание по текущей версии
+    static void runDerived(DerivedJob& job);                  // посчитать задание
+    bool adoptDerived(const DerivedJob& job);                 // принять результат (true — принят)
+    MeasurementSnapshot snapshot() const;                     // неизменяемый снимок (общие блоки групп)
+    void restore(const MeasurementSnapshot& snapshot);        // вернуться к снимку (откат/повтор)
 
 private:
     // действия верхнего уровня (add)
@@ -29,9 +79,27 @@ private:
     // активные настройки
     StepSettings m_settings{};                                // текущие настройки
     StepSettings m_prevSettings{};                            // предыдущие настройки
+    ExpectedTable::Ptr m_expected = ExpectedTable::forSettings(StepSettings{}); // таблица для m_settings
 
     // склад измерений
-    QVector<MeasurementGroup> m_groups;                       // все группы
+    mutable MeasurementColumns m_cols;                        // все данные в колонках (производные — кэш)
+    mutable QVector<MeasurementGroup> m_groupsView;           // кэш вложенного представления
+    mutable bool m_groupsDirty = false;                       // кэш устарел
+    RawRecordStore m_raw;                                     // сырые окна (по Measurement::rawIndex)
+    mutable StepStatistics m_stats;                           // статистика погрешностей по шагам
+    mutable QVector<MeasurementSnapshot::BlockPtr> m_frozen;  // замороженные группы для снимков (null — менялась)
+
+    // версии производных колонок (distance/expected/deviation, направления, статистика)
+    quint64 m_settingsVersion = 0;                            // растёт при смене базы / raw
+    mutable quint64 m_derivedVersion = 0;                     // версия, по которой посчитан кэш
+    StepSettings m_derivedSettings{};                         // настройки, действующие для версии m_settingsVersion
+    ExpectedTable::Ptr m_derivedExpected = m_expected;        // таблица для m_derivedSettings
+
+    // дрейф (ISO 230-2): модель по возвратам, поправка — в колонке drift
+    bool m_driftCompensation = false;                         // вычитать дрейф из погрешностей
+    mutable DriftModel m_driftModel;                          // модель по текущим колонкам
+    mutable bool m_driftDirty = false;                        // модель устарела (режим, пересчёт, возврат не по времени)
+    mutable bool m_driftApplied = false;                      // в колонке drift могут быть ненулевые поправки
 
     // состояние конвейера
     int  m_currentStep   = 0;                                 // текущий номер шага
@@ -53,12 +121,21 @@ private:
     void startNewStep(double firstValue);                     // создать шаг и записать значение
     // добавить один повтор в текущий шаг
     void addNewMeasurement(double value);                     // записать измерение
+    // пометить производные колонки устаревшими — O(1), пересчёт при первом чтении
+    void invalidateDerived();                                 // новая версия настроек
+    void ensureDerived() const;                               // досчитать кэш, если версия устарела
+    bool derivedStale() const { return m_derivedVersion != m_settingsVersion; } // кэш устарел
+    bool addDriftReturn(int row);                             // возврат в модель на месте (true — поправки группы сменились)
+    bool applyDrift() const;                                  // модель заново и поправки во все строки (true — колонки менялись)
+    static bool applyDrift(MeasurementColumns& cols, DriftModel& model, // то же над чужими колонками
+                           bool compensation, bool& applied);
+    static void recalcDerived(MeasurementColumns& cols, StepStatistics& stats, DriftModel& drift,
+                              const StepSettings& settings, const ExpectedTable::Ptr& expected,
+                              bool driftCompensation, bool& driftApplied); // ядро пересчёта производных
+    void thawGroup(int g);                                    // группа изменилась — снимку нужен новый блок
 
     // быстрый доступ к текущим элементам
-    MeasurementGroup&  currentGroup();                        // последняя группа
-    MeasurementSeries& currentSeries();                       // последний шаг
-    const MeasurementGroup&  currentGroup() const;            // последняя группа
-    const MeasurementSeries& currentSeries() const;           // последний шаг
+    int currentGroupSeries() const;                           // число шагов в последней группе
 };
 
 #endif // DATAMEASUREMENT_H
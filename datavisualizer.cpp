@@ -99,20 +99,22 @@ void DataVisualizer::onBufferUpdated(const QVector<double>& values)
 }
 
 // Добавить значение в таблицу и на график 2
-void DataVisualizer::addSavedValue(const QVector<MeasurementGroup>& groups)
+void DataVisualizer::addSavedValue(const MeasurementColumns& cols)
 {
-    drawTable(groups);
-    drawGraph(groups, [](const Measurement& m) { return m.distance; });
+    drawTable(cols);
+    drawGraph(cols, cols.distance);
 }
 
-void DataVisualizer::drawTable(const QVector<MeasurementGroup>& groups)
+void DataVisualizer::drawTable(const MeasurementColumns& cols)
 {
     m_savedTableModel->removeRows(0, m_savedTableModel->rowCount());
 
-    for (const auto& group : groups) {
+    for (int g = 0; g < cols.groupCount(); ++g) {
+        const StepMode groupMode = cols.groupMode[g];
+
         // 1. Строка-заголовок группы
         QList<QStandardItem*> groupRow;
-        auto* groupHeader = new QStandardItem(QString("Группа №%1").arg(group.groupId));
+        auto* groupHeader = new QStandardItem(QString("Группа №%1").arg(cols.groupId[g]));
         groupHeader->setTextAlignment(Qt::AlignCenter);
         groupRow << groupHeader;
         m_savedTableModel->appendRow(groupRow);
@@ -121,19 +123,19 @@ void DataVisualizer::drawTable(const QVector<MeasurementGroup>& groups)
         m_savedTable->setSpan(m_savedTableModel->rowCount() - 1, 0, 1, 5);
 
         // ——— Стандартный вывод шагов
-        for (const auto& series : group.steps) {
+        for (int s = cols.groupBegin(g); s < cols.groupEnd(g); ++s) {
             QStringList distances, expecteds, deviations;
-            bool hasExpected = (group.mode != StepMode::None);
+            bool hasExpected = (groupMode != StepMode::None);
 
-            for (const auto& m : series.measurements) {
-                distances  << QString::number(m.distance, 'f', 6);
-                expecteds  << (hasExpected ? QString::number(m.expected, 'f', 6) : "-");
-                deviations << (hasExpected ? QString::number(m.deviation, 'f', 6) : "-");
+            for (int i = cols.seriesBegin(s); i < cols.seriesEnd(s); ++i) {
+                distances  << QString::number(cols.distance[i], 'f', 6);
+                expecteds  << (hasExpected ? QString::number(cols.expected[i], 'f', 6) : "-");
+                deviations << (hasExpected ? QString::number(cols.deviation[i], 'f', 6) : "-");
             }
 
             QList<QStandardItem*> row;
             auto* distItem = new QStandardItem(distances.join("\n"));
-            auto* stepItem = new QStandardItem(QString::number(series.stepNumber));
+            auto* stepItem = new QStandardItem(QString::number(cols.seriesStep[s]));
             auto* expItem  = new QStandardItem(expecteds.join("\n"));
             auto* devItem  = new QStandardItem(deviations.join("\n"));
 
@@ -146,7 +148,7 @@ void DataVisualizer::drawTable(const QVector<MeasurementGroup>& groups)
             row << distItem << stepItem << expItem << devItem;
 
             QString modeStr;
-            switch (group.mode) {
+            switch (groupMode) {
                 case StepMode::None:    modeStr = "Нет"; break;
                 case StepMode::Uniform: modeStr = "Равномерный"; break;
                 case StepMode::Manual:  modeStr = "Ручной"; break;
@@ -161,8 +163,8 @@ void DataVisualizer::drawTable(const QVector<MeasurementGroup>& groups)
 
 
 
-void DataVisualizer::drawGraph(const QVector<MeasurementGroup>& groups,
-                               std::function<double(const Measurement&)> valueAccessor)
+void DataVisualizer::drawGraph(const MeasurementColumns& cols,
+                               const QVector<double>& values)
 {
     m_avgChart->removeAllSeries();
     m_avgSeries = nullptr;
@@ -178,22 +180,22 @@ void DataVisualizer::drawGraph(const QVector<MeasurementGroup>& groups,
     QStringList labels;
     QSet<QString> seenLabels;
 
+    points.reserve(cols.rowCount());
+
     int index = 1;
-      for (const auto& group : groups) {
-          for (const auto& series : group.steps) {
-              for (const auto& m : series.measurements) {
-                  double y = valueAccessor(m);
-                  points.append(QPointF(index, y));
-
-                  QString label = QString("%1.%2").arg(series.stepNumber).arg(m.repeatIndex);
-                  while (seenLabels.contains(label)) {
-                      label += QChar(0x200B);
-                  }
-                  seenLabels.insert(label);
-
-                  m_avgAxisX->append(label, index);
-                  ++index;
+      for (int s = 0; s < cols.seriesCount(); ++s) {
+          const int stepNumber = cols.seriesStep[s];
+          for (int i = cols.seriesBegin(s); i < cols.seriesEnd(s); ++i) {
+              points.append(QPointF(index, values[i]));
+
+              QString label = QString("%1.%2").arg(stepNumber).arg(cols.repeatIndex[i]);
+              while (seenLabels.contains(label)) {
+                  label += QChar(0x200B);
               }
+              seenLabels.insert(label);
+
+              m_avgAxisX->append(label, index);
+              ++index;
           }
     }
 
@@ -44,7 +44,7 @@ public:
     void setAutoMeasuringView();
 
     // Добавить значение (вызывается только по кнопке "Сохранить")
-    void addSavedValue(const QVector<MeasurementGroup>& groups);
+    void addSavedValue(const MeasurementColumns& cols);
 
     // Сбросить оба графика и таблицы
     void clearAll();
@@ -97,8 +97,8 @@ private:
     QTimer* m_saveCountdownTimer = nullptr;
     int m_saveSecondsLeft;
 
-    void drawTable(const QVector<MeasurementGroup>& groups);
-    void drawGraph(const QVector<MeasurementGroup>& groups, std::function<double(const Measurement&)> valueAccessor);  // отрисовать весь график
+    void drawTable(const MeasurementColumns& cols);
+    void drawGraph(const MeasurementColumns& cols, const QVector<double>& values);  // отрисовать весь график по колонке values
     void resetAutoButton(); //сброс кнопки авторежима
 signals:
     void saveTimeout();
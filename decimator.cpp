@@ -0,0 +1,142 @@
+#include "decimator.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Скалярное произведение двух непрерывных массивов. Четыре независимых
+// аккумулятора разрывают цепочку зависимостей и дают компилятору
+// развернуть цикл в SIMD (SSE2/AVX/NEON) без интринсиков.
+inline double dot(const double* a, const double* b, int n)
+{
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i]     * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i)
+        s0 += a[i] * b[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+} // namespace
+
+Decimator::Decimator(int ratio, int tapsPerPhase, QObject* parent)
+    : QObject(parent)
+    , m_ratio(std::max(1, ratio))
+    , m_tapsPerPhase(std::max(1, tapsPerPhase))
+{
+    design();
+}
+
+void Decimator::setRatio(int ratio)
+{
+    ratio = std::max(1, ratio);
+    if (ratio == m_ratio)
+        return;
+    m_ratio = ratio;
+    design();
+}
+
+void Decimator::design()
+{
+    const int M = m_ratio;
+    const int T = m_tapsPerPhase;
+    const int L = M * T;
+
+    // оконный sinc (окно Блэкмана), срез чуть ниже новой частоты Найквиста
+    const double fc = 0.45 / M;
+    QVector<double> h(L);
+    double sum = 0.0;
+    for (int k = 0; k < L; ++k) {
+        const double t = k - (L - 1) / 2.0;
+        const double sinc = (t == 0.0) ? 2.0 * fc : std::sin(2.0 * M_PI * fc * t) / (M_PI * t);
+        const double w = (L > 1)
+            ? 0.42 - 0.5 * std::cos(2.0 * M_PI * k / (L - 1)) + 0.08 * std::cos(4.0 * M_PI * k / (L - 1))
+            : 1.0;
+        h[k] = sinc * w;
+        sum += h[k];
+    }
+    for (double& v : h) v /= sum;                     // единичное усиление на постоянке
+
+    // раскладываем на фазы: фаза p получает h[p], h[p+M], h[p+2M], ...
+    m_taps.resize(L);
+    for (int p = 0; p < M; ++p)
+        for (int q = 0; q < T; ++q)
+            m_taps[p * T + q] = h[p + q * M];
+
+    m_lines.resize(M * 2 * T);
+    m_linePos.resize(M);
+    reset();
+}
+
+void Decimator::reset()
+{
+    std::fill(m_lines.begin(), m_lines.end(), 0.0);
+    std::fill(m_linePos.begin(), m_linePos.end(), 0);
+    m_phase = 0;
+}
+
+bool Decimator::feed(double value, double& out)
+{
+    if (m_ratio == 1) {                               // без прореживания — сквозной проход
+        out = value;
+        return true;
+    }
+
+    const int T = m_tapsPerPhase;
+    const int p = m_phase;
+
+    // самый новый отсчёт фазы пишем перед предыдущим и в зеркальную половину,
+    // чтобы окно [pos, pos + T) всегда было непрерывным
+    double* line = m_lines.data() + p * 2 * T;
+    const int pos = (m_linePos[p] + T - 1) % T;
+    line[pos] = value;
+    line[pos + T] = value;
+    m_linePos[p] = pos;
+
+    if (p != 0) {                                     // кадр ещё не набран
+        m_phase = p - 1;
+        return false;
+    }
+
+    // кадр из ratio отсчётов набран — считаем один выходной отсчёт
+    double acc = 0.0;
+    const double* taps = m_taps.constData();
+    const double* lines = m_lines.constData();
+    for (int ph = 0; ph < m_ratio; ++ph)
+        acc += dot(taps + ph * T, lines + ph * 2 * T + m_linePos[ph], T);
+
+    m_phase = m_ratio - 1;
+    out = acc;
+    return true;
+}
+
+QVector<double> Decimator::process(const QVector<double>& input)
+{
+    QVector<double> out;
+    out.reserve(input.size() / m_ratio + 1);
+    double y = 0.0;
+    for (double x : input)
+        if (feed(x, y))
+            out.append(y);
+    return out;
+}
+
+void Decimator::push(double value)
+{
+    double y = 0.0;
+    if (feed(value, y))
+        emit sampleReady(y);
+}
+
+void Decimator::processBlock(const QVector<double>& values)
+{
+    const QVector<double> out = process(values);
+    if (!out.isEmpty())
+        emit blockReady(out);
+}
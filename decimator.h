@@ -0,0 +1,48 @@
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+
+#include <QObject>
+#include <QVector>
+
+// Полифазный КИХ-дециматор: антиалиасинговый ФНЧ + прореживание в ratio раз.
+// Стадии каскадируются соединением sampleReady → push (или blockReady → processBlock),
+// потребитель подключается к той стадии, частота которой ему нужна.
+class Decimator : public QObject
+{
+    Q_OBJECT
+public:
+    explicit Decimator(int ratio = 1, int tapsPerPhase = 8, QObject* parent = nullptr);
+
+    void setRatio(int ratio);                          // сменить коэффициент (перестраивает фильтр)
+    int ratio() const { return m_ratio; }
+    int tapsPerPhase() const { return m_tapsPerPhase; }
+
+    void reset();                                      // очистить линии задержки
+
+    // блочная обработка без сигналов: вход → прореженный выход
+    QVector<double> process(const QVector<double>& input);
+
+public slots:
+    void push(double value);                           // один входной отсчёт
+    void processBlock(const QVector<double>& values);  // блок входных отсчётов
+
+signals:
+    void sampleReady(double value);                    // выходной отсчёт
+    void blockReady(const QVector<double>& values);    // выходной блок
+
+private:
+    bool feed(double value, double& out);              // true, если кадр из ratio отсчётов готов
+    void design();                                     // расчёт коэффициентов и разбиение на фазы
+
+    int m_ratio = 1;
+    int m_tapsPerPhase = 8;
+
+    // фаза p хранит коэффициенты h[p + q·ratio], q = 0..tapsPerPhase-1 (подряд в памяти)
+    QVector<double> m_taps;
+    // линия задержки фазы p: 2·tapsPerPhase отсчётов (зеркало для непрерывного окна)
+    QVector<double> m_lines;
+    QVector<int>    m_linePos;                         // позиция самого нового отсчёта в фазе
+    int m_phase = 0;                                   // фаза следующего входного отсчёта
+};
+
+#endif // DECIMATOR_H
@@ -0,0 +1,119 @@
+#include "driftmodel.h"                 // заголовок модели
+#include <algorithm>                    // upper_bound, sort
+#include <cmath>                        // isnan
+
+// последний узел — среднее по его строкам; первый узел цепочки задаёт её нуль
+void DriftModel::setLast(Chain& c)
+{
+    const double level = c.sumL / c.n;
+    if (c.knots.size() == 1) c.origin = level;                          // первый возврат — нуль дрейфа
+    Knot& k = c.knots.last();
+    k.timeMs = qint64(c.sumT / c.n);
+    k.drift  = level - c.origin;
+}
+
+// строка возврата: повтор дописывается в последний узел, новая серия открывает узел
+bool DriftModel::addReturnRow(int group, int series, qint64 timeMs, double level)
+{
+    if (timeMs <= 0) return true;                                       // строки без времени не годятся
+    Chain& c = m_chains[group];
+    if (c.knots.isEmpty() || c.knots.last().series != series) {
+        if (!c.knots.isEmpty() && timeMs < c.knots.last().timeMs)
+            return false;                                               // не по времени — только полная сборка
+        Knot k;
+        k.series = series;
+        c.knots.append(k);
+        c.sumT = c.sumL = 0.0;
+        c.n = 0;
+    }
+    c.sumT += double(timeMs);
+    c.sumL += level;
+    ++c.n;
+    setLast(c);
+    return true;
+}
+
+// менялся только последний узел: до предпоследнего интерполяция прежняя
+qint64 DriftModel::stableUntil(int group) const
+{
+    const auto it = m_chains.constFind(group);
+    if (it == m_chains.cend() || it->knots.size() < 2)
+        return std::numeric_limits<qint64>::max();                      // один узел — везде 0, как и без него
+    return it->knots[it->knots.size() - 2].timeMs;
+}
+
+// дрейф на момент времени: линейно между соседними узлами своей цепочки
+double DriftModel::at(int group, qint64 timeMs) const
+{
+    const auto it = m_chains.constFind(group);
+    if (timeMs <= 0 || it == m_chains.cend()) return 0.0;               // время неизвестно или узлов нет
+    const QVector<Knot>& knots = it->knots;
+    if (timeMs <= knots.first().timeMs) return knots.first().drift;     // до первого узла (он сам — 0)
+    if (timeMs >= knots.last().timeMs) return knots.last().drift;       // после последнего — держим
+
+    auto hi = std::upper_bound(knots.cbegin(), knots.cend(), timeMs,
+                               [](qint64 t, const Knot& k) { return t < k.timeMs; });
+    auto lo = hi - 1;
+    const double span = double(hi->timeMs - lo->timeMs);
+    if (span <= 0.0) return hi->drift;
+    const double a = double(timeMs - lo->timeMs) / span;
+    return lo->drift + a * (hi->drift - lo->drift);
+}
+
+int DriftModel::knotCount() const
+{
+    int n = 0;
+    for (const Chain& c : m_chains) n += c.knots.size();
+    return n;
+}
+
+// серия — возврат в опорную позицию своей группы (шаг её первой серии)
+bool DriftModel::isReturn(const MeasurementColumns& cols, int series)
+{
+    const int reference = cols.seriesStep[cols.groupBegin(cols.seriesGroup[series])];
+    return cols.seriesStep[series] == reference
+        && cols.seriesDirection[series] != ApproachDirection::Backward; // подход назад несёт люфт
+}
+
+// уровень строки без дрейфа: погрешность, а без ожидаемого — само смещение
+double DriftModel::rowLevel(const MeasurementColumns& cols, int row)
+{
+    const double e = cols.expected[row];
+    return std::isnan(e) ? cols.distance[row] : cols.distance[row] - e;
+}
+
+// построить по колонкам: по узлу на каждую серию-возврат со временем
+DriftModel DriftModel::fromColumns(const MeasurementColumns& cols)
+{
+    struct Visit { qint64 t; double sumT; double sumL; int n; int group; int series; };
+    QVector<Visit> visits;
+
+    for (int s = 0; s < cols.seriesCount(); ++s) {
+        if (!isReturn(cols, s)) continue;
+        double sumT = 0.0, sumL = 0.0;
+        int n = 0;
+        for (int i = cols.seriesBegin(s); i < cols.seriesEnd(s); ++i) {
+            if (cols.timeMs[i] <= 0) continue;                          // строки без времени не годятся
+            sumT += double(cols.timeMs[i]);
+            sumL += rowLevel(cols, i);
+            ++n;
+        }
+        if (n > 0) visits.append({ qint64(sumT / n), sumT, sumL, n, cols.seriesGroup[s], s });
+    }
+
+    std::stable_sort(visits.begin(), visits.end(),                      // записи могли прийти не по времени
+                     [](const Visit& a, const Visit& b) { return a.t < b.t; });
+
+    DriftModel m;
+    for (const Visit& v : visits) {                                     // узел целиком, с теми же суммами, что и по строкам
+        Chain& c = m.m_chains[v.group];
+        Knot k;
+        k.series = v.series;
+        c.knots.append(k);
+        c.sumT = v.sumT;
+        c.sumL = v.sumL;
+        c.n = v.n;
+        setLast(c);
+    }
+    return m;
+}
@@ -0,0 +1,57 @@
+#ifndef DRIFTMODEL_H
+#define DRIFTMODEL_H
+
+#include <QVector>                      // узлы модели
+#include <QMap>                         // цепочки по группам
+#include <limits>                       // граница «всё время»
+#include "measurementcolumns.h"         // колонки с временем и погрешностями
+
+// кусочно-линейная модель дрейфа во времени по возвратам в опорную позицию (ISO 230-2).
+// Опорная позиция группы — шаг её первой серии; возврат — любая серия на этом шаге,
+// кроме подходов назад (у двунаправленных групп они несут ещё и люфт).
+// Узел — среднее время и средняя погрешность возврата. У каждой группы своя цепочка
+// узлов и свой нуль (её первый возврат): уровни групп с разной опорной позицией, базой
+// или таблицей не сравниваются, иначе их разница — погрешность позиционирования —
+// ушла бы в дрейф. До первого узла дрейф 0, между узлами — линейно, после последнего — как в нём.
+class DriftModel
+{
+public:
+    struct Knot {
+        qint64 timeMs = 0;                                  // время возврата, мс от эпохи
+        double drift  = 0.0;                                // дрейф относительно первого узла цепочки
+        int    series = -1;                                 // серия возврата в колонках
+    };
+
+    void clear() { m_chains.clear(); }                      // без узлов дрейф 0
+    // строка возврата: повтор последнего узла цепочки группы или новый узел в её хвост.
+    // false — серия новая, но старше последнего узла (модель нужно собрать заново)
+    bool addReturnRow(int group, int series, qint64 timeMs, double level);
+    // дрейф группы до этого момента не менялся последним addReturnRow (строки позже — пересчитать)
+    qint64 stableUntil(int group) const;
+
+    double at(int group, qint64 timeMs) const;              // дрейф на момент времени (0 — время неизвестно)
+    bool isEmpty() const { return m_chains.isEmpty(); }
+    int knotCount() const;                                  // узлов во всех цепочках
+    QList<int> groups() const { return m_chains.keys(); }   // группы с возвратами
+    QVector<Knot> knots(int group) const { return m_chains.value(group).knots; } // узлы для графика
+
+    // построить по колонкам: возвраты всех групп сессии
+    static DriftModel fromColumns(const MeasurementColumns& cols);
+    static bool isReturn(const MeasurementColumns& cols, int series); // серия — возврат в опорную позицию
+    static double rowLevel(const MeasurementColumns& cols, int row);  // уровень строки без дрейфа
+
+private:
+    struct Chain {
+        QVector<Knot> knots;                                // узлы по возрастанию времени
+        double origin = 0.0;                                // уровень первого возврата
+        double sumT = 0.0;                                  // суммы строк последнего узла
+        double sumL = 0.0;
+        int    n = 0;
+    };
+
+    static void setLast(Chain& c);                          // последний узел — по его суммам
+
+    QMap<int, Chain> m_chains;                              // группа → цепочка
+};
+
+#endif // DRIFTMODEL_H
@@ -0,0 +1,100 @@
+#include "environmentcompensator.h"
+#include <cmath>
+
+namespace {
+
+const double kReferenceTempC = 20.0;  // нормальная температура измерений (ISO 1)
+
+} // namespace
+
+EnvironmentCompensator::EnvironmentCompensator(QObject* parent)
+    : QObject(parent)
+{
+}
+
+void EnvironmentCompensator::setSettings(const EnvironmentSettings& settings)
+{
+    m_settings = settings;
+    updateCoefficients();
+}
+
+void EnvironmentCompensator::setEnvironment(const EnvironmentSample& sample)
+{
+    m_sample = sample;
+    m_hasSample = true;
+    updateCoefficients();
+}
+
+double EnvironmentCompensator::saturationVapourPressure(double tempC)
+{
+    // формула CIPM-81/91 (Davis), T в кельвинах
+    const double T = tempC + 273.15;
+    return std::exp(1.2378847e-5 * T * T - 1.9121316e-2 * T + 33.93711047 - 6.3431645e3 / T);
+}
+
+double EnvironmentCompensator::edlenIndex(const EnvironmentSample& env, double wavelengthNm)
+{
+    // Birch & Downs (1993, 1994): σ — волновое число в вакууме, мкм⁻¹
+    const double sigma = 1000.0 / wavelengthNm;
+    const double s2 = sigma * sigma;
+    const double t = env.airTemp;
+    const double p = env.pressure;
+
+    // стандартный воздух (15 °C, 101325 Па, 0.04 % CO₂)
+    const double ns = (8342.54 + 2406147.0 / (130.0 - s2) + 15998.0 / (38.9 - s2)) * 1e-8;
+
+    // приведение к t и p
+    const double ntp = p * ns / 96095.43
+                     * (1.0 + 1e-8 * (0.601 - 0.00972 * t) * p)
+                     / (1.0 + 0.0036610 * t);
+
+    // поправка на водяной пар: f — парциальное давление, Па
+    const double f = env.humidity / 100.0 * saturationVapourPressure(t);
+    return 1.0 + ntp - f * (3.7345 - 0.0401 * s2) * 1e-10;
+}
+
+void EnvironmentCompensator::updateCoefficients()
+{
+    if (!m_settings.enabled || !m_hasSample) {
+        m_airIndex = m_hasSample ? edlenIndex(m_sample, m_settings.wavelengthNm) : 1.0;
+        m_scale = 1.0;
+        m_offset = 0.0;
+        emit coefficientsChanged(m_scale, m_offset);
+        return;
+    }
+
+    // показания посчитаны с n0; в воздухе с n длина волны в n0/n раз другая
+    m_airIndex = edlenIndex(m_sample, m_settings.wavelengthNm);
+    const double air = m_settings.instrumentIndex / m_airIndex;
+
+    // приведение детали к 20 °C относительно неподвижной точки x0:
+    // x20 = x0 + (x - x0)/(1 + α·ΔT)
+    const double material = 1.0 / (1.0 + m_settings.expansionCoeff * (m_sample.materialTemp - kReferenceTempC));
+
+    m_scale = air * material;
+    m_offset = m_settings.expansionOrigin * (1.0 - material);
+    emit coefficientsChanged(m_scale, m_offset);
+}
+
+QVector<double> EnvironmentCompensator::process(const QVector<double>& input) const
+{
+    QVector<double> out(input.size());
+    const double k = m_scale;
+    const double c = m_offset;
+    const double* src = input.constData();
+    double* dst = out.data();
+    for (int i = 0; i < input.size(); ++i)
+        dst[i] = k * src[i] + c;
+    return out;
+}
+
+void EnvironmentCompensator::push(double value)
+{
+    emit sampleReady(m_scale * value + m_offset);
+}
+
+void EnvironmentCompensator::processBlock(const QVector<double>& values)
+{
+    if (!values.isEmpty())
+        emit blockReady(process(values));
+}
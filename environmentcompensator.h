@@ -0,0 +1,64 @@
+#ifndef ENVIRONMENTCOMPENSATOR_H
+#define ENVIRONMENTCOMPENSATOR_H
+
+#include <QObject>
+#include <QVector>
+#include "settingsmanager.h"
+
+// Один отсчёт условий измерения от вторичного источника (метеостанция лазера, датчик на детали)
+struct EnvironmentSample {
+    double airTemp = 20.0;             // температура воздуха, °C
+    double pressure = 101325.0;        // давление, Па
+    double humidity = 50.0;            // относительная влажность, %
+    double materialTemp = 20.0;        // температура детали/шкалы, °C
+};
+
+// Компенсация показаний лазерного интерферометра по условиям среды:
+// показатель преломления воздуха по уравнению Эдлена (Birch & Downs) и линейное
+// тепловое расширение материала с приведением к 20 °C. Коэффициенты пересчитываются
+// только при новом отсчёте среды; на каждый отсчёт потока — одно умножение-сложение
+// x' = scale·x + offset. Стадия включается между источником и дециматором.
+class EnvironmentCompensator : public QObject
+{
+    Q_OBJECT
+public:
+    explicit EnvironmentCompensator(QObject* parent = nullptr);
+
+    void setSettings(const EnvironmentSettings& settings);  // параметры лазера и материала
+    EnvironmentSettings settings() const { return m_settings; }
+
+    double scale() const { return m_scale; }                // текущие коэффициенты
+    double offset() const { return m_offset; }
+    double airIndex() const { return m_airIndex; }          // n воздуха по последнему отсчёту
+    bool hasEnvironment() const { return m_hasSample; }
+    EnvironmentSample environment() const { return m_sample; }
+
+    // показатель преломления воздуха (модифицированное уравнение Эдлена)
+    static double edlenIndex(const EnvironmentSample& env, double wavelengthNm);
+    static double saturationVapourPressure(double tempC);   // давление насыщенного пара, Па
+
+    QVector<double> process(const QVector<double>& input) const; // блок без сигналов
+
+public slots:
+    void setEnvironment(const EnvironmentSample& sample);   // новый отсчёт среды → коэффициенты
+    void push(double value);                                // один отсчёт потока
+    void processBlock(const QVector<double>& values);       // блок отсчётов потока
+
+signals:
+    void sampleReady(double value);
+    void blockReady(const QVector<double>& values);
+    void coefficientsChanged(double scale, double offset);
+
+private:
+    void updateCoefficients();                              // scale/offset по настройкам и среде
+
+    EnvironmentSettings m_settings;
+    EnvironmentSample m_sample;
+    bool m_hasSample = false;
+
+    double m_airIndex = 1.0;
+    double m_scale = 1.0;                                   // без поправок — сквозной проход
+    double m_offset = 0.0;
+};
+
+#endif // ENVIRONMENTCOMPENSATOR_H
@@ -0,0 +1,109 @@
+#include "environmentsource.h"
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+EnvironmentSource::EnvironmentSource(QObject* parent)
+    : QObject(parent)
+{
+    connect(&m_timer, &QTimer::timeout, this, &EnvironmentSource::poll);
+}
+
+void EnvironmentSource::start(const QString& path, int intervalMs)
+{
+    stop();
+    m_path = path;
+    m_pos = 0;
+    m_partial.clear();
+    m_reportedMissing = false;
+    if (m_path.isEmpty())
+        return;
+    m_timer.start(qMax(100, intervalMs));
+    poll();                                         // первый отсчёт — сразу
+}
+
+void EnvironmentSource::stop()
+{
+    m_timer.stop();
+}
+
+bool EnvironmentSource::parseLine(const QByteArray& line, EnvironmentSample& out)
+{
+    const QByteArray text = line.trimmed();
+    if (text.isEmpty())
+        return false;
+
+    if (text.startsWith('{')) {
+        QJsonParseError err;
+        const QJsonDocument doc = QJsonDocument::fromJson(text, &err);
+        if (err.error != QJsonParseError::NoError || !doc.isObject())
+            return false;
+        const QJsonObject o = doc.object();
+        if (!o.contains("air_temp") || !o.contains("pressure"))
+            return false;
+        EnvironmentSample s;
+        s.airTemp      = o.value("air_temp").toDouble();
+        s.pressure     = o.value("pressure").toDouble();
+        s.humidity     = o.value("humidity").toDouble(s.humidity);
+        s.materialTemp = o.value("material_temp").toDouble(s.airTemp); // нет датчика на детали — как воздух
+        out = s;
+        return true;
+    }
+
+    const QList<QByteArray> parts = text.simplified().split(' ');
+    if (parts.size() < 4)
+        return false;
+    double v[4];
+    for (int i = 0; i < 4; ++i) {
+        bool ok = false;
+        v[i] = parts[i].toDouble(&ok);
+        if (!ok)
+            return false;
+    }
+    out.airTemp = v[0];
+    out.pressure = v[1];
+    out.humidity = v[2];
+    out.materialTemp = v[3];
+    return true;
+}
+
+void EnvironmentSource::poll()
+{
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (!m_reportedMissing)
+            emit error(QString("Нет доступа к источнику условий среды: %1").arg(m_path));
+        m_reportedMissing = true;
+        return;
+    }
+    m_reportedMissing = false;
+
+    const qint64 size = file.size();
+    if (size < m_pos) {                             // файл переписан — читаем заново
+        m_pos = 0;
+        m_partial.clear();
+    }
+    if (size == m_pos)
+        return;                                     // нового нет
+    if (m_pos > 0 && !file.seek(m_pos))
+        return;
+
+    const QByteArray chunk = file.readAll();
+    m_pos += chunk.size();
+
+    // нужен только последний целый отсчёт — условия меняются медленно
+    QByteArray data = m_partial + chunk;
+    const int lastNl = data.lastIndexOf('\n');
+    m_partial = data.mid(lastNl + 1);
+    if (lastNl < 0)
+        return;
+
+    const QList<QByteArray> lines = data.left(lastNl).split('\n');
+    for (int i = lines.size() - 1; i >= 0; --i) {
+        EnvironmentSample s;
+        if (parseLine(lines[i], s)) {
+            emit sample(s);
+            return;
+        }
+    }
+}
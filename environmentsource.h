@@ -0,0 +1,41 @@
+#ifndef ENVIRONMENTSOURCE_H
+#define ENVIRONMENTSOURCE_H
+
+#include <QObject>
+#include <QTimer>
+#include <QString>
+#include "environmentcompensator.h"
+
+// Вторичный источник условий среды: файл, в который метеостанция (или скрипт-заглушка)
+// дописывает строки JSON {"air_temp":20.1,"pressure":101325,"humidity":45,"material_temp":20.3}
+// либо четыре числа через пробел в том же порядке. Файл опрашивается по таймеру,
+// читаются только новые строки; если файл переписан заново, чтение начинается сначала.
+class EnvironmentSource : public QObject
+{
+    Q_OBJECT
+public:
+    explicit EnvironmentSource(QObject* parent = nullptr);
+
+    void start(const QString& path, int intervalMs = 1000);
+    void stop();
+    bool isRunning() const { return m_timer.isActive(); }
+    QString path() const { return m_path; }
+
+    static bool parseLine(const QByteArray& line, EnvironmentSample& out); // одна строка отсчёта
+
+signals:
+    void sample(const EnvironmentSample& sample);   // последний целый отсчёт из новых строк
+    void error(const QString& error);
+
+private slots:
+    void poll();
+
+private:
+    QTimer m_timer;
+    QString m_path;
+    qint64 m_pos = 0;                               // прочитано байт файла
+    QByteArray m_partial;                           // недописанная строка с прошлого опроса
+    bool m_reportedMissing = false;                 // об отсутствии файла сообщаем один раз
+};
+
+#endif // ENVIRONMENTSOURCE_H
@@ -0,0 +1,118 @@
+#include "expectedtable.h"              // заголовок таблицы
+#include "calculatemesurement.h"        // те же правила, что и в калькуляторе
+#include <QHash>                        // qHash для строк
+#include <QMutex>                       // кэш общий для потоков
+#include <QMutexLocker>
+#include <algorithm>                    // std::max
+#include <limits>                       // NaN
+
+namespace {
+constexpr int kCacheSize = 4;                                   // таблиц в кэше (обычно живёт одна-две)
+}
+
+// хеш полей, от которых зависят значения
+quint64 ExpectedTable::keyOf(const StepSettings& s)
+{
+    size_t h = qHash(int(s.mode));
+    switch (s.mode) {                                           // поля, которые режим не читает, ключ не меняют
+        case StepMode::Uniform:
+            h = qHashMulti(h, s.step, s.count);
+            break;
+        case StepMode::Manual:
+            h = qHashMulti(h, s.manualText);
+            break;
+        case StepMode::Formula:
+            h = qHashMulti(h, s.formula, s.formulaCount, s.base, s.step);
+            break;
+        case StepMode::None:
+        default:
+            break;
+    }
+    return quint64(h);
+}
+
+// построена ли по этим настройкам (ключ + сами поля — на случай совпадения хешей)
+bool ExpectedTable::matches(const StepSettings& s) const
+{
+    if (s.mode != m_mode || keyOf(s) != m_key) return false;
+    switch (m_mode) {
+        case StepMode::Uniform: return s.step == m_step;
+        case StepMode::Manual:  return s.manualText == m_manualText;
+        case StepMode::Formula: return s.formula == m_formula.text() && s.formulaCount == m_formulaCount
+                                    && s.base == m_base && s.step == m_step;
+        case StepMode::None:
+        default:                return true;
+    }
+}
+
+// таблица из кэша или новая
+ExpectedTable::Ptr ExpectedTable::forSettings(const StepSettings& settings, int minSteps)
+{
+    static QMutex mutex;                                        // защита кэша
+    static QVector<Ptr> cache;                                  // последние построенные таблицы
+
+    QMutexLocker lock(&mutex);
+    for (int i = 0; i < cache.size(); ++i) {
+        const Ptr& t = cache[i];
+        if (t->matches(settings) && t->maxStep() >= minSteps) {
+            if (i > 0) cache.move(i, 0);                        // свежие — в начало
+            return cache[0];
+        }
+    }
+
+    Ptr t = std::make_shared<const ExpectedTable>(settings, minSteps);
+    cache.prepend(t);
+    if (cache.size() > kCacheSize) cache.removeLast();          // старые отпускаем
+    return t;
+}
+
+// построить таблицу один раз
+ExpectedTable::ExpectedTable(const StepSettings& s, int minSteps)
+    : m_key(keyOf(s)),
+      m_mode(s.mode),
+      m_base(s.base),
+      m_step(s.step),
+      m_formulaCount(s.formulaCount)
+{
+    switch (m_mode) {
+        case StepMode::Uniform: {
+            const int n = std::max(std::max(0, s.count), minSteps);
+            m_values.resize(n + 1);
+            m_values[0] = 0.0;
+            for (int st = 1; st <= n; ++st)
+                m_values[st] = CalculateMesurement::expectedUniform(st, m_step);
+            break;
+        }
+        case StepMode::Manual: {
+            m_manualText = s.manualText;
+            const QVector<double> list = CalculateMesurement::parseManual(m_manualText); // разбор один раз
+            const int n = std::max(int(list.size()), minSteps);
+            m_values.fill(0.0, n + 1);                         // за списком — 0.0, как в expectedManual
+            std::copy(list.cbegin(), list.cend(), m_values.begin() + 1);
+            break;
+        }
+        case StepMode::Formula: {
+            m_formula = FormulaExpression::compile(s.formula);  // компиляция один раз
+            const int n = std::max(std::max(0, s.formulaCount), minSteps);
+            m_values.fill(0.0, n + 1);
+            m_formula.evaluateSteps(1, n, m_formulaCount, m_base, m_step, m_values.data() + 1);
+            break;
+        }
+        case StepMode::None:
+        default:
+            m_values.fill(std::numeric_limits<double>::quiet_NaN(), 1); // ожидаемого нет ни у какого шага
+            break;
+    }
+}
+
+// шаг за пределами массива: то же правило режима, без разбора строк
+double ExpectedTable::beyond(int step) const
+{
+    switch (m_mode) {
+        case StepMode::Uniform: return CalculateMesurement::expectedUniform(step, m_step);
+        case StepMode::Manual:  return 0.0;                     // за списком — 0.0
+        case StepMode::Formula: return m_formula.evaluate({ double(step), double(m_formulaCount), m_base, m_step });
+        case StepMode::None:
+        default:                return std::numeric_limits<double>::quiet_NaN();
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef EXPECTEDTABLE_H
+#define EXPECTEDTABLE_H
+
+#include <QVector>                      // непрерывная таблица значений
+#include <memory>                       // общий владелец таблицы
+#include "settingsmanager.h"            // StepSettings, StepMode
+#include "formulaexpression.h"          // формула для шагов за пределами таблицы
+
+// неизменяемая таблица ожидаемых значений шагов для одних StepSettings.
+// Строится один раз (Manual разбирается, Formula компилируется и считается целиком)
+// и делится между DataMeasurement, AutoMeasurement и пересчётом: поиск — O(1) по массиву.
+// Таблицы кэшируются по ключу настроек, поэтому одинаковые настройки дают тот же объект.
+class ExpectedTable
+{
+public:
+    using Ptr = std::shared_ptr<const ExpectedTable>;
+
+    // таблица для настроек, покрывающая хотя бы шаги 1..minSteps (из общего кэша)
+    static Ptr forSettings(const StepSettings& settings, int minSteps = 0);
+    static quint64 keyOf(const StepSettings& settings);     // хеш полей, от которых зависят значения
+
+    double at(int step) const                                // ожидаемое для шага
+    {
+        if (step <= 0) return m_values[0];                  // шаг 0 и ниже
+        if (step < m_values.size()) return m_values[step];  // обычный случай — из массива
+        return beyond(step);                                // за таблицей — по правилу режима
+    }
+
+    int maxStep() const { return m_values.size() - 1; }     // последний шаг в массиве
+    quint64 key() const { return m_key; }                   // ключ настроек
+    StepMode mode() const { return m_mode; }                // режим шагов
+    bool matches(const StepSettings& settings) const;       // построена ли по этим настройкам
+
+    explicit ExpectedTable(const StepSettings& settings, int minSteps = 0); // построить сразу
+
+private:
+    double beyond(int step) const;                          // шаг за пределами массива
+
+    QVector<double>   m_values;                             // [0] — шаги ≤ 0, [s] — шаг s
+    quint64           m_key = 0;                            // ключ настроек
+    StepMode          m_mode = StepMode::None;              // режим
+    double            m_base = 0.0;                         // база (переменная формулы)
+    double            m_step = 0.0;                         // равномерный шаг
+    QString           m_manualText;                         // исходные поля — для проверки ключа
+    int               m_formulaCount = 0;
+    FormulaExpression m_formula;                            // скомпилированная формула
+};
+
+#endif // EXPECTEDTABLE_H
@@ -22,4 +22,7 @@ void Filter::processData(const QVector<double>& values)
     m_buffer += values;
 }
 
-
+void Filter::processSamples(const QVector<double>& samples)
+{
+    m_buffer += samples;
+}
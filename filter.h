@@ -13,7 +13,8 @@ public:
 
     virtual void clear();   // очистка буфера (вместо start)
     virtual double result(); // возвращает результат (вместо stop/compute)
-    virtual void processData(const QVector<double>& values);
+    virtual void processData(const QVector<double>& values);    // окно DataBuffer целиком
+    virtual void processSamples(const QVector<double>& samples); // поток отдельных отсчётов (от стадии)
 
 protected:
     QVector<double> m_buffer;
@@ -0,0 +1,357 @@
+#include "formulaexpression.h"          // заголовок формулы
+#include <cmath>                        // математические функции
+#include <limits>                       // NaN
+#include <algorithm>                    // std::min/max
+#include <QVarLengthArray>              // стек без кучи для одной точки
+#include <QtMath>                       // M_PI, M_E
+
+// -------------------------------------------------------
+// БЛОК 1. РАЗБОР (рекурсивный спуск прямо в постфиксную программу)
+// -------------------------------------------------------
+
+class FormulaParser
+{
+public:
+    FormulaParser(const QString& text, FormulaExpression& out) : m_s(text), m_out(out) {}
+
+    void run()
+    {
+        skipSpaces();
+        if (m_pos >= m_s.size()) { fail(QStringLiteral("Пустая формула")); return; }
+        expr();
+        skipSpaces();
+        if (ok() && m_pos < m_s.size())
+            fail(QStringLiteral("Лишние символы после выражения"));
+    }
+
+private:
+    using Op = FormulaExpression::Op;
+
+    bool ok() const { return m_out.m_error.isEmpty(); }
+
+    void fail(const QString& msg)
+    {
+        if (!ok()) return;                                   // первая ошибка важнее
+        m_out.m_error = msg;
+        m_out.m_errorPos = m_pos;
+    }
+
+    void skipSpaces() { while (m_pos < m_s.size() && m_s[m_pos].isSpace()) ++m_pos; }
+
+    bool accept(QChar c)
+    {
+        skipSpaces();
+        if (m_pos < m_s.size() && m_s[m_pos] == c) { ++m_pos; return true; }
+        return false;
+    }
+
+    // константы сворачиваются сразу: операция над двумя (одним) Const даёт Const
+    void emitConst(double v) { m_out.m_code.append({ Op::Const, v }); }
+    void emitVar(Op op)      { m_out.m_code.append({ op, 0.0 }); }
+
+    void emitOp(Op op)
+    {
+        auto& code = m_out.m_code;
+        const int k = FormulaExpression::arity(op);
+        const int n = code.size();
+        if (k == 1 && n >= 1 && code[n - 1].op == Op::Const) {
+            code[n - 1].value = FormulaExpression::apply1(op, code[n - 1].value);
+            return;
+        }
+        if (k == 2 && n >= 2 && code[n - 1].op == Op::Const && code[n - 2].op == Op::Const) {
+            code[n - 2].value = FormulaExpression::apply2(op, code[n - 2].value, code[n - 1].value);
+            code.removeLast();
+            return;
+        }
+        code.append({ op, 0.0 });
+    }
+
+    // expr := term (('+' | '-') term)*
+    void expr()
+    {
+        term();
+        while (ok()) {
+            if (accept('+'))      { term(); emitOp(Op::Add); }
+            else if (accept('-')) { term(); emitOp(Op::Sub); }
+            else break;
+        }
+    }
+
+    // term := unary (('*' | '/') unary)*
+    void term()
+    {
+        unary();
+        while (ok()) {
+            if (accept('*'))      { unary(); emitOp(Op::Mul); }
+            else if (accept('/')) { unary(); emitOp(Op::Div); }
+            else break;
+        }
+    }
+
+    // unary := ('-' | '+') unary | power   (так -i^2 = -(i^2))
+    void unary()
+    {
+        if (accept('-')) { unary(); emitOp(Op::Neg); return; }
+        if (accept('+')) { unary(); return; }
+        power();
+    }
+
+    // power := primary ('^' unary)?   (правоассоциативно)
+    void power()
+    {
+        primary();
+        if (ok() && accept('^')) { unary(); emitOp(Op::Pow); }
+    }
+
+    // primary := число | имя | имя '(' аргументы ')' | '(' expr ')'
+    void primary()
+    {
+        if (!ok()) return;
+        skipSpaces();
+        if (m_pos >= m_s.size()) { fail(QStringLiteral("Неожиданный конец формулы")); return; }
+
+        const QChar c = m_s[m_pos];
+        if (c == '(') {
+            ++m_pos;
+            expr();
+            if (ok() && !accept(')')) fail(QStringLiteral("Ожидалась «)»"));
+            return;
+        }
+        if (c.isDigit() || c == '.') { number(); return; }
+        if (c.isLetter() || c == '_') { name(); return; }
+        fail(QStringLiteral("Ожидалось число, переменная или «(»"));
+    }
+
+    void number()
+    {
+        const int start = m_pos;
+        while (m_pos < m_s.size() && (m_s[m_pos].isDigit() || m_s[m_pos] == '.')) ++m_pos;
+        // показатель степени: 1e-3, 2E5 (но «2e» без цифр — ошибка ниже, а не константа e)
+        if (m_pos < m_s.size() && (m_s[m_pos] == 'e' || m_s[m_pos] == 'E')) {
+            int p = m_pos + 1;
+            if (p < m_s.size() && (m_s[p] == '+' || m_s[p] == '-')) ++p;
+            if (p < m_s.size() && m_s[p].isDigit()) {
+                m_pos = p;
+                while (m_pos < m_s.size() && m_s[m_pos].isDigit()) ++m_pos;
+            }
+        }
+        bool good = false;
+        const double v = m_s.mid(start, m_pos - start).toDouble(&good);
+        if (!good) { m_pos = start; fail(QStringLiteral("Неверное число")); return; }
+        emitConst(v);
+    }
+
+    void name()
+    {
+        const int start = m_pos;
+        while (m_pos < m_s.size() && (m_s[m_pos].isLetterOrNumber() || m_s[m_pos] == '_')) ++m_pos;
+        const QString id = m_s.mid(start, m_pos - start).toLower();
+
+        skipSpaces();
+        const bool call = (m_pos < m_s.size() && m_s[m_pos] == '(');
+        if (!call) {
+            if (id == QLatin1String("i"))    { emitVar(Op::VarI);    return; }
+            if (id == QLatin1String("n"))    { emitVar(Op::VarN);    return; }
+            if (id == QLatin1String("base")) { emitVar(Op::VarBase); return; }
+            if (id == QLatin1String("step")) { emitVar(Op::VarStep); return; }
+            if (id == QLatin1String("pi"))   { emitConst(M_PI);      return; }
+            if (id == QLatin1String("e"))    { emitConst(M_E);       return; }
+            m_pos = start;
+            fail(QStringLiteral("Неизвестное имя «%1»").arg(id));
+            return;
+        }
+
+        static const struct { const char* name; Op op; } functions[] = {
+            { "sin", Op::Sin },   { "cos", Op::Cos },     { "tan", Op::Tan },
+            { "asin", Op::Asin }, { "acos", Op::Acos },   { "atan", Op::Atan },
+            { "sqrt", Op::Sqrt }, { "abs", Op::Abs },     { "exp", Op::Exp },
+            { "ln", Op::Ln },     { "log", Op::Log10 },   { "floor", Op::Floor },
+            { "ceil", Op::Ceil }, { "round", Op::Round },  { "min", Op::Min },
+            { "max", Op::Max },   { "pow", Op::Pow },     { "atan2", Op::Atan2 },
+        };
+        const Op* op = nullptr;
+        for (const auto& f : functions)
+            if (id == QLatin1String(f.name)) { op = &f.op; break; }
+        if (!op) { m_pos = start; fail(QStringLiteral("Неизвестная функция «%1»").arg(id)); return; }
+
+        ++m_pos;                                                         // '('
+        int args = 0;
+        if (!accept(')')) {
+            do { expr(); ++args; } while (ok() && accept(','));
+            if (ok() && !accept(')')) { fail(QStringLiteral("Ожидалась «)»")); return; }
+        }
+        if (!ok()) return;
+
+        const int need = FormulaExpression::arity(*op);
+        if (args != need) {
+            m_pos = start;
+            fail(QStringLiteral("Функция %1 ожидает аргументов: %2").arg(id).arg(need));
+            return;
+        }
+        emitOp(*op);
+    }
+
+    const QString&     m_s;
+    FormulaExpression& m_out;
+    int                m_pos = 0;
+};
+
+// разобрать текст
+FormulaExpression FormulaExpression::compile(const QString& text)
+{
+    FormulaExpression f;
+    f.m_text = text;
+    FormulaParser(text, f).run();
+    if (!f.m_error.isEmpty()) {
+        f.m_code.clear();
+        return f;
+    }
+
+    // глубина стека — для буферов исполнения
+    int depth = 0;
+    for (const auto& ins : f.m_code) {
+        depth += 1 - arity(ins.op);
+        f.m_depth = std::max(f.m_depth, depth);
+    }
+    return f;
+}
+
+// -------------------------------------------------------
+// БЛОК 2. ОПЕРАЦИИ
+// -------------------------------------------------------
+
+int FormulaExpression::arity(Op op)
+{
+    switch (op) {
+        case Op::Const: case Op::VarI: case Op::VarN: case Op::VarBase: case Op::VarStep:
+            return 0;
+        case Op::Add: case Op::Sub: case Op::Mul: case Op::Div:
+        case Op::Pow: case Op::Min: case Op::Max: case Op::Atan2:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+double FormulaExpression::apply1(Op op, double a)
+{
+    switch (op) {
+        case Op::Neg:   return -a;
+        case Op::Sin:   return std::sin(a);
+        case Op::Cos:   return std::cos(a);
+        case Op::Tan:   return std::tan(a);
+        case Op::Asin:  return std::asin(a);
+        case Op::Acos:  return std::acos(a);
+        case Op::Atan:  return std::atan(a);
+        case Op::Sqrt:  return std::sqrt(a);
+        case Op::Abs:   return std::abs(a);
+        case Op::Exp:   return std::exp(a);
+        case Op::Ln:    return std::log(a);
+        case Op::Log10: return std::log10(a);
+        case Op::Floor: return std::floor(a);
+        case Op::Ceil:  return std::ceil(a);
+        case Op::Round: return std::round(a);
+        default:        return std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+double FormulaExpression::apply2(Op op, double a, double b)
+{
+    switch (op) {
+        case Op::Add:   return a + b;
+        case Op::Sub:   return a - b;
+        case Op::Mul:   return a * b;
+        case Op::Div:   return a / b;                                    // деление на 0 — inf/NaN по IEEE
+        case Op::Pow:   return std::pow(a, b);
+        case Op::Min:   return std::min(a, b);
+        case Op::Max:   return std::max(a, b);
+        case Op::Atan2: return std::atan2(a, b);
+        default:        return std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+// -------------------------------------------------------
+// БЛОК 3. ИСПОЛНЕНИЕ
+// -------------------------------------------------------
+
+// одна точка
+double FormulaExpression::evaluate(const Variables& v) const
+{
+    if (!isValid()) return std::numeric_limits<double>::quiet_NaN();
+
+    QVarLengthArray<double, 32> stack(m_depth);
+    int top = 0;                                                         // число значений на стеке
+    for (const auto& ins : m_code) {
+        switch (ins.op) {
+            case Op::Const:   stack[top++] = ins.value; break;
+            case Op::VarI:    stack[top++] = v.i;       break;
+            case Op::VarN:    stack[top++] = v.n;       break;
+            case Op::VarBase: stack[top++] = v.base;    break;
+            case Op::VarStep: stack[top++] = v.step;    break;
+            default:
+                if (arity(ins.op) == 2) {
+                    --top;
+                    stack[top - 1] = apply2(ins.op, stack[top - 1], stack[top]);
+                } else {
+                    stack[top - 1] = apply1(ins.op, stack[top - 1]);
+                }
+                break;
+        }
+    }
+    return stack[0];
+}
+
+// таблица шагов: стек из «регистров» по kBlock значений, каждая инструкция — цикл по блоку
+void FormulaExpression::evaluateSteps(int first, int count, double n, double base, double step, double* out) const
+{
+    if (count <= 0) return;
+    if (!isValid()) {
+        std::fill(out, out + count, std::numeric_limits<double>::quiet_NaN());
+        return;
+    }
+
+    constexpr int kBlock = 256;                                          // шагов за проход
+    QVector<double> regs(m_depth * kBlock);                              // регистр r = [r*kBlock, (r+1)*kBlock)
+    double* R = regs.data();
+
+    for (int b0 = 0; b0 < count; b0 += kBlock) {
+        const int len = std::min(kBlock, count - b0);
+        int top = 0;
+        for (const auto& ins : m_code) {
+            double* dst = R + top * kBlock;
+            switch (ins.op) {
+                case Op::Const:   std::fill(dst, dst + len, ins.value); ++top; break;
+                case Op::VarN:    std::fill(dst, dst + len, n);         ++top; break;
+                case Op::VarBase: std::fill(dst, dst + len, base);      ++top; break;
+                case Op::VarStep: std::fill(dst, dst + len, step);      ++top; break;
+                case Op::VarI:
+                    for (int k = 0; k < len; ++k) dst[k] = double(first + b0 + k);
+                    ++top;
+                    break;
+                case Op::Add: case Op::Sub: case Op::Mul: case Op::Div: {
+                    // частые операции — отдельными простыми циклами (векторизуются компилятором)
+                    double* a = R + (top - 2) * kBlock;
+                    const double* c = R + (top - 1) * kBlock;
+                    if (ins.op == Op::Add)      for (int k = 0; k < len; ++k) a[k] += c[k];
+                    else if (ins.op == Op::Sub) for (int k = 0; k < len; ++k) a[k] -= c[k];
+                    else if (ins.op == Op::Mul) for (int k = 0; k < len; ++k) a[k] *= c[k];
+                    else                        for (int k = 0; k < len; ++k) a[k] /= c[k];
+                    --top;
+                    break;
+                }
+                default:
+                    if (arity(ins.op) == 2) {
+                        double* a = R + (top - 2) * kBlock;
+                        const double* c = R + (top - 1) * kBlock;
+                        for (int k = 0; k < len; ++k) a[k] = apply2(ins.op, a[k], c[k]);
+                        --top;
+                    } else {
+                        double* a = R + (top - 1) * kBlock;
+                        for (int k = 0; k < len; ++k) a[k] = apply1(ins.op, a[k]);
+                    }
+                    break;
+            }
+        }
+        std::copy(R, R + len, out + b0);                                 // результат — в нижнем регистре
+    }
+}
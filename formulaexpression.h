@@ -0,0 +1,66 @@
+#ifndef FORMULAEXPRESSION_H
+#define FORMULAEXPRESSION_H
+
+#include <QVector>                      // программа и таблицы
+#include <QString>                      // текст формулы и ошибки
+
+// скомпилированная формула ожидаемых значений шагов (StepMode::Formula).
+// Текст разбирается один раз в стековый байткод; переменные: i (номер шага),
+// n (число точек), base (база), step (шаг). Поддерживаются + - * / ^, скобки,
+// константы pi и e и функции sin cos tan asin acos atan sqrt abs exp ln log
+// floor ceil round, min max pow atan2 (по два аргумента).
+// Готовая программа неизменяема и может исполняться из нескольких потоков.
+class FormulaExpression
+{
+public:
+    // значения переменных для одной точки
+    struct Variables {
+        double i    = 0.0;                                  // номер шага
+        double n    = 0.0;                                  // число точек
+        double base = 0.0;                                  // база
+        double step = 0.0;                                  // шаг
+    };
+
+    FormulaExpression() = default;                          // пустая (невалидная) формула
+
+    static FormulaExpression compile(const QString& text);  // разобрать текст
+
+    bool isValid() const { return m_error.isEmpty() && !m_code.isEmpty(); } // можно исполнять
+    const QString& errorString() const { return m_error; }  // текст ошибки разбора
+    int errorPosition() const { return m_errorPos; }        // позиция ошибки в тексте (-1 — нет)
+    const QString& text() const { return m_text; }          // исходный текст
+
+    double evaluate(const Variables& v) const;              // одна точка (NaN для невалидной)
+
+    // таблица значений для шагов first..first+count-1 одним проходом по программе:
+    // каждая инструкция выполняется сразу над блоком шагов
+    void evaluateSteps(int first, int count, double n, double base, double step, double* out) const;
+
+private:
+    friend class FormulaParser;                             // разбор пишет программу напрямую
+
+    enum class Op : quint8 {
+        Const, VarI, VarN, VarBase, VarStep,                // положить на стек
+        Neg,                                                // унарный минус
+        Add, Sub, Mul, Div, Pow, Min, Max, Atan2,           // два операнда
+        Sin, Cos, Tan, Asin, Acos, Atan, Sqrt, Abs,
+        Exp, Ln, Log10, Floor, Ceil, Round                  // один операнд
+    };
+
+    struct Instr {
+        Op     op;                                          // код операции
+        double value = 0.0;                                 // константа для Op::Const
+    };
+
+    static int arity(Op op);                                // сколько снимает со стека
+    static double apply1(Op op, double a);                  // унарная операция
+    static double apply2(Op op, double a, double b);        // бинарная операция
+
+    QString        m_text;                                  // исходный текст
+    QVector<Instr> m_code;                                  // постфиксная программа
+    int            m_depth = 0;                             // максимальная глубина стека
+    QString        m_error;                                 // ошибка разбора
+    int            m_errorPos = -1;                         // позиция ошибки
+};
+
+#endif // FORMULAEXPRESSION_H
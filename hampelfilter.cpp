@@ -0,0 +1,174 @@
+#include "hampelfilter.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// k-й (с нуля) по величине элемент объединения двух возрастающих
+// последовательностей a(i), b(j) — бинарный поиск, O(log W)
+template <typename A, typename B>
+double kthOfTwo(A a, int na, B b, int nb, int k)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    int lo = std::max(0, k + 1 - nb);
+    int hi = std::min(k + 1, na);
+
+    while (lo <= hi) {
+        const int i = (lo + hi) / 2;        // берём i из a
+        const int j = k + 1 - i;            // и j из b
+
+        const double aLeft  = i > 0  ? a(i - 1) : -inf;
+        const double aRight = i < na ? a(i)     :  inf;
+        const double bLeft  = j > 0  ? b(j - 1) : -inf;
+        const double bRight = j < nb ? b(j)     :  inf;
+
+        if (aLeft > bRight)
+            hi = i - 1;
+        else if (bLeft > aRight)
+            lo = i + 1;
+        else
+            return std::max(aLeft, bLeft);
+    }
+    return 0.0;
+}
+
+} // namespace
+
+HampelFilter::HampelFilter(Filter* next, int halfWindow, double threshold, Mode mode, QObject* parent)
+    : Filter(parent)
+    , m_next(next)
+    , m_half(std::max(1, halfWindow))
+    , m_threshold(threshold)
+    , m_mode(mode)
+{
+    Q_ASSERT(m_next && "HampelFilter: next stage must not be null");
+    m_next->setParent(this);
+
+    const int w = 2 * m_half + 1;
+    m_ring.resize(w);
+    m_sorted.reserve(w);
+}
+
+void HampelFilter::clear()
+{
+    Filter::clear();
+    m_head = 0;
+    m_count = 0;
+    m_pending = 0;
+    m_sorted.clear();
+    m_out.clear();
+    m_rejected = 0;
+    m_processed = 0;
+    m_next->clear();
+}
+
+void HampelFilter::processData(const QVector<double>& values)
+{
+    // DataBuffer присылает всё окно целиком — новым всегда является последний отсчёт
+    if (values.isEmpty())
+        return;
+
+    processSamples(QVector<double>{ values.back() });
+}
+
+void HampelFilter::processSamples(const QVector<double>& samples)
+{
+    for (double x : samples)
+        push(x);
+
+    if (!m_out.isEmpty()) {
+        m_next->processSamples(m_out);
+        m_out.clear();
+    }
+}
+
+double HampelFilter::compute()
+{
+    // досчитываем хвост: у последних k отсчётов окно усечено справа
+    const int w = m_ring.size();
+    while (m_pending > 0) {
+        const int age = m_pending - 1;
+        evaluate(m_ring[(m_head + m_count - 1 - age) % w]);
+        --m_pending;
+    }
+
+    if (!m_out.isEmpty()) {
+        m_next->processSamples(m_out);
+        m_out.clear();
+    }
+    return m_next->result();
+}
+
+void HampelFilter::push(double x)
+{
+    const int w = m_ring.size();
+
+    if (m_count == w) {
+        // вытесняем самый старый отсчёт из обоих представлений окна
+        const double oldest = m_ring[m_head];
+        auto it = std::lower_bound(m_sorted.begin(), m_sorted.end(), oldest);
+        m_sorted.erase(it);
+        m_ring[m_head] = x;
+        m_head = (m_head + 1) % w;
+    } else {
+        m_ring[(m_head + m_count) % w] = x;
+        ++m_count;
+    }
+
+    m_sorted.insert(std::upper_bound(m_sorted.begin(), m_sorted.end(), x), x);
+    ++m_pending;
+
+    // отсчёт становится центром окна, когда после него пришло ещё k отсчётов
+    if (m_pending > m_half) {
+        evaluate(m_ring[(m_head + m_count - 1 - m_half) % w]);
+        --m_pending;
+    }
+}
+
+void HampelFilter::evaluate(double x)
+{
+    ++m_processed;
+
+    if (m_sorted.size() < 3) {
+        m_out.append(x);
+        return;
+    }
+
+    const double med = median();
+    const double sigma = 1.4826 * mad(med);   // MAD → σ для нормального распределения
+
+    // при нулевом MAD (квантованные одинаковые значения) выбросом ничего не считаем
+    if (sigma > 0.0 && std::fabs(x - med) > m_threshold * sigma) {
+        ++m_rejected;
+        if (m_mode == Mode::Replace)
+            m_out.append(med);
+        return;
+    }
+    m_out.append(x);
+}
+
+double HampelFilter::median() const
+{
+    const int n = m_sorted.size();
+    if (n % 2)
+        return m_sorted[n / 2];
+    return 0.5 * (m_sorted[n / 2 - 1] + m_sorted[n / 2]);
+}
+
+double HampelFilter::mad(double med) const
+{
+    // слева от медианы расстояния растут при движении влево, справа — вправо:
+    // это две возрастающие последовательности, медиана их объединения = MAD
+    const int n = m_sorted.size();
+    const int p = std::lower_bound(m_sorted.begin(), m_sorted.end(), med) - m_sorted.begin();
+    const double* s = m_sorted.constData();
+
+    auto left  = [=](int i) { return med - s[p - 1 - i]; };
+    auto right = [=](int j) { return s[p + j] - med; };
+
+    if (n % 2)
+        return kthOfTwo(left, p, right, n - p, n / 2);
+    return 0.5 * (kthOfTwo(left, p, right, n - p, n / 2 - 1)
+                + kthOfTwo(left, p, right, n - p, n / 2));
+}
@@ -0,0 +1,57 @@
+#ifndef HAMPELFILTER_H
+#define HAMPELFILTER_H
+
+#include "filter.h"
+
+// Фильтр Хампеля: скользящее окно медиана/MAD, выбросы заменяются медианой
+// или отбрасываются, очищенный поток передаётся следующему фильтру (стадии)
+class HampelFilter : public Filter
+{
+    Q_OBJECT
+
+public:
+    enum class Mode {
+        Replace,   // выброс заменяется медианой окна
+        Reject     // выброс выкидывается из потока
+    };
+
+    // next — следующая стадия (например AverageFilter), владение переходит к HampelFilter
+    explicit HampelFilter(Filter* next,
+                          int halfWindow = 5,
+                          double threshold = 3.0,
+                          Mode mode = Mode::Replace,
+                          QObject* parent = nullptr);
+
+    void clear() override;
+    void processData(const QVector<double>& values) override;
+    void processSamples(const QVector<double>& samples) override;
+
+    int rejectedCount() const { return m_rejected; }   // сколько выбросов найдено с последнего clear
+    int processedCount() const { return m_processed; } // сколько отсчётов проверено
+
+protected:
+    double compute() override;
+
+private:
+    void push(double x);                  // новый отсчёт в окно
+    void evaluate(double x);              // проверка отсчёта и передача дальше
+    double median() const;                // медиана окна
+    double mad(double med) const;         // медиана |x - med| окна
+
+    Filter* m_next = nullptr;
+    int m_half = 5;                       // k: окно W = 2k + 1
+    double m_threshold = 3.0;             // порог в единицах σ ≈ 1.4826·MAD
+    Mode m_mode = Mode::Replace;
+
+    QVector<double> m_ring;               // отсчёты окна в порядке поступления
+    int m_head = 0;                       // индекс самого старого отсчёта в кольце
+    int m_count = 0;                      // заполненность кольца
+    int m_pending = 0;                    // сколько последних отсчётов ещё не проверено
+    QVector<double> m_sorted;             // то же окно, отсортированное
+
+    QVector<double> m_out;                // очищенные отсчёты для следующей стадии
+    int m_rejected = 0;
+    int m_processed = 0;
+};
+
+#endif // HAMPELFILTER_H
@@ -6,16 +6,43 @@
 #include "stepconfigdialog.h"
 #include "autoconfigdialog.h"
 #include "nonefilter.h"
+#include "hampelfilter.h"
+#include "changegatefilter.h"
+#include "sessionrefilter.h"
+#include "sessionfile.h"
+#include "cycleplanner.h"
 
 #include "accuracy/accuracywindow.h"
+#include "accuracy/accuracyengine.h"
 
 #include <QLabel>
 #include <QSpinBox>
+#include <QDoubleSpinBox>
 #include <QHBoxLayout>
 #include <QWidgetAction>
+#include <QInputDialog>
+#include <QElapsedTimer>
+#include <QStandardPaths>
+#include <QDir>
+#include <QDateTime>
+#include <QDialog>
+#include <QVBoxLayout>
+#include <QFormLayout>
+#include <QCheckBox>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QDialogButtonBox>
+#include <QtCharts/QChartView>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QScatterSeries>
+#include <QtCharts/QValueAxis>
 
 #include <QDebug>
 #include <QTimer>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <cmath>
+#include <memory>
 
 
 
@@ -31,6 +58,11 @@ MainWindow::MainWindow(QWidget *parent)
     appState   = new AppState(this);
     pyProc     = new PyProc(this);
     buffer     = new DataBuffer(this, 10);
+    envCompensator = new EnvironmentCompensator(this);
+    envSource  = new EnvironmentSource(this);
+    decimator  = new Decimator(1, 8, this);
+    lowpass    = new BiquadLowpass(1.0, 0.0, 4, this);
+    smoothBuffer = new DataBuffer(this, 10);
     settingsManager = new SettingsManager(this);
     dataMeasurement = new DataMeasurement();
     autoSaver = new AutoMeasurement(buffer, dataMeasurement, this);
@@ -38,6 +70,8 @@ MainWindow::MainWindow(QWidget *parent)
 
     // Добавляем GUI элементы, зависящие от settingsManager
     addTimeSetting();
+    addDecimationSetting();
+    addSmoothingSetting();
 
     // при старте восстанавливаем состояние из settingsManager
     ui->actionBidirectional->setChecked(settingsManager->stepSettings().bidirectional);
@@ -52,17 +86,29 @@ MainWindow::MainWindow(QWidget *parent)
     settingsManager->registerFilter("Без фильтра", ui->actionNoneFilter, []() {
         return new NoneFilter();
     });
+    settingsManager->registerFilter("Фильтр Хампеля + среднее арифметическое", ui->actionHampelAverageFilter, []() {
+        return new HampelFilter(new AverageFilter());
+    });
+    settingsManager->registerFilter("Фильтр Хампеля + интерквартильный фильтр", ui->actionHampelExpectationFilter, []() {
+        return new HampelFilter(new ExpectationFilter());
+    });
+    settingsManager->registerFilter("Отсечение до последнего скачка + среднее арифметическое", ui->actionChangeGateFilter, []() {
+        return new ChangeGateFilter(new AverageFilter());
+    });
 
     // Создаём фильтр по умолчанию
     filter = settingsManager->createInitialFilter(this);
 
-    // Подключаем реакцию на смену фильтра
+    // Подключаем реакцию на смену фильтра: меняется только его подписка,
+    // запись сырого окна (onSaveSample) остаётся как была
     connect(settingsManager, &SettingsManager::filterChanged, this, [=](Filter* newFilter) {
         if (filter) {
             disconnect(buffer, &DataBuffer::updated, filter, &Filter::processData);
             delete filter;
         }
         filter = newFilter;
+        if (filter && appState->state() == ProgramState::Saving) // смена посреди сохранения — новый фильтр дослушивает окно
+            connect(buffer, &DataBuffer::updated, filter, &Filter::processData, Qt::UniqueConnection);
     });
 
     // Передаём все виджеты визуализатору
@@ -82,9 +128,23 @@ MainWindow::MainWindow(QWidget *parent)
     // Подключаем все сигналы/слоты (не относятся к настройкам)
     connect(appState, &AppState::stateChanged, this, &MainWindow::onAppStateChanged);
 
-    connect(pyProc, &PyProc::distance, buffer, &DataBuffer::append);
+    // источник → компенсация среды → дециматор → буфер: все потребители буфера работают
+    // на прореженной частоте и видят уже приведённые к 20 °C и к воздуху показания
+    connect(pyProc, &PyProc::distance, envCompensator, &EnvironmentCompensator::push);
+    connect(envCompensator, &EnvironmentCompensator::sampleReady, decimator, &Decimator::push);
+    connect(envSource, &EnvironmentSource::sample, envCompensator, &EnvironmentCompensator::setEnvironment);
+    connect(envSource, &EnvironmentSource::sample, this, &MainWindow::onEnvironmentSample);
+    connect(envSource, &EnvironmentSource::error, this, [=](const QString& msg) {
+        ui->statusbar->showMessage(msg);
+    });
+    envCompensator->setSettings(settingsManager->environmentSettings());
+    connect(decimator, &Decimator::sampleReady, buffer, &DataBuffer::append);
+
+    // параллельная ветка: дециматор → ФНЧ → сглаженный буфер (фильтры сохранения остаются на сыром)
+    connect(decimator, &Decimator::sampleReady, lowpass, &BiquadLowpass::push);
+    connect(lowpass, &BiquadLowpass::sampleReady, smoothBuffer, &DataBuffer::append);
 
-    connect(buffer, &DataBuffer::updated, visualizer, &DataVisualizer::onBufferUpdated);
+    applySmoothing(settingsManager->smoothingCutoff());
 
     //Отображение значения только после Save, переход из состояния в Save в другое
     connect(visualizer, &DataVisualizer::saveTimeout, this, &MainWindow::onValueReady);
@@ -190,10 +250,61 @@ MainWindow::MainWindow(QWidget *parent)
         }
     });
 
+    // Журнал сессии: предлагаем восстановить прошлую сессию, затем пишем дальше
+    const QString journalDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(journalDir);
+    journal = new SessionJournal(journalDir + "/session.cbj", this);
+    restoreSession();
+    if (!journal->open())
+        ui->statusbar->showMessage("Не удалось открыть журнал сессии: " + journal->path());
+    QString dbError;
+    if (!historyDb.open(journalDir + "/history.sqlite", &dbError))
+        ui->statusbar->showMessage("Не удалось открыть базу истории: " + dbError);
+
     // Изначально — состояние Idle
     appState->setState(ProgramState::Idle);
 }
 
+// Восстановление сессии из журнала после аварийного завершения
+void MainWindow::restoreSession()
+{
+    if (!journal->hasRecords())
+        return;
+
+    QElapsedTimer timer;
+    timer.start();
+    DataMeasurement restored;
+    const auto res = journal->replay(restored);
+    const qint64 ms = timer.elapsed();
+
+    const MeasurementColumns& cols = restored.columns();
+    if (cols.rowCount() == 0) {          // в журнале только настройки — восстанавливать нечего
+        journal->reset();
+        return;
+    }
+
+    const QString dropped = res.error.isEmpty() ? QString(" (повреждённый конец журнала отброшен)")
+                                                : QString(" (конец журнала отброшен: %1)").arg(res.error);
+    const QString text = QString("Найден журнал незавершённой сессии: %1 измерений в %2 группах%3.\n"
+                                 "Восстановить сессию?")
+                             .arg(cols.rowCount())
+                             .arg(cols.groupCount())
+                             .arg(res.tailDropped ? dropped : QString());
+    if (QMessageBox::question(this, "Восстановление сессии", text) != QMessageBox::Yes) {
+        journal->reset();
+        return;
+    }
+
+    *dataMeasurement = restored;
+    // настройки шагов — из журнала, иначе переход в Idle поставит прежние и пересчитает всё от чужой базы
+    settingsManager->setStepSettings(restored.stepSettings());
+    ui->actionBidirectional->setChecked(restored.stepSettings().bidirectional);
+    visualizer->addSavedValue(dataMeasurement->columns());
+    ui->statusbar->showMessage(QString("Сессия восстановлена: %1 записей журнала за %2 мс")
+                                   .arg(res.records)
+                                   .arg(ms));
+}
+
 MainWindow::~MainWindow()
 {
     delete ui;
@@ -206,16 +317,21 @@ void MainWindow::onAppStateChanged(ProgramState state)
     case ProgramState::Idle: {
         visualizer->setIdleView();
         buffer->clear();
+        smoothBuffer->clear();
+        lowpass->reset();
         if (autoSaver && autoSaver->isRunning()) autoSaver->stop();
         // Установка актуальных настроек шагов
         StepSettings settings = settingsManager->stepSettings();
         dataMeasurement->setStepSettings(settings);
+        journal->recordStepSettings(settings);
         break;
     }
 
     case ProgramState::Measuring: {
-        if (!pyProc->isRunning())
+        if (!pyProc->isRunning()) {
+            decimator->reset();
             pyProc->start("C:/MY/HMIv2/scripts/parser_loop.py");
+        }
         visualizer->setMeasuringView();
         if (autoSaver && autoSaver->isRunning()) autoSaver->stop();
         break;
@@ -224,8 +340,11 @@ void MainWindow::onAppStateChanged(ProgramState state)
     case ProgramState::Stopped: {
         pyProc->stop();              // остановить скрипт
         buffer->clear();             // очистить буфер онлайн-графика
+        smoothBuffer->clear();       // и сглаженный буфер
         visualizer->clearAll();      // очистить графики и таблицы
+        pushUndo();                  // очистку можно отменить
         dataMeasurement->clear();    // очищаем все измерения
+        journal->recordClear();      // и журнал сессии
         visualizer->setIdleView();   // сброс визуала
         if (autoSaver && autoSaver->isRunning()) autoSaver->stop(); // сброс autoSaver
         appState->setState(ProgramState::Idle);  // возвращаемся в Idle
@@ -235,8 +354,12 @@ void MainWindow::onAppStateChanged(ProgramState state)
 
     case ProgramState::Saving: {
         buffer->clear(); // очищаем буфер перед началом записи новых данных
+        saveWindow.clear();
         connect(buffer, &DataBuffer::updated, filter, &Filter::processData, Qt::UniqueConnection); //начата передача данных из буфера в фильтр
-        visualizer->setSaveView(settingsManager->saveTime());         // показывает окно с обратным отсчётом
+        connect(buffer, &DataBuffer::updated, this, &MainWindow::onSaveSample, Qt::UniqueConnection); //и запись сырого окна
+        const double dwell = autoSaver->isRunning() ? autoSaver->currentDwell() : 0.0; // выдержка из плана цикла
+        visualizer->setSaveView(dwell > 0.0 ? std::max(1, int(std::ceil(dwell)))
+                                            : settingsManager->saveTime()); // показывает окно с обратным отсчётом
         break;
     }
 
@@ -257,9 +380,10 @@ void MainWindow::onAppStateChanged(ProgramState state)
             // 3) Сохраняем в SettingsManager
             settingsManager->setStepSettings(dlg.currentSettings());
             dataMeasurement->setStepSettings(settingsManager->stepSettings());
+            journal->recordStepSettings(settingsManager->stepSettings());
 
-            // Перестраиваем визуализацию под новые настройки
-            visualizer->addSavedValue(dataMeasurement->groups());
+            // Перестраиваем визуализацию под новые настройки (пересчёт от новой базы — в пуле)
+            refreshSavedView();
         }
 
         // 3) Возвращаемся в предыдущие состояние
@@ -305,7 +429,13 @@ void MainWindow::onAppStateChanged(ProgramState state)
         if (!autoSaver->isRunning()) {
             const StepSettings step = settingsManager->stepSettings();
             const AutoSaveSettings as = settingsManager->autoSaveSettings();
-            const AutoSavePlan plan = autoSaver->createPlan(step, as, dataMeasurement);
+            if (hasPendingPlan) {                    // план цикла нумерует шаги с 1 — в новой группе
+                dataMeasurement->requestNewGroup();
+                journal->recordNewGroup();
+            }
+            const AutoSavePlan plan = hasPendingPlan ? pendingPlan                // план цикла ISO 230-2
+                                                     : autoSaver->createPlan(step, as, dataMeasurement);
+            hasPendingPlan = false;
             autoSaver->start(plan);
         }
 
@@ -316,7 +446,7 @@ void MainWindow::onAppStateChanged(ProgramState state)
         double base = settingsManager->stepSettings().base;
         auto* accuracyWindow = new AccuracyWindow(this);
         accuracyWindow->setAttribute(Qt::WA_DeleteOnClose);  // автоудаление при закрытии
-        accuracyWindow->setMeasurementData(*dataMeasurement, base);
+        accuracyWindow->setMeasurementData(dataMeasurement->snapshot(), base);
         accuracyWindow->show();
 
         appState->setState(ProgramState::Paused);
@@ -334,12 +464,14 @@ void MainWindow::onAppStateChanged(ProgramState state)
 void MainWindow::onValueReady()
 {
     disconnect(buffer, &DataBuffer::updated, filter, &Filter::processData);
+    disconnect(buffer, &DataBuffer::updated, this, &MainWindow::onSaveSample);
 
     // Если фильтр не получил ни одного значения — значит за время измерения не было данных
     if (buffer->size() == 0) {
         QMessageBox::warning(this, "Нет данных",
                              "За время измерения не было получено новых значений.");
         filter->clear();
+        saveWindow.clear();
         const auto prev = appState->previousState();
         appState->setState(prev == ProgramState::AutoMeasuring
                                ? ProgramState::AutoMeasuring
@@ -348,9 +480,26 @@ void MainWindow::onValueReady()
     }
 
     const double value = filter->result();
-    dataMeasurement->add(value);
+
+    // Фильтр Хампеля сообщает, сколько выбросов он убрал из окна сохранения
+    if (auto* hampel = qobject_cast<HampelFilter*>(filter)) {
+        ui->statusbar->showMessage(QString("Фильтр Хампеля: выбросов %1 из %2")
+                                       .arg(hampel->rejectedCount())
+                                       .arg(hampel->processedCount()));
+    }
+    if (auto* gate = qobject_cast<ChangeGateFilter*>(filter)) {
+        ui->statusbar->showMessage(QString("Отсечение по скачку: отброшено %1, в расчёте %2")
+                                       .arg(gate->droppedCount())
+                                       .arg(gate->keptCount()));
+    }
+
+    pushUndo();
+    const qint64 savedAt = QDateTime::currentMSecsSinceEpoch();    // время нужно модели дрейфа
+    dataMeasurement->add(value, saveWindow, savedAt);
+    journal->recordAdd(value, saveWindow, savedAt);
+    saveWindow.clear();
     filter->clear();
-    visualizer->addSavedValue(dataMeasurement->groups());
+    visualizer->addSavedValue(dataMeasurement->columns());
 
     // Возвращаемся в исходное рабочее состояние
     if (appState->previousState() == ProgramState::AutoMeasuring && autoSaver->isRunning()) {
@@ -373,6 +522,553 @@ void MainWindow::on_actionSave_triggered()
     fileManager->exportToCsv(this, visualizer->savedModel());
 }
 
+// Сырое окно сохранения: DataBuffer присылает всё окно, новый отсчёт — последний
+void MainWindow::onSaveSample(const QVector<double>& values)
+{
+    if (!values.isEmpty())
+        saveWindow.append(values.back());
+}
+
+// Офлайн-пересчёт всей сессии другим фильтром по сохранённым сырым окнам
+void MainWindow::on_actionRefilter_triggered()
+{
+    const auto st = appState->state();
+    if (st == ProgramState::Saving || st == ProgramState::AutoMeasuring) {
+        QMessageBox::warning(this, "Ошибка", "Дождитесь окончания сохранения или остановите авто-режим.");
+        return;
+    }
+    if (dataMeasurement->rawRecords().size() == 0) {
+        QMessageBox::warning(this, "Нет данных", "В сессии нет сохранённых сырых окон для пересчёта.");
+        return;
+    }
+
+    bool ok = false;
+    const QString name = QInputDialog::getItem(this, "Пересчёт сессии", "Фильтр:",
+                                               settingsManager->filterNames(), 0, false, &ok);
+    if (!ok || name.isEmpty())
+        return;
+
+    QElapsedTimer timer;
+    timer.start();
+    const QVector<double> values = SessionRefilter::run(dataMeasurement->rawRecords(),
+                                                        settingsManager->filterFactory(name),
+                                                        buffer->capacity());
+    pushUndo();
+    dataMeasurement->reevaluateRaw(values);
+    journal->recordReevaluate(values);
+    visualizer->addSavedValue(dataMeasurement->columns());
+
+    ui->statusbar->showMessage(QString("Сессия пересчитана фильтром «%1»: %2 окон за %3 мс")
+                                   .arg(name)
+                                   .arg(values.size())
+                                   .arg(timer.elapsed()));
+
+    // сразу показываем результаты точности по пересчитанным данным
+    appState->setState(ProgramState::Processing);
+}
+
+// Сохранение сессии в файл .cbx (настройки, колонки измерений, по желанию — сырые окна)
+void MainWindow::on_actionSaveSession_triggered()
+{
+    if (appState->state() == ProgramState::Saving) {
+        QMessageBox::warning(this, "Ошибка", "Дождитесь окончания сохранения точки.");
+        return;
+    }
+
+    const QString path = QFileDialog::getSaveFileName(this, "Сохранить сессию", "", "Сессия Calibrix (*.cbx)");
+    if (path.isEmpty())
+        return;
+
+    bool withRaw = false;
+    const RawRecordStore& raw = dataMeasurement->rawRecords();
+    if (raw.size() > 0) {
+        withRaw = QMessageBox::question(this, "Сохранение сессии",
+                                        QString("Сохранить сырые окна (%1 шт., %2 КБ) для пересчёта другим фильтром?")
+                                            .arg(raw.size())
+                                            .arg(raw.compressedBytes() / 1024))
+                  == QMessageBox::Yes;
+    }
+
+    QString error;
+    if (!SessionFile::save(path, *dataMeasurement, settingsManager->autoSaveSettings(), withRaw, &error)) {
+        QMessageBox::warning(this, "Ошибка", "Не удалось сохранить сессию: " + error);
+        return;
+    }
+    ui->statusbar->showMessage("Сессия сохранена: " + path);
+}
+
+// Открытие сессии .cbx: файл отображается в память, сырые окна читаются по мере надобности
+void MainWindow::on_actionOpenSession_triggered()
+{
+    const auto st = appState->state();
+    if (st == ProgramState::Saving || st == ProgramState::AutoMeasuring) {
+        QMessageBox::warning(this, "Ошибка", "Дождитесь окончания сохранения или остановите авто-режим.");
+        return;
+    }
+
+    const QString path = QFileDialog::getOpenFileName(this, "Открыть сессию", "", "Сессия Calibrix (*.cbx)");
+    if (path.isEmpty())
+        return;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    SessionFile file;
+    QString error;
+    if (!file.open(path, &error)) {
+        QMessageBox::warning(this, "Ошибка", "Не удалось открыть сессию: " + error);
+        return;
+    }
+    pushUndo();
+    if (!file.load(*dataMeasurement, &error)) {
+        QMessageBox::warning(this, "Ошибка", "Файл сессии повреждён: " + error);
+        return;
+    }
+
+    settingsManager->setStepSettings(file.stepSettings());
+    settingsManager->setAutoSaveSettings(file.autoSaveSettings());
+    ui->actionBidirectional->setChecked(file.stepSettings().bidirectional);
+    visualizer->addSavedValue(dataMeasurement->columns());
+
+    // журнал начинаем с открытой сессии: полное состояние, включая сырые окна
+    journal->reset();
+    journal->recordState(*dataMeasurement);
+
+    ui->statusbar->showMessage(QString("Сессия открыта: %1 измерений, %2 сырых окон за %3 мс")
+                                   .arg(dataMeasurement->columns().rowCount())
+                                   .arg(dataMeasurement->rawRecords().size())
+                                   .arg(timer.elapsed()));
+}
+
+// Запись текущей сессии с результатами ISO 230-2 в базу истории
+void MainWindow::on_actionSaveToHistory_triggered()
+{
+    if (!historyDb.isOpen()) {
+        QMessageBox::warning(this, "Ошибка", "База истории недоступна.");
+        return;
+    }
+    const MeasurementSnapshot snapshot = dataMeasurement->snapshot();
+    if (snapshot.isEmpty()) {
+        QMessageBox::warning(this, "Нет данных", "В сессии нет измерений.");
+        return;
+    }
+
+    bool ok = false;
+    SessionDatabase::SessionInfo info;
+    info.machine = QInputDialog::getItem(this, "История калибровок", "Станок:",
+                                         historyDb.machines(), 0, true, &ok);
+    if (!ok || info.machine.trimmed().isEmpty())
+        return;
+    info.axis = QInputDialog::getItem(this, "История калибровок", "Ось:",
+                                      historyDb.axes(info.machine), 0, true, &ok);
+    if (!ok || info.axis.trimmed().isEmpty())
+        return;
+    info.note = QInputDialog::getText(this, "История калибровок", "Примечание:", QLineEdit::Normal, "", &ok);
+    if (!ok)
+        return;
+
+    QElapsedTimer timer;
+    timer.start();
+    const AccuracyResultList results = AccuracyEngine::compute(snapshot);
+    QString error;
+    if (historyDb.saveSession(info, snapshot, results, &error) < 0) {
+        QMessageBox::warning(this, "Ошибка", "Не удалось записать сессию: " + error);
+        return;
+    }
+    ui->statusbar->showMessage(QString("Сессия записана в историю: %1 измерений за %2 мс")
+                                   .arg(snapshot.rowCount())
+                                   .arg(timer.elapsed()));
+}
+
+// История итогов ISO 230-2 по оси станка
+void MainWindow::on_actionHistory_triggered()
+{
+    if (!historyDb.isOpen()) {
+        QMessageBox::warning(this, "Ошибка", "База истории недоступна.");
+        return;
+    }
+
+    bool ok = false;
+    const QString machine = QInputDialog::getItem(this, "История точности", "Станок:",
+                                                  historyDb.machines(), 0, false, &ok);
+    if (!ok || machine.isEmpty())
+        return;
+    const QString axis = QInputDialog::getItem(this, "История точности", "Ось:",
+                                               historyDb.axes(machine), 0, false, &ok);
+    if (!ok || axis.isEmpty())
+        return;
+    const int years = QInputDialog::getInt(this, "История точности", "За сколько лет:", 3, 1, 50, 1, &ok);
+    if (!ok)
+        return;
+
+    const QDateTime to = QDateTime::currentDateTime();
+    QString error;
+    const auto points = historyDb.history(machine, axis, to.addYears(-years), to, &error);
+    if (!error.isEmpty()) {
+        QMessageBox::warning(this, "Ошибка", "Не удалось прочитать историю: " + error);
+        return;
+    }
+
+    QString text = QString("Станок %1, ось %2: %3 сессий\n\n").arg(machine, axis).arg(points.size());
+    for (const auto& p : points) {
+        text += QString("%1   A = %2   M = %3   B = %4   R = %5\n")
+                    .arg(p.startedAt.toString("dd.MM.yyyy"))
+                    .arg(p.positioningAccuracy, 0, 'f', 4)
+                    .arg(p.meanRange, 0, 'f', 4)
+                    .arg(p.systematicError, 0, 'f', 4)
+                    .arg(p.repeatability, 0, 'f', 4);
+    }
+    QMessageBox::information(this, "История точности", text);
+}
+
+// Цикл ISO 230-2: оптимальный план по шуму потока и динамике оси, экспорт в G-code
+void MainWindow::on_actionCyclePlan_triggered()
+{
+    const StepSettings steps = settingsManager->stepSettings();
+    CycleSettings cs = settingsManager->cycleSettings();
+    const double sigma = CyclePlanner::noiseFloor(buffer->values());  // шум по последним отсчётам потока
+    const double rate = lowpass->sampleRate();                         // частота после прореживания
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("Цикл ISO 230-2");
+    auto* form = new QFormLayout(&dialog);
+
+    auto spin = [&dialog](double min, double max, int decimals, double value) {
+        auto* sb = new QDoubleSpinBox(&dialog);
+        sb->setRange(min, max);
+        sb->setDecimals(decimals);
+        sb->setValue(value);
+        return sb;
+    };
+    auto* cycles = new QSpinBox(&dialog);
+    cycles->setRange(CyclePlanner::kIsoMinCycles, 100);
+    cycles->setValue(std::max(CyclePlanner::kIsoMinCycles, cs.cycles));
+    auto* feed      = spin(1.0, 1e6, 1, cs.feedRate);
+    auto* rapid     = spin(1.0, 1e6, 1, cs.rapidRate);
+    auto* accel     = spin(0.0, 1e5, 1, cs.acceleration);
+    auto* overshoot = spin(0.0, 1e4, 3, cs.overshoot);
+    auto* settle    = spin(0.0, 600.0, 2, cs.settleTime);
+    auto* target    = spin(0.0, 1.0, 6, cs.targetSigma);
+    auto* origin    = spin(-1e9, 1e9, 4, cs.machineOrigin);
+    auto* axis      = new QLineEdit(cs.axis, &dialog);
+    auto* dwellWord = new QComboBox(&dialog);
+    dwellWord->addItem("G4 P — целые мс (Fanuc)", int(DwellWord::MillisecondsP));
+    dwellWord->addItem("G4 X — секунды", int(DwellWord::SecondsX));
+    dwellWord->setCurrentIndex(dwellWord->findData(int(cs.dwellWord)));
+    form->addRow("Циклов:", cycles);
+    form->addRow("Подача подхода, ед./мин:", feed);
+    form->addRow("Ускоренный ход, ед./мин:", rapid);
+    form->addRow("Ускорение, ед./с²:", accel);
+    form->addRow("Перебег при развороте:", overshoot);
+    form->addRow("Успокоение, с:", settle);
+    form->addRow("СКО среднего в точке:", target);
+    form->addRow("Координата базы на станке:", origin);
+    form->addRow("Ось:", axis);
+    form->addRow("Выдержка в программе:", dwellWord);
+
+    auto* summary = new QLabel(&dialog);
+    summary->setWordWrap(true);
+    form->addRow(summary);
+
+    CyclePlan plan;
+    auto rebuild = [&]() {
+        cs.cycles = cycles->value();
+        cs.feedRate = feed->value();
+        cs.rapidRate = rapid->value();
+        cs.acceleration = accel->value();
+        cs.overshoot = overshoot->value();
+        cs.settleTime = settle->value();
+        cs.targetSigma = target->value();
+        cs.machineOrigin = origin->value();
+        cs.axis = axis->text();
+        cs.dwellWord = DwellWord(dwellWord->currentData().toInt());
+        plan = CyclePlanner::optimize(steps, cs, sigma, rate, settingsManager->saveTime());
+        if (!plan.isValid()) {
+            summary->setText(plan.error);
+            return;
+        }
+        const int sec = int(std::ceil(plan.totalTime()));
+        summary->setText(QString("Шум потока σ = %1 (%2 Гц) → выдержка %3 с на запись.
+"
+                                 "%4 точек × %5 циклов, %6 записей. Время цикла ≈ %7 мин %8 с "
+                                 "(переезды %9 с, остановки %10 с).")
+                             .arg(sigma, 0, 'g', 3).arg(rate, 0, 'f', 1)
+                             .arg(plan.dwellSec, 0, 'f', 2)
+                             .arg(plan.targets).arg(plan.cycles).arg(plan.measurements())
+                             .arg(sec / 60).arg(sec % 60)
+                             .arg(plan.travelTime, 0, 'f', 0).arg(plan.stopTime, 0, 'f', 0));
+    };
+    for (auto* sb : { feed, rapid, accel, overshoot, settle, target, origin })
+        connect(sb, QOverload<double>::of(&QDoubleSpinBox::valueChanged), &dialog, rebuild);
+    connect(cycles, QOverload<int>::of(&QSpinBox::valueChanged), &dialog, rebuild);
+    connect(axis, &QLineEdit::textChanged, &dialog, rebuild);
+    connect(dwellWord, QOverload<int>::of(&QComboBox::currentIndexChanged), &dialog, rebuild);
+    rebuild();
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Close, &dialog);
+    auto* exportButton = buttons->addButton("Экспорт G-code...", QDialogButtonBox::ActionRole);
+    auto* runButton = buttons->addButton("Запустить автомат", QDialogButtonBox::AcceptRole);
+    form->addRow(buttons);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    connect(runButton, &QPushButton::clicked, &dialog, &QDialog::accept);
+    connect(exportButton, &QPushButton::clicked, &dialog, [&]() {
+        if (!plan.isValid())
+            return;
+        const QString path = QFileDialog::getSaveFileName(&dialog, "Экспорт цикла в G-code",
+                                                          QString("iso230_%1.nc").arg(cs.axis.trimmed()),
+                                                          "G-code (*.nc *.ngc *.gcode)");
+        if (path.isEmpty())
+            return;
+        QFile f(path);
+        if (!f.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QMessageBox::warning(&dialog, "Ошибка", "Не удалось записать файл: " + f.errorString());
+            return;
+        }
+        f.write(CyclePlanner::toGCode(plan, cs).toUtf8());
+        ui->statusbar->showMessage("Программа цикла сохранена: " + path);
+    });
+
+    const int result = dialog.exec();
+    settingsManager->setCycleSettings(cs);
+    if (result != QDialog::Accepted || !plan.isValid())
+        return;
+
+    // автомат исполнит план цикла вместо обычного: зоны — точки измерения, выдержка — из плана
+    AutoPlanConfig cfg = autoSaver->createPlan(steps, settingsManager->autoSaveSettings(), dataMeasurement).cfg;
+    pendingPlan = CyclePlanner::toAutoSavePlan(plan, cfg);
+    hasPendingPlan = true;
+    if (appState->state() == ProgramState::Measuring)
+        appState->setState(ProgramState::AutoMeasuring);
+    else
+        ui->statusbar->showMessage("План цикла готов — запустится при переходе в авто-режим");
+}
+
+// Параметры компенсации среды: источник отсчётов, лазер и материал
+void MainWindow::on_actionEnvironment_triggered()
+{
+    EnvironmentSettings es = settingsManager->environmentSettings();
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("Компенсация среды");
+    auto* form = new QFormLayout(&dialog);
+
+    auto* enabled = new QCheckBox("Применять поправки к показаниям", &dialog);
+    enabled->setChecked(es.enabled);
+    form->addRow(enabled);
+
+    auto* pathEdit = new QLineEdit(es.sourcePath, &dialog);
+    auto* browse = new QPushButton("...", &dialog);
+    auto* pathRow = new QHBoxLayout();
+    pathRow->addWidget(pathEdit);
+    pathRow->addWidget(browse);
+    form->addRow("Файл условий среды:", pathRow);
+    connect(browse, &QPushButton::clicked, &dialog, [&]() {
+        const QString p = QFileDialog::getOpenFileName(&dialog, "Файл условий среды", pathEdit->text());
+        if (!p.isEmpty())
+            pathEdit->setText(p);
+    });
+
+    auto spin = [&dialog](double min, double max, int decimals, double value) {
+        auto* sb = new QDoubleSpinBox(&dialog);
+        sb->setRange(min, max);
+        sb->setDecimals(decimals);
+        sb->setValue(value);
+        return sb;
+    };
+    auto* wavelength = spin(200.0, 2000.0, 4, es.wavelengthNm);
+    auto* index      = spin(0.9, 1.1, 8, es.instrumentIndex);
+    auto* alpha      = spin(-50.0, 100.0, 3, es.expansionCoeff * 1e6);
+    auto* origin     = spin(-1e9, 1e9, 4, es.expansionOrigin);
+    form->addRow("Длина волны в вакууме, нм:", wavelength);
+    form->addRow("n, заложенный в показания:", index);
+    form->addRow("ТКЛР материала, 10⁻⁶/К:", alpha);
+    form->addRow("Неподвижная точка расширения:", origin);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog);
+    form->addRow(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    if (dialog.exec() != QDialog::Accepted)
+        return;
+
+    es.enabled = enabled->isChecked();
+    es.sourcePath = pathEdit->text().trimmed();
+    es.wavelengthNm = wavelength->value();
+    es.instrumentIndex = index->value();
+    es.expansionCoeff = alpha->value() * 1e-6;
+    es.expansionOrigin = origin->value();
+    settingsManager->setEnvironmentSettings(es);
+    envCompensator->setSettings(es);
+
+    if (es.enabled && !es.sourcePath.isEmpty())
+        envSource->start(es.sourcePath);
+    else
+        envSource->stop();
+    if (es.enabled && es.sourcePath.isEmpty())
+        ui->statusbar->showMessage("Компенсация среды: не задан файл условий — поправки не применяются");
+}
+
+// Новый отсчёт среды: коэффициенты уже пересчитаны компенсатором
+void MainWindow::onEnvironmentSample(const EnvironmentSample& sample)
+{
+    if (!envCompensator->settings().enabled)
+        return;
+    ui->statusbar->showMessage(QString("Среда: %1 °C, %2 Па, %3 %, деталь %4 °C — n = %5, поправка %6 ppm")
+                                   .arg(sample.airTemp, 0, 'f', 2)
+                                   .arg(sample.pressure, 0, 'f', 0)
+                                   .arg(sample.humidity, 0, 'f', 0)
+                                   .arg(sample.materialTemp, 0, 'f', 2)
+                                   .arg(envCompensator->airIndex(), 0, 'f', 8)
+                                   .arg((envCompensator->scale() - 1.0) * 1e6, 0, 'f', 2));
+}
+
+// Компенсация дрейфа по возвратам в опорную позицию: погрешности пересчитываются при чтении
+void MainWindow::on_actionDriftCompensation_toggled(bool on)
+{
+    dataMeasurement->setDriftCompensation(on);
+    visualizer->addSavedValue(dataMeasurement->columns());
+    const int knots = dataMeasurement->driftModel().knotCount();
+    ui->statusbar->showMessage(on ? QString("Компенсация дрейфа включена: возвратов в опорную позицию %1").arg(knots)
+                                  : QString("Компенсация дрейфа выключена"));
+}
+
+// Кривая дрейфа: по линии на группу — узлы-возвраты и линейная интерполяция
+void MainWindow::on_actionDriftCurve_triggered()
+{
+    const DriftModel& model = dataMeasurement->driftModel();
+    const QList<int> groups = model.groups();
+    qint64 t0 = 0;                                                 // первый возврат среди всех групп
+    bool enough = false;
+    for (int g : groups) {
+        const QVector<DriftModel::Knot> knots = model.knots(g);
+        if (t0 == 0 || knots.first().timeMs < t0) t0 = knots.first().timeMs;
+        enough = enough || knots.size() >= 2;
+    }
+    if (!enough) {
+        QMessageBox::information(this, "Кривая дрейфа",
+                                 "Для кривой нужно хотя бы два возврата в опорную позицию одной группы (шаг её первой серии).");
+        return;
+    }
+
+    auto* chart = new QChart();
+    auto* axisX = new QValueAxis();
+    auto* axisY = new QValueAxis();
+    axisX->setTitleText("Время, мин");
+    axisY->setTitleText("Дрейф");
+    chart->addAxis(axisX, Qt::AlignBottom);
+    chart->addAxis(axisY, Qt::AlignLeft);
+    for (int g : groups) {                                         // у каждой группы свой нуль
+        auto* line   = new QLineSeries();
+        auto* points = new QScatterSeries();
+        line->setName(QString("Дрейф, группа %1").arg(g + 1));
+        points->setName(QString("Возвраты, группа %1").arg(g + 1));
+        points->setMarkerSize(8.0);
+        for (const auto& k : model.knots(g)) {
+            const double minutes = double(k.timeMs - t0) / 60000.0; // ось X — минуты от первого возврата
+            line->append(minutes, k.drift);
+            points->append(minutes, k.drift);
+        }
+        for (auto* series : { static_cast<QXYSeries*>(line), static_cast<QXYSeries*>(points) }) {
+            chart->addSeries(series);
+            series->attachAxis(axisX);
+            series->attachAxis(axisY);
+        }
+    }
+    chart->setTitle(dataMeasurement->driftCompensation() ? "Кривая дрейфа (вычитается из погрешностей)"
+                                                         : "Кривая дрейфа (компенсация выключена)");
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("Кривая дрейфа");
+    dialog.resize(720, 420);
+    auto* layout = new QVBoxLayout(&dialog);
+    auto* view = new QChartView(chart);                            // вид владеет графиком
+    view->setRenderHint(QPainter::Antialiasing);
+    layout->addWidget(view);
+    dialog.exec();
+}
+
+// Снимок перед изменением измерений; новая ветка изменений сбрасывает повтор
+void MainWindow::pushUndo()
+{
+    const int kMaxUndo = 100;    // снимки делят неизменённые группы, но сырые окна держат
+    undoStack.append(dataMeasurement->snapshot());
+    if (undoStack.size() > kMaxUndo)
+        undoStack.removeFirst();
+    redoStack.clear();
+    updateUndoActions();
+}
+
+void MainWindow::on_actionUndo_triggered()
+{
+    const auto st = appState->state();
+    if (undoStack.isEmpty() || st == ProgramState::Saving || st == ProgramState::AutoMeasuring)
+        return;
+
+    redoStack.append(dataMeasurement->snapshot());
+    applySnapshot(undoStack.takeLast());
+    ui->statusbar->showMessage("Изменение отменено");
+}
+
+void MainWindow::on_actionRedo_triggered()
+{
+    const auto st = appState->state();
+    if (redoStack.isEmpty() || st == ProgramState::Saving || st == ProgramState::AutoMeasuring)
+        return;
+
+    undoStack.append(dataMeasurement->snapshot());
+    applySnapshot(redoStack.takeLast());
+    ui->statusbar->showMessage("Изменение повторено");
+}
+
+// Откат/повтор: данные и настройки шагов из снимка, журнал начинается с нового состояния
+void MainWindow::applySnapshot(const MeasurementSnapshot& snapshot)
+{
+    dataMeasurement->restore(snapshot);
+
+    StepSettings settings = settingsManager->stepSettings();
+    if (settings.base != snapshot.stepSettings().base
+        || dataMeasurement->isStepStructureChanged(settings, snapshot.stepSettings())) {
+        settingsManager->setStepSettings(snapshot.stepSettings());
+        ui->actionBidirectional->setChecked(snapshot.stepSettings().bidirectional);
+    }
+    dataMeasurement->setStepSettings(settingsManager->stepSettings()); // повторы — по текущим настройкам
+    visualizer->addSavedValue(dataMeasurement->columns());
+
+    journal->reset();
+    journal->recordState(*dataMeasurement);             // окна и конвейер add — как у живой сессии
+    updateUndoActions();
+}
+
+void MainWindow::updateUndoActions()
+{
+    ui->actionUndo->setEnabled(!undoStack.isEmpty());
+    ui->actionRedo->setEnabled(!redoStack.isEmpty());
+}
+
+// Сохранённые значения после смены настроек: если производные устарели, пересчёт идёт
+// в пуле потоков над копией колонок, а таблица и график обновляются по готовности.
+// Если за это время данные поменялись (сохранение, откат), результат отбрасывается —
+// их уже показал тот, кто менял, досчитав синхронно при чтении.
+void MainWindow::refreshSavedView()
+{
+    if (!dataMeasurement->derivedPending()) {
+        visualizer->addSavedValue(dataMeasurement->columns());
+        return;
+    }
+
+    auto job = std::make_shared<DataMeasurement::DerivedJob>(dataMeasurement->derivedJob());
+    auto* watcher = new QFutureWatcher<void>(this);
+    connect(watcher, &QFutureWatcher<void>::finished, this, [=]() {
+        watcher->deleteLater();
+        if (dataMeasurement->adoptDerived(*job)) {
+            visualizer->addSavedValue(dataMeasurement->columns());
+            ui->statusbar->showMessage("Измерения пересчитаны под новые настройки", 3000);
+        }
+    });
+    ui->statusbar->showMessage("Пересчёт измерений под новые настройки...");
+    watcher->setFuture(QtConcurrent::run([job]() { DataMeasurement::runDerived(*job); }));
+}
+
 void MainWindow::addTimeSetting()
 {
     QWidget* timeWidget = new QWidget(this);
@@ -394,4 +1090,61 @@ void MainWindow::addTimeSetting()
     connect(spinBox, QOverload<int>::of(&QSpinBox::valueChanged), settingsManager, &SettingsManager::setSaveTime);
 }
 
+void MainWindow::addDecimationSetting()
+{
+    QWidget* decimWidget = new QWidget(this);
+    QHBoxLayout* layout = new QHBoxLayout(decimWidget);
+    layout->setContentsMargins(10, 0, 10, 0);
+
+    QLabel* label = new QLabel("Прореживание потока (раз):", decimWidget);
+    QSpinBox* spinBox = new QSpinBox(decimWidget);
+    spinBox->setRange(1, 1000);
+    spinBox->setValue(settingsManager->decimation());
+
+    layout->addWidget(label);
+    layout->addWidget(spinBox);
+
+    QWidgetAction* action = new QWidgetAction(this);
+    action->setDefaultWidget(decimWidget);
+    ui->menuSettings->insertAction(ui->menuSettings->actions().isEmpty() ? nullptr: ui->menuSettings->actions().first(), action);
+
+    connect(spinBox, QOverload<int>::of(&QSpinBox::valueChanged), settingsManager, &SettingsManager::setDecimation);
+    connect(spinBox, QOverload<int>::of(&QSpinBox::valueChanged), decimator, &Decimator::setRatio);
+}
+
+void MainWindow::addSmoothingSetting()
+{
+    QWidget* smoothWidget = new QWidget(this);
+    QHBoxLayout* layout = new QHBoxLayout(smoothWidget);
+    layout->setContentsMargins(10, 0, 10, 0);
+
+    QLabel* label = new QLabel("Сглаживание графика, Гц (0 — выкл.):", smoothWidget);
+    QDoubleSpinBox* spinBox = new QDoubleSpinBox(smoothWidget);
+    spinBox->setRange(0.0, 1000.0);
+    spinBox->setDecimals(2);
+    spinBox->setValue(settingsManager->smoothingCutoff());
 
+    layout->addWidget(label);
+    layout->addWidget(spinBox);
+
+    QWidgetAction* action = new QWidgetAction(this);
+    action->setDefaultWidget(smoothWidget);
+    ui->menuSettings->insertAction(ui->menuSettings->actions().isEmpty() ? nullptr: ui->menuSettings->actions().first(), action);
+
+    connect(spinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), settingsManager, &SettingsManager::setSmoothingCutoff);
+    connect(spinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &MainWindow::applySmoothing);
+}
+
+void MainWindow::applySmoothing(double cutoffHz)
+{
+    // график и авто-режим подписываются на сглаженный поток, если срез задан
+    DataBuffer* source = (cutoffHz > 0.0) ? smoothBuffer : buffer;
+    if (cutoffHz > 0.0)
+        lowpass->setCutoff(cutoffHz);
+
+    disconnect(buffer, &DataBuffer::updated, visualizer, &DataVisualizer::onBufferUpdated);
+    disconnect(smoothBuffer, &DataBuffer::updated, visualizer, &DataVisualizer::onBufferUpdated);
+    connect(source, &DataBuffer::updated, visualizer, &DataVisualizer::onBufferUpdated);
+
+    autoSaver->setSource(source);
+}
@@ -7,12 +7,18 @@
 #include "appstate.h"
 #include "pyproc.h"
 #include "databuffer.h"
+#include "decimator.h"
+#include "biquadlowpass.h"
+#include "environmentcompensator.h"
+#include "environmentsource.h"
 #include "filter.h"
 #include "datavisualizer.h"
 #include "filemanager.h"
 #include "settingsmanager.h"
 #include "datameasurement.h"
 #include "automeasurement.h"
+#include "sessionjournal.h"
+#include "sessiondatabase.h"
 
 
 QT_BEGIN_NAMESPACE
@@ -32,19 +38,52 @@ private slots:
     void onValueReady();
     void onPyError(const QString& msg);
     void on_actionSave_triggered();
+    void on_actionRefilter_triggered();
+    void on_actionSaveSession_triggered();
+    void on_actionOpenSession_triggered();
+    void on_actionSaveToHistory_triggered();
+    void on_actionHistory_triggered();
+    void on_actionDriftCompensation_toggled(bool on);
+    void on_actionDriftCurve_triggered();
+    void on_actionCyclePlan_triggered();
+    void on_actionEnvironment_triggered();
+    void onEnvironmentSample(const EnvironmentSample& sample);
+    void on_actionUndo_triggered();
+    void on_actionRedo_triggered();
+    void onSaveSample(const QVector<double>& values);
 
 private:
     Ui::MainWindow *ui;
     AppState* appState;
     PyProc* pyProc;
     DataBuffer* buffer;
+    EnvironmentCompensator* envCompensator;  // поправки на воздух и тепловое расширение до дециматора
+    EnvironmentSource* envSource;            // вторичный источник условий среды
+    Decimator* decimator;
+    BiquadLowpass* lowpass;
+    DataBuffer* smoothBuffer;  // сглаженный поток для графика и авто-режима
     Filter* filter = nullptr;
     DataVisualizer* visualizer;
     FileManager* fileManager;
     SettingsManager* settingsManager;
     DataMeasurement* dataMeasurement;
     AutoMeasurement* autoSaver = nullptr;
+    SessionJournal* journal = nullptr;  // журнал изменений dataMeasurement для восстановления после сбоя
+    SessionDatabase historyDb;          // история калибровок по станкам и осям
+    QVector<double> saveWindow;  // сырые отсчёты текущего окна сохранения
+    QVector<MeasurementSnapshot> undoStack;  // снимки до изменений (общие блоки групп — дёшево)
+    QVector<MeasurementSnapshot> redoStack;  // снимки, отменённые через undo
+    AutoSavePlan pendingPlan;    // план цикла ISO 230-2 для следующего запуска автомата
+    bool hasPendingPlan = false;
     void addTimeSetting();  // настройка строки времени измерения в меню
+    void addDecimationSetting();  // настройка прореживания входного потока в меню
+    void addSmoothingSetting();   // настройка сглаживания графика и авто-режима в меню
+    void applySmoothing(double cutoffHz);  // выбор сырого или сглаженного потока для потребителей
+    void restoreSession();                 // предложить восстановить сессию из журнала
+    void pushUndo();                       // запомнить состояние перед изменением измерений
+    void applySnapshot(const MeasurementSnapshot& snapshot); // откат/повтор: данные, настройки, журнал
+    void updateUndoActions();              // доступность пунктов «Отменить»/«Повторить»
+    void refreshSavedView();               // таблица и график сохранённых; пересчёт — вне GUI-потока
 };
 
 #endif // MAINWINDOW_H
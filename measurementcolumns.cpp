@@ -0,0 +1,232 @@
+#include "measurementcolumns.h"      // заголовок хранилища
+#include <limits>                       // NaN
+
+// новая группа в хвост
+void MeasurementColumns::appendGroup(int id, StepMode mode, MeasurementGroupType type, bool selected)
+{
+    groupId.append(id);
+    groupMode.append(mode);
+    groupType.append(type);
+    groupSelected.append(selected);
+    groupOffset.append(groupOffset.last());                 // пока без серий
+}
+
+// новая серия в последнюю группу
+void MeasurementColumns::appendSeries(int stepNumber, ApproachDirection direction)
+{
+    Q_ASSERT(groupCount() > 0 && "MeasurementColumns: series without group");
+    seriesStep.append(stepNumber);
+    seriesDirection.append(direction);
+    seriesGroup.append(groupCount() - 1);
+    seriesOffset.append(seriesOffset.last());               // пока без строк
+    ++groupOffset.last();                                   // группа выросла на серию
+}
+
+// новая строка в последнюю серию
+void MeasurementColumns::appendRow(const Measurement& m)
+{
+    Q_ASSERT(seriesCount() > 0 && "MeasurementColumns: row without series");
+    raw.append(m.raw);
+    distance.append(m.distance);
+    expected.append(m.expected);
+    deviation.append(m.deviation);
+    repeatIndex.append(m.repeatIndex);
+    rawIndex.append(m.rawIndex);
+    timeMs.append(m.timeMs);
+    drift.append(m.drift);
+    ++seriesOffset.last();                                  // серия выросла на строку
+}
+
+// память под ожидаемые размеры
+void MeasurementColumns::reserve(int rows, int series, int groups)
+{
+    raw.reserve(rows);
+    distance.reserve(rows);
+    expected.reserve(rows);
+    deviation.reserve(rows);
+    repeatIndex.reserve(rows);
+    rawIndex.reserve(rows);
+    timeMs.reserve(rows);
+    drift.reserve(rows);
+
+    seriesOffset.reserve(series + 1);
+    seriesStep.reserve(series);
+    seriesDirection.reserve(series);
+    seriesGroup.reserve(series);
+
+    groupOffset.reserve(groups + 1);
+    groupId.reserve(groups);
+    groupMode.reserve(groups);
+    groupType.reserve(groups);
+    groupSelected.reserve(groups);
+}
+
+// очистить всё
+void MeasurementColumns::clear()
+{
+    *this = MeasurementColumns();
+}
+
+// согласованность колонок и таблиц смещений (данные пришли с диска)
+bool MeasurementColumns::isConsistent() const
+{
+    const int rows = raw.size();
+    const int series = seriesStep.size();
+    const int groups = groupId.size();
+    if (distance.size() != rows || expected.size() != rows || deviation.size() != rows
+        || repeatIndex.size() != rows || rawIndex.size() != rows
+        || timeMs.size() != rows || drift.size() != rows
+        || seriesOffset.size() != series + 1 || seriesDirection.size() != series || seriesGroup.size() != series
+        || groupOffset.size() != groups + 1 || groupMode.size() != groups
+        || groupType.size() != groups || groupSelected.size() != groups
+        || seriesOffset.first() != 0 || seriesOffset.last() != rows
+        || groupOffset.first() != 0 || groupOffset.last() != series)
+        return false;
+    for (int s = 0; s < series; ++s)
+        if (seriesOffset[s] > seriesOffset[s + 1] || seriesGroup[s] < 0 || seriesGroup[s] >= groups)
+            return false;
+    for (int g = 0; g < groups; ++g)
+        if (groupOffset[g] > groupOffset[g + 1])
+            return false;
+    return true;
+}
+
+// одна запись в формате Measurement
+Measurement MeasurementColumns::row(int i) const
+{
+    Measurement m;
+    m.repeatIndex = repeatIndex[i];
+    m.raw         = raw[i];
+    m.distance    = distance[i];
+    m.expected    = expected[i];
+    m.deviation   = deviation[i];
+    m.rawIndex    = rawIndex[i];
+    m.timeMs      = timeMs[i];
+    m.drift       = drift[i];
+    return m;
+}
+
+// среднее raw по серии
+double MeasurementColumns::seriesMeanRaw(int s) const
+{
+    const int b = seriesBegin(s);
+    const int e = seriesEnd(s);
+    if (b == e) return std::numeric_limits<double>::quiet_NaN(); // если пусто
+
+    const double* r = raw.constData();
+    double sum = 0.0;
+    for (int i = b; i < e; ++i) sum += r[i];                // непрерывный проход
+    return sum / (e - b);
+}
+
+// одна группа отдельным хранилищем
+MeasurementColumns MeasurementColumns::sliceGroup(int g) const
+{
+    MeasurementColumns c;
+    c.appendGroup(groupId[g], groupMode[g], groupType[g], groupSelected[g]);
+
+    const int sb = groupBegin(g);
+    const int se = groupEnd(g);
+    const int rb = seriesBegin(sb);
+    const int re = sb < se ? seriesEnd(se - 1) : rb;
+
+    // строки группы идут подряд — копируем диапазоны колонок целиком
+    c.raw         = raw.mid(rb, re - rb);
+    c.distance    = distance.mid(rb, re - rb);
+    c.expected    = expected.mid(rb, re - rb);
+    c.deviation   = deviation.mid(rb, re - rb);
+    c.repeatIndex = repeatIndex.mid(rb, re - rb);
+    c.rawIndex    = rawIndex.mid(rb, re - rb);
+    c.timeMs      = timeMs.mid(rb, re - rb);
+    c.drift       = drift.mid(rb, re - rb);
+
+    for (int s = sb; s < se; ++s) {
+        c.seriesStep.append(seriesStep[s]);
+        c.seriesDirection.append(seriesDirection[s]);
+        c.seriesGroup.append(0);
+        c.seriesOffset.append(seriesOffset[s + 1] - rb);
+    }
+    c.groupOffset.last() = se - sb;
+    return c;
+}
+
+// дописать все группы other в хвост
+void MeasurementColumns::appendColumns(const MeasurementColumns& other)
+{
+    const int rowBase = rowCount();
+    const int seriesBase = seriesCount();
+    const int groupBase = groupCount();
+
+    raw         += other.raw;
+    distance    += other.distance;
+    expected    += other.expected;
+    deviation   += other.deviation;
+    repeatIndex += other.repeatIndex;
+    rawIndex    += other.rawIndex;
+    timeMs      += other.timeMs;
+    drift       += other.drift;
+
+    for (int s = 0; s < other.seriesCount(); ++s) {
+        seriesStep.append(other.seriesStep[s]);
+        seriesDirection.append(other.seriesDirection[s]);
+        seriesGroup.append(groupBase + other.seriesGroup[s]);
+        seriesOffset.append(rowBase + other.seriesOffset[s + 1]);
+    }
+    for (int g = 0; g < other.groupCount(); ++g) {
+        groupId.append(other.groupId[g]);
+        groupMode.append(other.groupMode[g]);
+        groupType.append(other.groupType[g]);
+        groupSelected.append(other.groupSelected[g]);
+        groupOffset.append(seriesBase + other.groupOffset[g + 1]);
+    }
+}
+
+// из вложенной структуры
+MeasurementColumns MeasurementColumns::fromGroups(const QVector<MeasurementGroup>& groups)
+{
+    int rows = 0, series = 0;
+    for (const auto& g : groups) {
+        series += g.steps.size();
+        for (const auto& s : g.steps) rows += s.measurements.size();
+    }
+
+    MeasurementColumns c;
+    c.reserve(rows, series, groups.size());
+    for (const auto& g : groups) {
+        c.appendGroup(g.groupId, g.mode, g.type, g.selectedFor);
+        for (const auto& s : g.steps) {
+            c.appendSeries(s.stepNumber, s.direction);
+            for (const auto& m : s.measurements)
+                c.appendRow(m);
+        }
+    }
+    return c;
+}
+
+// во вложенную структуру (представление для старого API)
+QVector<MeasurementGroup> MeasurementColumns::toGroups() const
+{
+    QVector<MeasurementGroup> groups;
+    groups.reserve(groupCount());
+
+    for (int g = 0; g < groupCount(); ++g) {
+        MeasurementGroup group;
+        group.groupId     = groupId[g];
+        group.mode        = groupMode[g];
+        group.type        = groupType[g];
+        group.selectedFor = groupSelected[g];
+        group.steps.reserve(groupSeries(g));
+
+        for (int s = groupBegin(g); s < groupEnd(g); ++s) {
+            MeasurementSeries series;
+            series.stepNumber = seriesStep[s];
+            series.direction  = seriesDirection[s];
+            series.measurements.reserve(seriesRows(s));
+            for (int i = seriesBegin(s); i < seriesEnd(s); ++i)
+                series.measurements.append(row(i));
+            group.steps.append(series);
+        }
+        groups.append(group);
+    }
+    return groups;
+}
@@ -0,0 +1,67 @@
+#ifndef MEASUREMENTCOLUMNS_H
+#define MEASUREMENTCOLUMNS_H
+
+#include <QVector>                      // непрерывные колонки
+#include "typemeasurement.h"            // Measurement*, Direction, Group types
+
+// колоночное (struct-of-arrays) хранилище измерений:
+// строки = измерения, серии = шаги, группы = группы; вложенность задаётся таблицами смещений
+struct MeasurementColumns
+{
+    // ——— колонки строк (по одной записи на измерение) ———
+    QVector<double> raw;                                    // отфильтрованное значение
+    QVector<double> distance;                               // raw - base
+    QVector<double> expected;                               // теоретическое значение шага
+    QVector<double> deviation;                              // distance - expected
+    QVector<int>    repeatIndex;                            // номер повтора (с 1)
+    QVector<int>    rawIndex;                               // индекс сырого окна (-1 — нет)
+    QVector<qint64> timeMs;                                 // время сохранения, мс от эпохи (0 — неизвестно)
+    QVector<double> drift;                                  // поправка на дрейф (0 — без компенсации)
+
+    // ——— таблица серий: строки серии s = [seriesOffset[s], seriesOffset[s + 1]) ———
+    QVector<int>               seriesOffset { 0 };          // смещения строк, размер = серий + 1
+    QVector<int>               seriesStep;                  // номер шага
+    QVector<ApproachDirection> seriesDirection;             // направление подхода
+    QVector<int>               seriesGroup;                 // порядковый номер группы серии
+
+    // ——— таблица групп: серии группы g = [groupOffset[g], groupOffset[g + 1]) ———
+    QVector<int>                  groupOffset { 0 };        // смещения серий, размер = групп + 1
+    QVector<int>                  groupId;                  // id группы
+    QVector<StepMode>             groupMode;                // режим шагов
+    QVector<MeasurementGroupType> groupType;                // одно/двунаправленная
+    QVector<bool>                 groupSelected;            // участвует в расчёте
+
+    // ——— размеры и диапазоны ———
+    int rowCount() const    { return raw.size(); }
+    int seriesCount() const { return seriesStep.size(); }
+    int groupCount() const  { return groupId.size(); }
+
+    int seriesBegin(int s) const { return seriesOffset[s]; }
+    int seriesEnd(int s) const   { return seriesOffset[s + 1]; }
+    int seriesRows(int s) const  { return seriesOffset[s + 1] - seriesOffset[s]; }
+    int groupBegin(int g) const  { return groupOffset[g]; }
+    int groupEnd(int g) const    { return groupOffset[g + 1]; }
+    int groupSeries(int g) const { return groupOffset[g + 1] - groupOffset[g]; }
+
+    // ——— наполнение (всегда в хвост) ———
+    void appendGroup(int id, StepMode mode, MeasurementGroupType type, bool selected = true);
+    void appendSeries(int stepNumber, ApproachDirection direction = ApproachDirection::Unknown);
+    void appendRow(const Measurement& m);
+    void reserve(int rows, int series, int groups);         // память под размеры заранее (без перекладок при росте)
+    void clear();
+    bool isConsistent() const;                              // размеры колонок и таблицы смещений согласованы
+
+    // ——— доступ в старом формате ———
+    Measurement row(int i) const;                           // одна запись
+    double seriesMeanRaw(int s) const;                      // среднее raw по серии (NaN для пустой)
+
+    // ——— срезы по группам ———
+    MeasurementColumns sliceGroup(int g) const;             // одна группа отдельным хранилищем
+    void appendColumns(const MeasurementColumns& other);    // дописать все группы other в хвост
+
+    // ——— преобразование из/во вложенную структуру ———
+    static MeasurementColumns fromGroups(const QVector<MeasurementGroup>& groups);
+    QVector<MeasurementGroup> toGroups() const;
+};
+
+#endif // MEASUREMENTCOLUMNS_H
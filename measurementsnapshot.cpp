@@ -0,0 +1,79 @@
+#include "measurementsnapshot.h"     // заголовок класса
+#include "recalcengine.h"               // параллельная сборка накопителей
+#include <algorithm>                    // std::max
+
+// заморозить одну группу
+MeasurementSnapshot::BlockPtr MeasurementSnapshot::freeze(const MeasurementColumns& cols,
+                                                          const StepStatistics& stats,
+                                                          int g)
+{
+    auto block = std::make_shared<GroupBlock>();
+    block->cols = cols.sliceGroup(g);                                    // строки группы подряд
+    if (g < stats.groupCount())
+        block->stats = stats.group(g);                                   // QMap — неявно разделяемый
+    return block;
+}
+
+// снимок из вложенной структуры
+MeasurementSnapshot MeasurementSnapshot::fromGroups(const QVector<MeasurementGroup>& groups,
+                                                    const StepSettings& settings)
+{
+    return fromColumns(MeasurementColumns::fromGroups(groups), settings);
+}
+
+// снимок из готовых колонок
+MeasurementSnapshot MeasurementSnapshot::fromColumns(const MeasurementColumns& cols,
+                                                     const StepSettings& settings)
+{
+    StepStatistics stats;
+    RecalcEngine::rebuildStatistics(stats, cols);                        // накопители по готовым числам
+
+    MeasurementSnapshot s;
+    s.m_settings = settings;
+    s.m_blocks.reserve(cols.groupCount());
+    for (int g = 0; g < cols.groupCount(); ++g)
+        s.m_blocks.append(freeze(cols, stats, g));
+    for (int id : cols.groupId)
+        s.m_cursor.groupIdCounter = std::max(s.m_cursor.groupIdCounter, id);
+    return s;
+}
+
+// число измерений
+int MeasurementSnapshot::rowCount() const
+{
+    int n = 0;
+    for (const auto& b : m_blocks) n += b->cols.rowCount();
+    return n;
+}
+
+// тот же блок группы g, что и в other (группа не менялась между снимками)
+bool MeasurementSnapshot::sharesGroup(const MeasurementSnapshot& other, int g) const
+{
+    return g < m_blocks.size() && g < other.m_blocks.size() && m_blocks[g] == other.m_blocks[g];
+}
+
+// все группы одним хранилищем
+MeasurementColumns MeasurementSnapshot::columns() const
+{
+    int rows = 0, series = 0;
+    for (const auto& b : m_blocks) {
+        rows += b->cols.rowCount();
+        series += b->cols.seriesCount();
+    }
+
+    MeasurementColumns c;
+    c.reserve(rows, series, m_blocks.size());
+    for (const auto& b : m_blocks)
+        c.appendColumns(b->cols);
+    return c;
+}
+
+// вложенное представление
+QVector<MeasurementGroup> MeasurementSnapshot::groups() const
+{
+    QVector<MeasurementGroup> out;
+    out.reserve(m_blocks.size());
+    for (const auto& b : m_blocks)
+        out += b->cols.toGroups();                                       // по одной группе в блоке
+    return out;
+}
@@ -0,0 +1,69 @@
+#ifndef MEASUREMENTSNAPSHOT_H
+#define MEASUREMENTSNAPSHOT_H
+
+#include <QVector>                      // блоки групп
+#include <memory>                       // общие неизменяемые блоки
+#include "typemeasurement.h"            // MeasurementGroup
+#include "settingsmanager.h"            // StepSettings
+#include "measurementcolumns.h"         // колонки одной группы
+#include "stepstatistics.h"             // накопители одной группы
+#include "rawrecordstore.h"             // сырые окна на момент снимка
+
+// неизменяемый снимок DataMeasurement: по блоку на группу (колонки + накопители шагов).
+// Блоки общие между снимками и самим DataMeasurement — копирование снимка O(1),
+// а новый снимок пересобирает только группы, изменённые после предыдущего.
+// Блоки не меняются после создания, поэтому снимок можно читать из рабочих потоков,
+// пока сбор данных продолжает дописывать измерения.
+class MeasurementSnapshot
+{
+public:
+    // одна замороженная группа
+    struct GroupBlock {
+        MeasurementColumns cols;                            // колонки группы (groupCount() == 1)
+        StepStatistics::GroupStats stats;                   // накопители по шагам группы
+    };
+    using BlockPtr = std::shared_ptr<const GroupBlock>;
+
+    // состояние конвейера add — чтобы после отката следующий add продолжил с того же места
+    struct Cursor {
+        int  currentStep = 0;                               // текущий номер шага
+        int  currentRepeat = 0;                             // текущий повтор
+        int  groupIdCounter = 0;                            // счётчик id групп
+        bool stepStructureChanged = false;                  // ждёт ли add новой группы
+    };
+
+    MeasurementSnapshot() = default;                        // пустой снимок
+
+    // заморозить группу g колонок cols вместе с её накопителями
+    static BlockPtr freeze(const MeasurementColumns& cols, const StepStatistics& stats, int g);
+    // снимок из вложенной структуры (таблица окна точности)
+    static MeasurementSnapshot fromGroups(const QVector<MeasurementGroup>& groups,
+                                          const StepSettings& settings = StepSettings{});
+    // снимок из уже собранных колонок (без промежуточной вложенной структуры)
+    static MeasurementSnapshot fromColumns(const MeasurementColumns& cols,
+                                           const StepSettings& settings = StepSettings{});
+
+    bool isEmpty() const { return m_blocks.isEmpty(); }     // нет ни одной группы
+    int groupCount() const { return m_blocks.size(); }      // число групп
+    int rowCount() const;                                   // число измерений
+    const MeasurementColumns& group(int g) const { return m_blocks[g]->cols; }          // колонки группы
+    const StepStatistics::GroupStats& groupStats(int g) const { return m_blocks[g]->stats; } // накопители группы
+    bool sharesGroup(const MeasurementSnapshot& other, int g) const;                    // тот же блок, что у other
+
+    const StepSettings& stepSettings() const { return m_settings; }  // настройки на момент снимка
+    const RawRecordStore& rawRecords() const { return m_raw; }       // сырые окна на момент снимка
+    const Cursor& cursor() const { return m_cursor; }                // состояние конвейера add
+
+    MeasurementColumns columns() const;                     // все группы одним хранилищем (копия)
+    QVector<MeasurementGroup> groups() const;               // вложенное представление (копия)
+
+private:
+    friend class DataMeasurement;                           // собирает снимок из своих блоков
+
+    QVector<BlockPtr> m_blocks;                             // по порядковому номеру группы
+    StepSettings m_settings{};                              // настройки шагов
+    RawRecordStore m_raw;                                   // окна (QVector — неявно разделяемый)
+    Cursor m_cursor;                                        // конвейер add
+};
+
+#endif // MEASUREMENTSNAPSHOT_H
@@ -0,0 +1,87 @@
+#include "rawrecordstore.h"             // заголовок хранилища
+#include <cstring>                      // memcpy
+
+// сжать и добавить окно, вернуть индекс
+int RawRecordStore::append(const QVector<double>& samples)
+{
+    const QByteArray blob = encode(samples);                      // упаковываем
+    m_rawBytes += qint64(samples.size()) * qint64(sizeof(double));
+    m_compressedBytes += blob.size();
+    if (!m_arena) m_arena = std::make_shared<ByteArena>();
+    const char* p = m_arena->store(blob.constData(), blob.size()); // в арену, без своего буфера
+    m_blobs.append(QByteArray::fromRawData(p, blob.size()));      // кладём в конец представление
+    return m_blobs.size() - 1;                                    // индекс для Measurement::rawIndex
+}
+
+// распаковать окно по индексу
+QVector<double> RawRecordStore::window(int index) const
+{
+    if (index < 0 || index >= m_blobs.size()) return {};          // нет такого окна
+    return decode(m_blobs[index]);
+}
+
+// очистить всё
+void RawRecordStore::clear()
+{
+    m_blobs.clear();
+    m_rawBytes = 0;
+    m_compressedBytes = 0;
+    m_backing.reset();
+    m_arena.reset();                                              // арена уходит разом, когда её отпустят снимки
+}
+
+// окна из отображённого файла: распаковываются (и подгружаются с диска) только при window()
+void RawRecordStore::adoptMapped(const QVector<QByteArray>& blobs, qint64 rawBytes, std::shared_ptr<const void> backing)
+{
+    m_blobs = blobs;
+    m_rawBytes = rawBytes;
+    m_compressedBytes = 0;
+    for (const auto& b : m_blobs) m_compressedBytes += b.size();
+    m_backing = std::move(backing);
+    m_arena.reset();                                              // прежние окна больше не нужны
+}
+
+// соседние отсчёты почти равны: XOR их битов даёт много нулевых старших байт,
+// а раскладка по байтовым плоскостям собирает эти нули подряд для zlib
+QByteArray RawRecordStore::encode(const QVector<double>& samples)
+{
+    const int n = samples.size();
+    QByteArray plain(int(sizeof(qint32)) + n * int(sizeof(quint64)), '\0');
+    const qint32 count = n;
+    std::memcpy(plain.data(), &count, sizeof(count));             // число отсчётов в заголовке
+
+    uchar* planes = reinterpret_cast<uchar*>(plain.data()) + sizeof(qint32);
+    quint64 prev = 0;
+    for (int i = 0; i < n; ++i) {
+        quint64 bits = 0;
+        std::memcpy(&bits, &samples[i], sizeof(bits));
+        const quint64 x = bits ^ prev;                            // XOR с предыдущим
+        prev = bits;
+        for (int b = 0; b < 8; ++b)
+            planes[b * n + i] = uchar(x >> (8 * b));              // байт b → плоскость b
+    }
+    return qCompress(plain);
+}
+
+// обратное преобразование
+QVector<double> RawRecordStore::decode(const QByteArray& blob)
+{
+    const QByteArray plain = qUncompress(blob);
+    if (plain.size() < int(sizeof(qint32))) return {};            // повреждённый блок
+
+    qint32 n = 0;
+    std::memcpy(&n, plain.constData(), sizeof(n));
+    if (n <= 0 || plain.size() != int(sizeof(qint32)) + n * int(sizeof(quint64))) return {};
+
+    const uchar* planes = reinterpret_cast<const uchar*>(plain.constData()) + sizeof(qint32);
+    QVector<double> out(n);
+    quint64 prev = 0;
+    for (int i = 0; i < n; ++i) {
+        quint64 x = 0;
+        for (int b = 0; b < 8; ++b)
+            x |= quint64(planes[b * n + i]) << (8 * b);          // собираем из плоскостей
+        prev ^= x;                                                // снимаем XOR
+        std::memcpy(&out[i], &prev, sizeof(prev));
+    }
+    return out;
+}
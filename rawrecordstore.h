@@ -0,0 +1,43 @@
+#ifndef RAWRECORDSTORE_H
+#define RAWRECORDSTORE_H
+
+#include <QVector>                      // контейнер окон
+#include <QByteArray>                   // сжатые блоки
+#include <memory>                       // владелец отображённого файла и арены
+#include "bytearena.h"                  // куски памяти под сжатые окна
+
+// хранилище сырых окон сохранения (то, что видел фильтр) в сжатом виде;
+// Measurement::rawIndex ссылается на индекс окна здесь.
+// Сжатые окна лежат подряд в общей арене (без отдельного выделения на каждую точку),
+// m_blobs держит на них представления; копии хранилища (снимки) делят ту же арену,
+// а clear() отпускает её целиком.
+class RawRecordStore
+{
+public:
+    RawRecordStore() = default;                                   // пустое хранилище
+
+    int append(const QVector<double>& samples);                   // сжать и добавить окно, вернуть индекс
+    QVector<double> window(int index) const;                      // распаковать окно по индексу
+    int size() const { return m_blobs.size(); }                   // число окон
+    void clear();                                                 // очистить всё
+
+    const QByteArray& blob(int index) const { return m_blobs[index]; } // сжатое окно как есть (для файла сессии)
+    // взять окна из отображённой памяти без копирования; backing держит отображение живым
+    void adoptMapped(const QVector<QByteArray>& blobs, qint64 rawBytes, std::shared_ptr<const void> backing);
+
+    qint64 rawBytes() const { return m_rawBytes; }                // объём без сжатия
+    qint64 compressedBytes() const { return m_compressedBytes; }  // объём в памяти
+    qint64 arenaBytes() const { return m_arena ? m_arena->reservedBytes() : 0; } // выделено под арену
+
+private:
+    static QByteArray encode(const QVector<double>& samples);     // XOR-дельты + байтовые плоскости + zlib
+    static QVector<double> decode(const QByteArray& blob);        // обратное преобразование
+
+    QVector<QByteArray> m_blobs;                                  // сжатые окна
+    qint64 m_rawBytes = 0;                                        // сумма исходных размеров
+    qint64 m_compressedBytes = 0;                                 // сумма сжатых размеров
+    std::shared_ptr<const void> m_backing;                        // отображённый файл сессии (если окна из него)
+    std::shared_ptr<ByteArena> m_arena;                           // память записанных в сессии окон
+};
+
+#endif // RAWRECORDSTORE_H
@@ -0,0 +1,200 @@
+#include "recalcengine.h"               // заголовок движка
+#include "calculatemesurement.h"        // те же формулы, что и в последовательном пути
+#include <QtConcurrent>                 // пул потоков
+#include <algorithm>                    // std::fill, sort/unique шагов
+#include <limits>                       // открытые края диапазонов шагов
+
+// куски из целых серий примерно по kChunkRows строк
+QVector<RecalcEngine::Chunk> RecalcEngine::partition(const MeasurementColumns& cols)
+{
+    QVector<Chunk> chunks;
+    int begin = 0;
+    for (int s = 0; s < cols.seriesCount(); ++s) {
+        if (cols.seriesEnd(s) - cols.seriesBegin(begin) >= kChunkRows) {  // кусок набран
+            chunks.append({ begin, s + 1 });
+            begin = s + 1;
+        }
+    }
+    if (begin < cols.seriesCount())
+        chunks.append({ begin, cols.seriesCount() });                    // хвост
+    return chunks;
+}
+
+void RecalcEngine::recalcColumns(MeasurementColumns& cols,
+                                 double base,
+                                 const ExpectedTable& table)
+{
+    if (cols.rowCount() < kParallelRows) {                               // потоки дороже самой работы
+        CalculateMesurement::recalcColumns(cols, base, table);
+        return;
+    }
+
+    // отрываем колонки от общих копий до запуска потоков
+    const double* raw = cols.raw.constData();
+    double* dist = cols.distance.data();
+    double* exp  = cols.expected.data();
+    double* dev  = cols.deviation.data();
+    const MeasurementColumns& c = cols;
+
+    QVector<Chunk> chunks = partition(cols);
+    QtConcurrent::blockingMap(chunks, [&](const Chunk& ch) {
+        for (int s = ch.seriesBegin; s < ch.seriesEnd; ++s) {
+            const double e = table.at(c.seriesStep[s]);                  // таблица неизменяема — читают все потоки
+            std::fill(exp + c.seriesBegin(s), exp + c.seriesEnd(s), e);  // ожидаемое по шагу
+        }
+        const int b = c.seriesBegin(ch.seriesBegin);
+        const int e = c.seriesEnd(ch.seriesEnd - 1);
+        for (int i = b; i < e; ++i) dist[i] = raw[i] - base;             // смещение от базы
+        for (int i = b; i < e; ++i) dev[i]  = dist[i] - exp[i];          // погрешность
+    });
+}
+
+void RecalcEngine::recalcDirectionsInColumns(MeasurementColumns& cols,
+                                             int maxStepForBidi,
+                                             double eps)
+{
+    if (cols.rowCount() < kParallelRows) {
+        CalculateMesurement::recalcDirectionsInColumns(cols, maxStepForBidi, eps);
+        return;
+    }
+
+    const int nSeries = cols.seriesCount();
+    QVector<double> meansBuf(nSeries);                                   // среднее каждой серии — один раз
+    double* means = meansBuf.data();
+    ApproachDirection* dir = cols.seriesDirection.data();
+    const MeasurementColumns& c = cols;
+
+    QVector<Chunk> chunks = partition(cols);
+
+    // проход 1: средние серий (соседний кусок понадобится только во втором проходе)
+    QtConcurrent::blockingMap(chunks, [&](const Chunk& ch) {
+        for (int s = ch.seriesBegin; s < ch.seriesEnd; ++s)
+            means[s] = c.seriesMeanRaw(s);
+    });
+
+    // проход 2: направление серии зависит только от неё и предыдущей серии группы
+    QtConcurrent::blockingMap(chunks, [&](const Chunk& ch) {
+        for (int s = ch.seriesBegin; s < ch.seriesEnd; ++s) {
+            const int g = c.seriesGroup[s];
+            if (s == c.groupBegin(g)) {
+                dir[s] = ApproachDirection::Unknown;                     // первый шаг = Unknown
+                continue;
+            }
+            if (c.seriesRows(s - 1) == 0 || c.seriesRows(s) == 0) {
+                dir[s] = ApproachDirection::Unknown;                     // нет данных
+                continue;
+            }
+            const bool isBidi = (c.groupType[g] == MeasurementGroupType::Bidirectional);
+            dir[s] = CalculateMesurement::directionByMeans(c.seriesStep[s - 1], means[s - 1],
+                                                           c.seriesStep[s], means[s],
+                                                           isBidi, maxStepForBidi, eps);
+        }
+    });
+}
+
+void RecalcEngine::recalcAllGroups(QVector<MeasurementGroup>& groups,
+                                   double base,
+                                   const ExpectedTable& table)
+{
+    // группы независимы — по одной на задачу
+    QtConcurrent::blockingMap(groups, [&](MeasurementGroup& g) {
+        for (auto& s : g.steps) {
+            const double exp = table.at(s.stepNumber);
+            for (auto& m : s.measurements) {
+                m.distance  = CalculateMesurement::distance(m.raw, base);
+                m.expected  = exp;
+                m.deviation = CalculateMesurement::deviation(m.distance, m.expected);
+            }
+        }
+    });
+}
+
+void RecalcEngine::recalcDirectionsInGroups(QVector<MeasurementGroup>& groups,
+                                            int maxStepForBidi,
+                                            double eps)
+{
+    QtConcurrent::blockingMap(groups, [&](MeasurementGroup& g) {
+        if (g.steps.isEmpty()) return;
+
+        g.steps[0].direction = ApproachDirection::Unknown;               // первый шаг = Unknown
+        const bool isBidi = (g.type == MeasurementGroupType::Bidirectional);
+
+        double prevMean = CalculateMesurement::averageRaw(g.steps[0]);   // среднее предыдущего шага
+        for (int i = 1; i < g.steps.size(); ++i) {
+            const double currMean = CalculateMesurement::averageRaw(g.steps[i]);
+            if (g.steps[i - 1].measurements.isEmpty() || g.steps[i].measurements.isEmpty())
+                g.steps[i].direction = ApproachDirection::Unknown;       // нет данных
+            else
+                g.steps[i].direction = CalculateMesurement::directionByMeans(
+                    g.steps[i - 1].stepNumber, prevMean,
+                    g.steps[i].stepNumber, currMean,
+                    isBidi, maxStepForBidi, eps);
+            prevMean = currMean;                                         // каждое среднее — один раз
+        }
+    });
+}
+
+void RecalcEngine::rebuildStatistics(StepStatistics& stats, const MeasurementColumns& cols)
+{
+    if (cols.rowCount() < kParallelRows) {
+        stats.rebuild(cols);
+        return;
+    }
+
+    // разбиение — только по таблице серий: мелкая группа целиком, крупная — диапазонами шагов
+    QVector<StepTask> tasks;
+    for (int g = 0; g < cols.groupCount(); ++g) {
+        const int gb = cols.groupBegin(g);
+        const int ge = cols.groupEnd(g);
+        const int rows = gb < ge ? cols.seriesEnd(ge - 1) - cols.seriesBegin(gb) : 0;
+        const int parts = rows / kChunkRows;
+        if (parts <= 1) {
+            StepTask t;
+            t.group = g;
+            t.stepLo = std::numeric_limits<int>::min();
+            t.stepHi = std::numeric_limits<int>::max();
+            tasks.append(t);
+            continue;
+        }
+        QVector<int> steps(cols.seriesStep.constBegin() + gb, cols.seriesStep.constBegin() + ge);
+        std::sort(steps.begin(), steps.end());
+        steps.erase(std::unique(steps.begin(), steps.end()), steps.end());
+        const int n = std::min(parts, int(steps.size()));
+        for (int k = 0; k < n; ++k) {
+            StepTask t;
+            t.group = g;
+            t.stepLo = (k == 0)     ? std::numeric_limits<int>::min() : steps[k * steps.size() / n];
+            t.stepHi = (k == n - 1) ? std::numeric_limits<int>::max() : steps[(k + 1) * steps.size() / n] - 1;
+            tasks.append(t);
+        }
+    }
+
+    const double* dev = cols.deviation.constData();
+    const double* exp = cols.expected.constData();
+    const MeasurementColumns& c = cols;
+
+    // каждый накопитель пишет ровно одна задача, серии — в порядке хранения
+    QtConcurrent::blockingMap(tasks, [&](StepTask& t) {
+        for (int s = c.groupBegin(t.group); s < c.groupEnd(t.group); ++s) {
+            const int step = c.seriesStep[s];
+            if (step < t.stepLo || step > t.stepHi)
+                continue;
+            const ApproachDirection dir = c.seriesDirection[s];
+            for (int i = c.seriesBegin(s); i < c.seriesEnd(s); ++i)
+                if (StepAccumulator::counts(dir, dev[i]))
+                    t.stats[step].add(dir, dev[i], exp[i]);
+        }
+    });
+
+    // сборка — в одном потоке; диапазоны шагов группы не пересекаются
+    QVector<StepStatistics::GroupStats> groups(cols.groupCount());
+    for (StepTask& t : tasks) {
+        StepStatistics::GroupStats& dst = groups[t.group];
+        if (dst.isEmpty())
+            dst.swap(t.stats);
+        else
+            for (auto it = t.stats.cbegin(); it != t.stats.cend(); ++it)
+                dst.insert(it.key(), it.value());
+    }
+    stats.setGroups(groups);
+}
@@ -0,0 +1,55 @@
+#ifndef RECALCENGINE_H
+#define RECALCENGINE_H
+
+#include <QVector>                      // куски работы
+#include <QString>                      // строки настроек
+#include "typemeasurement.h"            // StepMode, MeasurementGroup
+#include "measurementcolumns.h"         // колоночное хранилище
+#include "expectedtable.h"              // ожидаемые по шагам
+#include "stepstatistics.h"             // накопители по шагам
+
+// параллельный пересчёт производных значений на пуле потоков (QtConcurrent).
+// Колонки делятся на куски из целых серий примерно по kChunkRows строк — разбиение
+// зависит только от данных, а не от числа потоков. Каждую ячейку пишет ровно один
+// поток теми же формулами, что и CalculateMesurement, поэтому результат побитово
+// совпадает с последовательным путём при любом числе ядер.
+class RecalcEngine
+{
+public:
+    static constexpr int kChunkRows    = 1 << 14;           // строк в куске работы
+    static constexpr int kParallelRows = 1 << 16;           // меньше — считаем в одном потоке
+
+    static void recalcColumns(MeasurementColumns& cols,
+                              double base,
+                              const ExpectedTable& table);              // distance/expected/deviation
+
+    static void recalcDirectionsInColumns(MeasurementColumns& cols,
+                                          int maxStepForBidi,
+                                          double eps = 1e-4);           // направления серий
+
+    static void recalcAllGroups(QVector<MeasurementGroup>& groups,
+                                double base,
+                                const ExpectedTable& table);            // то же по группам
+
+    static void recalcDirectionsInGroups(QVector<MeasurementGroup>& groups,
+                                         int maxStepForBidi,
+                                         double eps = 1e-4);            // направления по группам
+
+    // накопители (группа, шаг) — задача на группу, большая группа делится на диапазоны шагов
+    // примерно по kChunkRows строк; значения в каждый накопитель идут в том же порядке,
+    // что и в StepStatistics::rebuild, поэтому суммы Уэлфорда побитово те же
+    static void rebuildStatistics(StepStatistics& stats, const MeasurementColumns& cols);
+
+private:
+    struct Chunk { int seriesBegin; int seriesEnd; };        // полуинтервал серий
+    struct StepTask {                                        // шаги [stepLo, stepHi] одной группы
+        int group = 0;
+        int stepLo = 0;
+        int stepHi = 0;
+        StepStatistics::GroupStats stats;                    // результат задачи
+    };
+
+    static QVector<Chunk> partition(const MeasurementColumns& cols); // куски по kChunkRows строк
+};
+
+#endif // RECALCENGINE_H
@@ -0,0 +1,32 @@
+import sys
+import json
+import time
+import random
+
+# Заглушка метеостанции: дописывает отсчёты условий среды в файл (путь — первый аргумент)
+path = sys.argv[1] if len(sys.argv) > 1 else "environment.jsonl"
+interval = 5.0        # Период записи (сек)
+
+air_temp = 20.0
+material_temp = 20.0
+pressure = 101325.0
+humidity = 45.0
+
+try:
+    while True:
+        # медленный случайный дрейф условий
+        air_temp += random.gauss(0.0, 0.02)
+        material_temp += 0.2 * (air_temp - material_temp) + random.gauss(0.0, 0.005)
+        pressure += random.gauss(0.0, 5.0)
+        humidity = min(100.0, max(0.0, humidity + random.gauss(0.0, 0.2)))
+        data = {
+            "air_temp": round(air_temp, 3),
+            "pressure": round(pressure, 1),
+            "humidity": round(humidity, 1),
+            "material_temp": round(material_temp, 3),
+        }
+        with open(path, "a") as f:
+            f.write(json.dumps(data) + "\n")
+        time.sleep(interval)
+except KeyboardInterrupt:
+    pass
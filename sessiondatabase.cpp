@@ -0,0 +1,348 @@
+#include "sessiondatabase.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const int kSchemaVersion = 1;
+
+// NaN в SQLite — NULL
+QVariant real(double v)
+{
+    return std::isnan(v) ? QVariant() : QVariant(v);
+}
+
+double realOr(const QVariant& v, double fallback)
+{
+    return v.isNull() ? fallback : v.toDouble();
+}
+
+} // namespace
+
+SessionDatabase::SessionDatabase(const QString& connectionName)
+    : m_connection(connectionName)
+{
+}
+
+SessionDatabase::~SessionDatabase()
+{
+    close();
+}
+
+bool SessionDatabase::open(const QString& path, QString* error)
+{
+    close();
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", m_connection);
+        db.setDatabaseName(path);
+        if (!db.open()) {
+            if (error) *error = db.lastError().text();
+            return false;
+        }
+
+        // WAL: чтение истории не мешает записи; synchronous=NORMAL достаточно при WAL
+        QSqlQuery q(db);
+        q.exec("PRAGMA journal_mode = WAL");
+        q.exec("PRAGMA synchronous = NORMAL");
+        q.exec("PRAGMA foreign_keys = ON");
+    }
+
+    if (!createSchema(error)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void SessionDatabase::close()
+{
+    if (!QSqlDatabase::contains(m_connection))
+        return;
+    {
+        QSqlDatabase db = QSqlDatabase::database(m_connection, false);
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(m_connection);   // после того, как все копии db вышли из области
+}
+
+bool SessionDatabase::isOpen() const
+{
+    return QSqlDatabase::contains(m_connection) && QSqlDatabase::database(m_connection, false).isOpen();
+}
+
+bool SessionDatabase::createSchema(QString* error)
+{
+    QSqlDatabase db = QSqlDatabase::database(m_connection);
+    QSqlQuery q(db);
+
+    q.exec("PRAGMA user_version");
+    const int version = q.next() ? q.value(0).toInt() : 0;
+    if (version == kSchemaVersion)
+        return true;
+    if (version > kSchemaVersion) {
+        if (error) *error = QString("База создана более новой версией программы (схема %1).").arg(version);
+        return false;
+    }
+
+    const QStringList ddl = {
+        "CREATE TABLE IF NOT EXISTS machines ("
+        " id INTEGER PRIMARY KEY,"
+        " name TEXT NOT NULL UNIQUE)",
+
+        "CREATE TABLE IF NOT EXISTS axes ("
+        " id INTEGER PRIMARY KEY,"
+        " machine_id INTEGER NOT NULL REFERENCES machines(id),"
+        " name TEXT NOT NULL,"
+        " UNIQUE (machine_id, name))",
+
+        // итоги ISO 230-2 по худшей группе — прямо в строке сессии, для истории без соединения с results
+        "CREATE TABLE IF NOT EXISTS sessions ("
+        " id INTEGER PRIMARY KEY,"
+        " axis_id INTEGER NOT NULL REFERENCES axes(id),"
+        " started_at INTEGER NOT NULL,"
+        " note TEXT,"
+        " step_mode INTEGER, base REAL, step REAL, step_count INTEGER, repeat_count INTEGER,"
+        " bidirectional INTEGER, manual_text TEXT, formula TEXT, formula_count INTEGER,"
+        " positioning_accuracy REAL, mean_range REAL, systematic_error REAL, repeatability REAL)",
+
+        "CREATE INDEX IF NOT EXISTS sessions_axis_time ON sessions (axis_id, started_at)",
+
+        "CREATE TABLE IF NOT EXISTS measurements ("
+        " session_id INTEGER NOT NULL REFERENCES sessions(id) ON DELETE CASCADE,"
+        " row_no INTEGER NOT NULL,"
+        " group_no INTEGER NOT NULL, group_id INTEGER, series_no INTEGER NOT NULL,"
+        " step INTEGER NOT NULL, direction INTEGER NOT NULL, repeat_index INTEGER,"
+        " raw REAL, distance REAL, expected REAL, deviation REAL,"
+        " PRIMARY KEY (session_id, row_no)) WITHOUT ROWID",
+
+        // step = -1 — интегральная строка группы
+        "CREATE TABLE IF NOT EXISTS results ("
+        " session_id INTEGER NOT NULL REFERENCES sessions(id) ON DELETE CASCADE,"
+        " group_no INTEGER NOT NULL,"
+        " step INTEGER NOT NULL,"
+        " expected REAL, mean_forward REAL, mean_backward REAL, mean_bidirectional REAL,"
+        " reversal_error REAL, stddev_forward REAL, stddev_backward REAL,"
+        " repeatability_forward REAL, repeatability_backward REAL, repeatability_bidirectional REAL,"
+        " systematic_error REAL, mean_range REAL, positioning_accuracy REAL,"
+        " PRIMARY KEY (session_id, group_no, step)) WITHOUT ROWID",
+
+        QString("PRAGMA user_version = %1").arg(kSchemaVersion)
+    };
+
+    db.transaction();
+    for (const QString& sql : ddl) {
+        if (!q.exec(sql)) {
+            if (error) *error = q.lastError().text();
+            db.rollback();
+            return false;
+        }
+    }
+    return db.commit();
+}
+
+qint64 SessionDatabase::ensureId(const QString& select, const QString& insert, const QVariantList& keys)
+{
+    QSqlDatabase db = QSqlDatabase::database(m_connection);
+    QSqlQuery q(db);
+
+    q.prepare(select);
+    for (int i = 0; i < keys.size(); ++i) q.bindValue(i, keys[i]);
+    if (q.exec() && q.next())
+        return q.value(0).toLongLong();
+
+    q.prepare(insert);
+    for (int i = 0; i < keys.size(); ++i) q.bindValue(i, keys[i]);
+    if (!q.exec())
+        return -1;
+    return q.lastInsertId().toLongLong();
+}
+
+qint64 SessionDatabase::saveSession(const SessionInfo& info,
+                                    const MeasurementSnapshot& data,
+                                    const AccuracyResultList& results,
+                                    QString* error)
+{
+    QSqlDatabase db = QSqlDatabase::database(m_connection);
+    auto fail = [&db, error](const QSqlQuery& q) -> qint64 {
+        if (error) *error = q.lastError().text();
+        db.rollback();
+        return -1;
+    };
+
+    if (!db.transaction()) {
+        if (error) *error = db.lastError().text();
+        return -1;
+    }
+
+    const qint64 machineId = ensureId("SELECT id FROM machines WHERE name = ?",
+                                      "INSERT INTO machines (name) VALUES (?)",
+                                      { info.machine });
+    const qint64 axisId = machineId < 0 ? -1
+                        : ensureId("SELECT id FROM axes WHERE machine_id = ? AND name = ?",
+                                   "INSERT INTO axes (machine_id, name) VALUES (?, ?)",
+                                   { machineId, info.axis });
+    if (axisId < 0) {
+        if (error) *error = db.lastError().text();
+        db.rollback();
+        return -1;
+    }
+
+    // итоги сессии: худшая группа по каждому показателю (NaN однонаправленных групп не учитывается)
+    HistoryPoint total;
+    for (const auto& r : results) {
+        if (r.stepNumber != -1) continue;
+        total.positioningAccuracy = std::max(total.positioningAccuracy, r.positioningAccuracy);
+        total.meanRange           = std::max(total.meanRange, r.meanRange);
+        total.systematicError     = std::max(total.systematicError, r.systematicError);
+        total.repeatability       = std::max(total.repeatability, r.repeatabilityBidirectional);
+    }
+
+    const StepSettings& st = data.stepSettings();
+    QSqlQuery q(db);
+    q.prepare("INSERT INTO sessions (axis_id, started_at, note, step_mode, base, step, step_count,"
+              " repeat_count, bidirectional, manual_text, formula, formula_count,"
+              " positioning_accuracy, mean_range, systematic_error, repeatability)"
+              " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    const QVariantList sessionValues = {
+        axisId, info.startedAt.toMSecsSinceEpoch(), info.note,
+        int(st.mode), st.base, st.step, st.count, st.repeatCount, st.bidirectional ? 1 : 0,
+        st.manualText, st.formula, st.formulaCount,
+        total.positioningAccuracy, total.meanRange, total.systematicError, total.repeatability
+    };
+    for (int i = 0; i < sessionValues.size(); ++i) q.bindValue(i, sessionValues[i]);
+    if (!q.exec())
+        return fail(q);
+    const qint64 sessionId = q.lastInsertId().toLongLong();
+
+    // измерения: один подготовленный запрос на всю сессию, только перепривязка значений
+    QSqlQuery m(db);
+    m.prepare("INSERT INTO measurements (session_id, row_no, group_no, group_id, series_no, step,"
+              " direction, repeat_index, raw, distance, expected, deviation)"
+              " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    m.bindValue(0, sessionId);
+    int rowNo = 0;
+    int seriesNo = 0;
+    for (int g = 0; g < data.groupCount(); ++g) {
+        const MeasurementColumns& c = data.group(g);
+        m.bindValue(2, g);
+        m.bindValue(3, c.groupId[0]);
+        for (int s = 0; s < c.seriesCount(); ++s, ++seriesNo) {
+            m.bindValue(4, seriesNo);
+            m.bindValue(5, c.seriesStep[s]);
+            m.bindValue(6, int(c.seriesDirection[s]));
+            for (int i = c.seriesBegin(s); i < c.seriesEnd(s); ++i) {
+                m.bindValue(1, rowNo++);
+                m.bindValue(7, c.repeatIndex[i]);
+                m.bindValue(8, real(c.raw[i]));
+                m.bindValue(9, real(c.distance[i]));
+                m.bindValue(10, real(c.expected[i]));
+                m.bindValue(11, real(c.deviation[i]));
+                if (!m.exec())
+                    return fail(m);
+            }
+        }
+    }
+
+    // результаты: порядковый номер группы растёт после каждой интегральной строки
+    QSqlQuery r(db);
+    r.prepare("INSERT INTO results (session_id, group_no, step, expected, mean_forward, mean_backward,"
+              " mean_bidirectional, reversal_error, stddev_forward, stddev_backward,"
+              " repeatability_forward, repeatability_backward, repeatability_bidirectional,"
+              " systematic_error, mean_range, positioning_accuracy)"
+              " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    r.bindValue(0, sessionId);
+    int groupNo = 0;
+    for (const auto& res : results) {
+        r.bindValue(1, groupNo);
+        r.bindValue(2, res.stepNumber);
+        r.bindValue(3, real(res.expectedPosition));
+        r.bindValue(4, real(res.meanForward));
+        r.bindValue(5, real(res.meanBackward));
+        r.bindValue(6, real(res.meanBidirectional));
+        r.bindValue(7, real(res.reversalError));
+        r.bindValue(8, real(res.stddevForward));
+        r.bindValue(9, real(res.stddevBackward));
+        r.bindValue(10, real(res.repeatabilityForward));
+        r.bindValue(11, real(res.repeatabilityBackward));
+        r.bindValue(12, real(res.repeatabilityBidirectional));
+        r.bindValue(13, real(res.systematicError));
+        r.bindValue(14, real(res.meanRange));
+        r.bindValue(15, real(res.positioningAccuracy));
+        if (!r.exec())
+            return fail(r);
+        if (res.stepNumber == -1)
+            ++groupNo;
+    }
+
+    if (!db.commit()) {
+        if (error) *error = db.lastError().text();
+        db.rollback();
+        return -1;
+    }
+    return sessionId;
+}
+
+QVector<SessionDatabase::HistoryPoint> SessionDatabase::history(const QString& machine,
+                                                                const QString& axis,
+                                                                const QDateTime& from,
+                                                                const QDateTime& to,
+                                                                QString* error) const
+{
+    QVector<HistoryPoint> out;
+    QSqlQuery q(QSqlDatabase::database(m_connection));
+    q.setForwardOnly(true);
+
+    // ось находится по UNIQUE (machine_id, name), дальше — диапазон по индексу (axis_id, started_at)
+    q.prepare("SELECT s.id, s.started_at, s.positioning_accuracy, s.mean_range,"
+              " s.systematic_error, s.repeatability"
+              " FROM sessions s"
+              " JOIN axes a ON a.id = s.axis_id"
+              " JOIN machines m ON m.id = a.machine_id"
+              " WHERE m.name = ? AND a.name = ? AND s.started_at BETWEEN ? AND ?"
+              " ORDER BY s.started_at");
+    q.bindValue(0, machine);
+    q.bindValue(1, axis);
+    q.bindValue(2, from.toMSecsSinceEpoch());
+    q.bindValue(3, to.toMSecsSinceEpoch());
+    if (!q.exec()) {
+        if (error) *error = q.lastError().text();
+        return out;
+    }
+
+    while (q.next()) {
+        HistoryPoint p;
+        p.sessionId           = q.value(0).toLongLong();
+        p.startedAt           = QDateTime::fromMSecsSinceEpoch(q.value(1).toLongLong());
+        p.positioningAccuracy = realOr(q.value(2), 0.0);
+        p.meanRange           = realOr(q.value(3), 0.0);
+        p.systematicError     = realOr(q.value(4), 0.0);
+        p.repeatability       = realOr(q.value(5), 0.0);
+        out.append(p);
+    }
+    return out;
+}
+
+QStringList SessionDatabase::machines() const
+{
+    QStringList out;
+    QSqlQuery q(QSqlDatabase::database(m_connection));
+    if (q.exec("SELECT name FROM machines ORDER BY name"))
+        while (q.next()) out << q.value(0).toString();
+    return out;
+}
+
+QStringList SessionDatabase::axes(const QString& machine) const
+{
+    QStringList out;
+    QSqlQuery q(QSqlDatabase::database(m_connection));
+    q.prepare("SELECT a.name FROM axes a JOIN machines m ON m.id = a.machine_id"
+              " WHERE m.name = ? ORDER BY a.name");
+    q.bindValue(0, machine);
+    if (q.exec())
+        while (q.next()) out << q.value(0).toString();
+    return out;
+}
@@ -0,0 +1,67 @@
+#ifndef SESSIONDATABASE_H
+#define SESSIONDATABASE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QDateTime>
+#include <QVariant>
+#include "measurementsnapshot.h"
+#include "accuracy/accuracycalculator.h"
+
+// База истории калибровок (SQLite через QtSql): станки, оси, сессии, измерения
+// и результаты ISO 230-2. Итоги сессии (A, M, B, R) лежат прямо в sessions
+// с индексом (ось, время), поэтому история оси за годы читается одним проходом
+// по индексу. Сессия пишется одной транзакцией подготовленными запросами.
+class SessionDatabase
+{
+public:
+    // что записываем вместе с данными
+    struct SessionInfo {
+        QString   machine;                                  // станок
+        QString   axis;                                     // ось
+        QDateTime startedAt = QDateTime::currentDateTime(); // время сессии
+        QString   note;                                     // примечание
+    };
+
+    // одна точка истории оси
+    struct HistoryPoint {
+        qint64    sessionId = -1;
+        QDateTime startedAt;
+        double positioningAccuracy = 0.0;                   // A (худшая группа сессии)
+        double meanRange = 0.0;                             // M
+        double systematicError = 0.0;                       // B
+        double repeatability = 0.0;                         // Rmax
+    };
+
+    explicit SessionDatabase(const QString& connectionName = QStringLiteral("calibrix-history"));
+    ~SessionDatabase();
+
+    bool open(const QString& path, QString* error = nullptr); // открыть/создать файл базы
+    void close();
+    bool isOpen() const;
+
+    // записать сессию целиком; возвращает id сессии или -1
+    qint64 saveSession(const SessionInfo& info,
+                       const MeasurementSnapshot& data,
+                       const AccuracyResultList& results,
+                       QString* error = nullptr);
+
+    // итоги сессий оси за период, по времени
+    QVector<HistoryPoint> history(const QString& machine,
+                                  const QString& axis,
+                                  const QDateTime& from,
+                                  const QDateTime& to,
+                                  QString* error = nullptr) const;
+
+    QStringList machines() const;                           // все станки
+    QStringList axes(const QString& machine) const;         // оси станка
+
+private:
+    bool createSchema(QString* error);
+    qint64 ensureId(const QString& select, const QString& insert, const QVariantList& keys); // найти или добавить
+
+    QString m_connection;                                   // имя соединения QSqlDatabase
+};
+
+#endif // SESSIONDATABASE_H
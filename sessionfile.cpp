@@ -0,0 +1,324 @@
+#include "sessionfile.h"
+#include "binaryio.h"
+#include <QSaveFile>
+#include <cstring>
+
+using namespace BinaryIO;
+
+namespace {
+
+const char    kMagic[4]    = { 'C', 'B', 'X', 'S' };
+const quint32 kVersion     = 1;
+const int     kHeaderSize  = 16;        // магия, версия, число секций, резерв
+const int     kSectionSize = 24;        // id, резерв, смещение, размер
+const int     kAlign       = 8;         // выравнивание секций (double без невыровненного доступа)
+
+// секция при записи: набор кусков, которые пишутся подряд без склейки в памяти
+struct OutSection {
+    quint32 id = 0;
+    QVector<QByteArray> parts;
+    quint64 size() const { quint64 n = 0; for (const auto& p : parts) n += p.size(); return n; }
+};
+
+template <typename T>
+QByteArray rawView(const QVector<T>& v)
+{
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(v.constData()), v.size() * int(sizeof(T)));
+}
+
+template <typename E>
+QVector<qint32> toInt32(const QVector<E>& v)
+{
+    QVector<qint32> out(v.size());
+    for (int i = 0; i < v.size(); ++i) out[i] = qint32(v[i]);
+    return out;
+}
+
+// колонка-перечисление с диска: неизвестное значение — ok = false
+template <typename E>
+QVector<E> fromInt32(const QVector<qint32>& v, bool& ok)
+{
+    QVector<E> out(v.size());
+    for (int i = 0; i < v.size(); ++i) {
+        if (!isKnownEnum<E>(v[i])) { ok = false; return {}; }
+        out[i] = E(v[i]);
+    }
+    return out;
+}
+
+quint64 aligned(quint64 x) { return (x + kAlign - 1) / kAlign * kAlign; }
+
+} // namespace
+
+bool SessionFile::save(const QString& path,
+                       const DataMeasurement& measurement,
+                       const AutoSaveSettings& autoSettings,
+                       bool withRaw,
+                       QString* error)
+{
+    const MeasurementColumns& c = measurement.columns();
+    const RawRecordStore& raw = measurement.rawRecords();
+
+    // колонки-перечисления на диске — int32; временные массивы живут до конца записи
+    const QVector<qint32> seriesDir   = toInt32(c.seriesDirection);
+    const QVector<qint32> groupMode   = toInt32(c.groupMode);
+    const QVector<qint32> groupType   = toInt32(c.groupType);
+    const QVector<qint32> groupSel    = toInt32(c.groupSelected);
+
+    QByteArray settings;
+    putStepSettings(settings, measurement.stepSettings());
+    putAutoSaveSettings(settings, autoSettings);
+
+    QVector<OutSection> sections;
+    auto add = [&sections](SectionId id, const QByteArray& data) {
+        OutSection s;
+        s.id = quint32(id);
+        s.parts.append(data);
+        sections.append(s);
+    };
+    add(SectionId::Settings,        settings);
+    add(SectionId::RowRaw,          rawView(c.raw));
+    add(SectionId::RowDistance,     rawView(c.distance));
+    add(SectionId::RowExpected,     rawView(c.expected));
+    add(SectionId::RowDeviation,    rawView(c.deviation));
+    add(SectionId::RowRepeat,       rawView(c.repeatIndex));
+    add(SectionId::RowRawIndex,     rawView(c.rawIndex));
+    add(SectionId::RowTime,         rawView(c.timeMs));
+    add(SectionId::RowDrift,        rawView(c.drift));
+    add(SectionId::SeriesOffset,    rawView(c.seriesOffset));
+    add(SectionId::SeriesStep,      rawView(c.seriesStep));
+    add(SectionId::SeriesDirection, rawView(seriesDir));
+    add(SectionId::SeriesGroup,     rawView(c.seriesGroup));
+    add(SectionId::GroupOffset,     rawView(c.groupOffset));
+    add(SectionId::GroupId,         rawView(c.groupId));
+    add(SectionId::GroupMode,       rawView(groupMode));
+    add(SectionId::GroupType,       rawView(groupType));
+    add(SectionId::GroupSelected,   rawView(groupSel));
+
+    // сырые окна: таблица смещений (rawBytes + n + 1 смещений) и сами сжатые блоки как есть
+    if (withRaw && raw.size() > 0) {
+        QByteArray offsets;
+        put<qint64>(offsets, raw.rawBytes());
+        quint64 pos = 0;
+        OutSection blobs;
+        blobs.id = quint32(SectionId::RawBlobs);
+        for (int i = 0; i < raw.size(); ++i) {
+            put<quint64>(offsets, pos);
+            blobs.parts.append(raw.blob(i));
+            pos += raw.blob(i).size();
+        }
+        put<quint64>(offsets, pos);
+        add(SectionId::RawOffsets, offsets);
+        sections.append(blobs);
+    }
+
+    // раскладка: заголовок, таблица секций, секции по границе 8 байт
+    QByteArray header(kMagic, 4);
+    put<quint32>(header, kVersion);
+    put<quint32>(header, quint32(sections.size()));
+    put<quint32>(header, 0);
+
+    quint64 offset = aligned(kHeaderSize + quint64(sections.size()) * kSectionSize);
+    for (const auto& s : sections) {
+        put<quint32>(header, s.id);
+        put<quint32>(header, 0);
+        put<quint64>(header, offset);
+        put<quint64>(header, s.size());
+        offset = aligned(offset + s.size());
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+
+    quint64 written = 0;
+    auto pad = [&file, &written]() {
+        const quint64 target = aligned(written);
+        if (target > written) file.write(QByteArray(int(target - written), '\0'));
+        written = target;
+    };
+
+    file.write(header);
+    written += header.size();
+    for (const auto& s : sections) {
+        pad();
+        for (const auto& part : s.parts) {
+            file.write(part);
+            written += part.size();
+        }
+    }
+
+    if (!file.commit()) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool SessionFile::open(const QString& path, QString* error)
+{
+    close();
+
+    auto fail = [this, error](const QString& msg) {
+        if (error) *error = msg;
+        close();
+        return false;
+    };
+
+    m_file = std::make_shared<QFile>(path);
+    if (!m_file->open(QIODevice::ReadOnly))
+        return fail(m_file->errorString());
+
+    m_size = m_file->size();
+    if (m_size < kHeaderSize)
+        return fail("Файл слишком короткий.");
+
+    // отображаем весь файл: страницы читаются с диска только при обращении
+    m_data = m_file->map(0, m_size);
+    if (!m_data)
+        return fail("Не удалось отобразить файл в память.");
+
+    if (std::memcmp(m_data, kMagic, 4) != 0)
+        return fail("Это не файл сессии.");
+
+    Reader r{ reinterpret_cast<const char*>(m_data) + 4, reinterpret_cast<const char*>(m_data) + m_size };
+    const quint32 version = r.get<quint32>();
+    const quint32 count   = r.get<quint32>();
+    r.get<quint32>();
+    if (version != kVersion)
+        return fail(QString("Неподдерживаемая версия файла: %1.").arg(version));
+    if (quint64(kHeaderSize) + quint64(count) * kSectionSize > quint64(m_size))
+        return fail("Повреждена таблица секций.");
+
+    for (quint32 i = 0; i < count; ++i) {
+        Section s;
+        s.id       = r.get<quint32>();
+        s.reserved = r.get<quint32>();
+        s.offset   = r.get<quint64>();
+        s.size     = r.get<quint64>();
+        if (s.offset % kAlign != 0 || s.offset > quint64(m_size) || s.size > quint64(m_size) - s.offset)
+            return fail("Секция выходит за пределы файла.");
+        m_sections.append(s);
+    }
+
+    const Section* settings = section(SectionId::Settings);
+    if (!settings)
+        return fail("В файле нет настроек сессии.");
+    Reader sr{ reinterpret_cast<const char*>(m_data) + settings->offset,
+               reinterpret_cast<const char*>(m_data) + settings->offset + settings->size };
+    m_stepSettings = getStepSettings(sr);
+    m_autoSettings = getAutoSaveSettings(sr);
+    if (sr.badEnum)
+        return fail("Неизвестный режим шагов в настройках (файл повреждён или записан более новой версией).");
+    if (!sr.ok)
+        return fail("Повреждены настройки сессии.");
+
+    return true;
+}
+
+void SessionFile::close()
+{
+    m_file.reset();                     // отображение живёт, пока на файл ссылается RawRecordStore
+    m_data = nullptr;
+    m_size = 0;
+    m_sections.clear();
+}
+
+const SessionFile::Section* SessionFile::section(SectionId id) const
+{
+    for (const auto& s : m_sections)
+        if (s.id == quint32(id))
+            return &s;
+    return nullptr;
+}
+
+template <typename T>
+QVector<T> SessionFile::column(SectionId id) const
+{
+    const Section* s = section(id);
+    if (!s || s->size % sizeof(T) != 0)
+        return {};
+    QVector<T> v(static_cast<int>(s->size / sizeof(T)));
+    std::memcpy(v.data(), m_data + s->offset, s->size);
+    return v;
+}
+
+int SessionFile::rowCount() const
+{
+    const Section* s = section(SectionId::RowRaw);
+    return s ? int(s->size / sizeof(double)) : 0;
+}
+
+int SessionFile::rawCount() const
+{
+    const Section* s = section(SectionId::RawOffsets);
+    return s && s->size >= 2 * sizeof(quint64) ? int(s->size / sizeof(quint64)) - 2 : 0;
+}
+
+bool SessionFile::load(DataMeasurement& target, QString* error) const
+{
+    auto fail = [error](const QString& msg) {
+        if (error) *error = msg;
+        return false;
+    };
+    if (!isOpen())
+        return fail("Файл сессии не открыт.");
+
+    MeasurementColumns c;
+    c.raw          = column<double>(SectionId::RowRaw);
+    c.distance     = column<double>(SectionId::RowDistance);
+    c.expected     = column<double>(SectionId::RowExpected);
+    c.deviation    = column<double>(SectionId::RowDeviation);
+    c.repeatIndex  = column<int>(SectionId::RowRepeat);
+    c.rawIndex     = column<int>(SectionId::RowRawIndex);
+    c.timeMs       = column<qint64>(SectionId::RowTime);
+    c.drift        = column<double>(SectionId::RowDrift);
+    c.seriesOffset = column<int>(SectionId::SeriesOffset);
+    c.seriesStep   = column<int>(SectionId::SeriesStep);
+    bool known = true;
+    c.seriesDirection = fromInt32<ApproachDirection>(column<qint32>(SectionId::SeriesDirection), known);
+    c.seriesGroup  = column<int>(SectionId::SeriesGroup);
+    c.groupOffset  = column<int>(SectionId::GroupOffset);
+    c.groupId      = column<int>(SectionId::GroupId);
+    c.groupMode    = fromInt32<StepMode>(column<qint32>(SectionId::GroupMode), known);
+    c.groupType    = fromInt32<MeasurementGroupType>(column<qint32>(SectionId::GroupType), known);
+    c.groupSelected = fromInt32<bool>(column<qint32>(SectionId::GroupSelected), known);
+    if (!known)
+        return fail("Неизвестное направление подхода или тип группы (файл повреждён или записан более новой версией).");
+
+    // согласованность колонок и таблиц смещений
+    const int rows = c.raw.size();
+    if (!section(SectionId::RowTime))  c.timeMs.fill(0, rows);  // файл без времени — время неизвестно
+    if (!section(SectionId::RowDrift)) c.drift.fill(0.0, rows); // и без поправок
+    if (!c.isConsistent())
+        return fail("Колонки сессии не согласованы.");
+
+    // сырые окна — ссылки в отображённый файл, без копирования
+    RawRecordStore raw;
+    const Section* offs  = section(SectionId::RawOffsets);
+    const Section* blobs = section(SectionId::RawBlobs);
+    if (offs && blobs && offs->size >= 2 * sizeof(quint64)) {
+        const uchar* o = m_data + offs->offset;
+        qint64 rawBytes = 0;
+        std::memcpy(&rawBytes, o, sizeof(rawBytes));
+        const int n = int(offs->size / sizeof(quint64)) - 2;
+
+        QVector<quint64> pos(n + 1);
+        std::memcpy(pos.data(), o + sizeof(qint64), size_t(n + 1) * sizeof(quint64));
+
+        QVector<QByteArray> windows;
+        windows.reserve(n);
+        const char* base = reinterpret_cast<const char*>(m_data + blobs->offset);
+        for (int i = 0; i < n; ++i) {
+            if (pos[i] > pos[i + 1] || pos[i + 1] > blobs->size)
+                return fail("Сырые окна выходят за пределы секции.");
+            windows.append(QByteArray::fromRawData(base + pos[i], int(pos[i + 1] - pos[i])));
+        }
+        raw.adoptMapped(windows, rawBytes, m_file);
+    }
+
+    target.load(m_stepSettings, c, raw);
+    return true;
+}
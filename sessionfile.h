@@ -0,0 +1,66 @@
+#ifndef SESSIONFILE_H
+#define SESSIONFILE_H
+
+#include <QString>
+#include <QVector>
+#include <QFile>
+#include <memory>
+#include "datameasurement.h"
+#include "settingsmanager.h"
+
+// Файл сессии .cbx: заголовок, таблица секций и выровненные по 8 байт секции-колонки
+// (те же массивы, что в MeasurementColumns), плюс необязательные сжатые сырые окна.
+// Открытие отображает файл в память и читает только заголовок; колонки копируются
+// при load(), а сырые окна остаются в отображении и подгружаются с диска при обращении.
+class SessionFile
+{
+public:
+    SessionFile() = default;
+
+    // записать сессию; withRaw — сохранять ли сырые окна
+    static bool save(const QString& path,
+                     const DataMeasurement& measurement,
+                     const AutoSaveSettings& autoSettings,
+                     bool withRaw,
+                     QString* error = nullptr);
+
+    bool open(const QString& path, QString* error = nullptr); // отобразить и проверить заголовок
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    StepSettings stepSettings() const { return m_stepSettings; }
+    AutoSaveSettings autoSaveSettings() const { return m_autoSettings; }
+    int rowCount() const;                                   // измерений в файле
+    int rawCount() const;                                   // сырых окон в файле
+
+    bool load(DataMeasurement& target, QString* error = nullptr) const; // перенести сессию в target
+
+private:
+    enum class SectionId : quint32 {
+        Settings = 1,
+        RowRaw, RowDistance, RowExpected, RowDeviation, RowRepeat, RowRawIndex,
+        SeriesOffset, SeriesStep, SeriesDirection, SeriesGroup,
+        GroupOffset, GroupId, GroupMode, GroupType, GroupSelected,
+        RawOffsets, RawBlobs,
+        RowTime, RowDrift                                   // необязательные: в старых файлах их нет
+    };
+
+    struct Section {
+        quint32 id = 0;
+        quint32 reserved = 0;
+        quint64 offset = 0;
+        quint64 size = 0;
+    };
+
+    const Section* section(SectionId id) const;
+    template <typename T> QVector<T> column(SectionId id) const; // копия секции как массива
+
+    std::shared_ptr<QFile> m_file;                          // держит отображение живым
+    const uchar* m_data = nullptr;
+    qint64 m_size = 0;
+    QVector<Section> m_sections;
+    StepSettings m_stepSettings{};
+    AutoSaveSettings m_autoSettings{};
+};
+
+#endif // SESSIONFILE_H
@@ -0,0 +1,440 @@
+#include "sessionjournal.h"
+#include "binaryio.h"
+#include <cstring>                      // memcpy
+
+#ifdef Q_OS_WIN
+#include <io.h>                         // _commit
+#else
+#include <unistd.h>                     // fsync
+#endif
+
+namespace {
+
+const char   kMagic[4]   = { 'C', 'B', 'X', 'J' };
+const quint32 kVersion   = 1;
+const int    kHeaderSize = 8;           // магия + версия
+const int    kFrameSize  = 4 + 1 + 4;   // длина + тип + CRC вокруг данных
+
+// CRC-32 (IEEE 802.3), slicing-by-8: восемь таблиц, по 8 байт за шаг
+quint32 crc32(const char* data, int size, quint32 crc = 0)
+{
+    static const auto table = [] {
+        QVector<quint32> t(8 * 256);
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            t[int(i)] = c;
+        }
+        for (int i = 0; i < 256; ++i)
+            for (int k = 1; k < 8; ++k)
+                t[k * 256 + i] = (t[(k - 1) * 256 + i] >> 8) ^ t[int(t[(k - 1) * 256 + i] & 0xFF)];
+        return t;
+    }();
+    const quint32* t = table.constData();
+    const uchar* p = reinterpret_cast<const uchar*>(data);
+
+    crc = ~crc;
+    for (; size >= 8; size -= 8, p += 8) {
+        const quint32 lo = crc ^ (quint32(p[0]) | quint32(p[1]) << 8 | quint32(p[2]) << 16 | quint32(p[3]) << 24);
+        crc = t[7 * 256 + (lo & 0xFF)]         ^ t[6 * 256 + ((lo >> 8) & 0xFF)]
+            ^ t[5 * 256 + ((lo >> 16) & 0xFF)] ^ t[4 * 256 + (lo >> 24)]
+            ^ t[3 * 256 + p[4]] ^ t[2 * 256 + p[5]]
+            ^ t[1 * 256 + p[6]] ^ t[p[7]];
+    }
+    for (; size > 0; --size, ++p)
+        crc = t[(crc ^ *p) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// колонка как есть: число элементов и байты (перечисления — через int32)
+template <typename T>
+void putColumn(QByteArray& out, const QVector<T>& v)
+{
+    BinaryIO::put<quint32>(out, quint32(v.size()));
+    out.append(reinterpret_cast<const char*>(v.constData()), v.size() * int(sizeof(T)));
+}
+
+template <typename E>
+void putEnumColumn(QByteArray& out, const QVector<E>& v)
+{
+    QVector<qint32> tmp(v.size());
+    for (int i = 0; i < v.size(); ++i) tmp[i] = qint32(v[i]);
+    putColumn(out, tmp);
+}
+
+template <typename T>
+QVector<T> getColumn(BinaryIO::Reader& r)
+{
+    const quint32 n = r.get<quint32>();
+    if (!r.ok || quint64(r.end - r.p) < quint64(n) * sizeof(T)) { r.ok = false; return {}; }
+    QVector<T> v(static_cast<int>(n));
+    std::memcpy(v.data(), r.p, n * sizeof(T));
+    r.p += n * sizeof(T);
+    return v;
+}
+
+// колонка-перечисление: неизвестное значение отвергает всю запись
+template <typename E>
+QVector<E> getEnumColumn(BinaryIO::Reader& r)
+{
+    const QVector<qint32> tmp = getColumn<qint32>(r);
+    QVector<E> v(tmp.size());
+    for (int i = 0; i < tmp.size(); ++i) {
+        if (!BinaryIO::isKnownEnum<E>(tmp[i])) { r.ok = false; r.badEnum = true; return {}; }
+        v[i] = E(tmp[i]);
+    }
+    return v;
+}
+
+} // namespace
+
+using namespace BinaryIO;
+
+SessionJournal::SessionJournal(const QString& path, QObject* parent)
+    : QObject(parent)
+    , m_file(path)
+{
+    m_syncTimer.setSingleShot(true);
+    m_syncTimer.setInterval(1000);
+    connect(&m_syncTimer, &QTimer::timeout, this, &SessionJournal::sync);
+}
+
+SessionJournal::~SessionJournal()
+{
+    sync();
+}
+
+bool SessionJournal::open()
+{
+    if (m_file.isOpen())
+        return true;
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Append))
+        return false;
+    if (m_file.size() < kHeaderSize)
+        return writeHeader();
+    return true;
+}
+
+bool SessionJournal::hasRecords() const
+{
+    return QFile(m_file.fileName()).size() > kHeaderSize;
+}
+
+bool SessionJournal::writeHeader()
+{
+    QByteArray header(kMagic, 4);
+    put<quint32>(header, kVersion);
+    if (m_file.write(header) != header.size())
+        return false;
+    m_file.flush();
+    sync();
+    return true;
+}
+
+void SessionJournal::reset()
+{
+    if (!m_file.isOpen() && !open())
+        return;
+    m_syncTimer.stop();
+    m_pending = 0;
+    m_file.resize(0);
+    writeHeader();
+}
+
+void SessionJournal::sync()
+{
+    m_syncTimer.stop();
+    if (!m_file.isOpen() || m_pending == 0)
+        return;
+
+    m_file.flush();
+#ifdef Q_OS_WIN
+    _commit(m_file.handle());
+#else
+    ::fsync(m_file.handle());
+#endif
+    m_pending = 0;
+}
+
+void SessionJournal::write(RecordType type, const QByteArray& payload)
+{
+    if (!m_file.isOpen())
+        return;
+
+    // длина | тип | данные | CRC(тип + данные) — одним вызовом write
+    QByteArray frame;
+    frame.reserve(kFrameSize + payload.size());
+    put<quint32>(frame, quint32(payload.size()));
+    put<quint8>(frame, quint8(type));
+    frame.append(payload);
+    put<quint32>(frame, crc32(frame.constData() + 4, 1 + payload.size()));
+
+    m_file.write(frame);
+    m_file.flush();                     // в кэш ОС сразу: падение процесса записи не теряет
+
+    // fsync пачками: по числу записей или по таймеру
+    if (++m_pending >= m_syncBatch)
+        sync();
+    else if (!m_syncTimer.isActive())
+        m_syncTimer.start();
+}
+
+void SessionJournal::recordAdd(double value, const QVector<double>& rawWindow, qint64 timeMs)
+{
+    QByteArray p;
+    p.reserve(int(sizeof(double) + sizeof(quint32) + sizeof(qint64)) + rawWindow.size() * int(sizeof(double)));
+    put<double>(p, value);
+    putDoubles(p, rawWindow);
+    put<qint64>(p, timeMs);                                 // время — в хвосте (старые записи без него)
+    write(RecordType::Add, p);
+}
+
+void SessionJournal::recordStepSettings(const StepSettings& s)
+{
+    QByteArray p;
+    putStepSettings(p, s);
+    write(RecordType::StepSettings, p);
+}
+
+void SessionJournal::recordState(const DataMeasurement& measurement)
+{
+    const MeasurementColumns& c = measurement.columns();
+    const RawRecordStore& raw = measurement.rawRecords();
+    const MeasurementSnapshot::Cursor cursor = measurement.cursor();
+
+    QByteArray p;
+    putStepSettings(p, measurement.stepSettings());
+
+    // конвейер add: следующее сохранение продолжит тот же шаг и повтор
+    put<qint32>(p, cursor.currentStep);
+    put<qint32>(p, cursor.currentRepeat);
+    put<qint32>(p, cursor.groupIdCounter);
+    put<quint8>(p, cursor.stepStructureChanged ? 1 : 0);
+
+    // колонки в раскладке файла .cbx
+    putColumn(p, c.raw);
+    putColumn(p, c.distance);
+    putColumn(p, c.expected);
+    putColumn(p, c.deviation);
+    putColumn(p, c.repeatIndex);
+    putColumn(p, c.rawIndex);
+    putColumn(p, c.timeMs);
+    putColumn(p, c.drift);
+    putColumn(p, c.seriesOffset);
+    putColumn(p, c.seriesStep);
+    putEnumColumn(p, c.seriesDirection);
+    putColumn(p, c.seriesGroup);
+    putColumn(p, c.groupOffset);
+    putColumn(p, c.groupId);
+    putEnumColumn(p, c.groupMode);
+    putEnumColumn(p, c.groupType);
+    putEnumColumn(p, c.groupSelected);
+
+    // сырые окна — сжатые блоки как есть, чтобы rawIndex строк указывал туда же
+    put<qint64>(p, raw.rawBytes());
+    put<quint32>(p, quint32(raw.size()));
+    for (int i = 0; i < raw.size(); ++i) {
+        put<quint32>(p, quint32(raw.blob(i).size()));
+        p.append(raw.blob(i));
+    }
+    write(RecordType::State, p);
+}
+
+void SessionJournal::recordReevaluate(const QVector<double>& rawByIndex)
+{
+    QByteArray p;
+    putDoubles(p, rawByIndex);
+    write(RecordType::Reevaluate, p);
+}
+
+void SessionJournal::recordNewGroup()
+{
+    write(RecordType::NewGroup, QByteArray());
+}
+
+void SessionJournal::recordClear()
+{
+    // после clear прошлые записи ничего не восстанавливают — пустой журнал и есть clear
+    reset();
+}
+
+SessionJournal::ReplayResult SessionJournal::replay(DataMeasurement& target)
+{
+    ReplayResult result;
+
+    QFile in(m_file.fileName());
+    if (!in.open(QIODevice::ReadOnly))
+        return result;
+    const QByteArray data = in.readAll();
+    in.close();
+
+    if (data.size() < kHeaderSize || std::memcmp(data.constData(), kMagic, 4) != 0) {
+        result.tailDropped = !data.isEmpty();
+        reset();
+        return result;
+    }
+
+    const char* begin = data.constData();
+    const char* end   = begin + data.size();
+    const char* p     = begin + kHeaderSize;
+
+    while (end - p >= kFrameSize) {
+        quint32 size = 0;
+        std::memcpy(&size, p, sizeof(size));
+        if (quint64(end - p) < quint64(kFrameSize) + size)
+            break;                                          // недописанная запись
+
+        const char* body = p + 4;                           // тип + данные
+        quint32 crc = 0;
+        std::memcpy(&crc, body + 1 + size, sizeof(crc));
+        if (crc != crc32(body, int(1 + size)))
+            break;                                          // повреждённая запись
+
+        if (!apply(RecordType(quint8(*body)), body + 1, body + 1 + size, target, &result.error))
+            break;                                          // запись цела, но не читается — дальше не идём
+
+        p += kFrameSize + size;
+        ++result.records;
+    }
+
+    // всё после последней целой записи отрезаем, чтобы дозапись шла с чистого места
+    if (p != end) {
+        result.tailDropped = true;
+        if (m_file.isOpen())
+            m_file.resize(p - begin);
+        else
+            QFile::resize(m_file.fileName(), p - begin);
+    }
+    return result;
+}
+
+bool SessionJournal::apply(RecordType type, const char* p, const char* end, DataMeasurement& target,
+                           QString* error)
+{
+    Reader r{ p, end };
+    auto fail = [&r, error]() {
+        if (error)
+            *error = r.badEnum ? QString("запись журнала с неизвестным значением перечисления "
+                                         "(журнал повреждён или записан более новой версией)")
+                               : QString("запись журнала повреждена");
+        return false;
+    };
+
+    switch (type) {
+    case RecordType::Add: {
+        const double value = r.get<double>();
+        const QVector<double> window = r.getDoubles();
+        const qint64 timeMs = (r.end - r.p >= qint64(sizeof(qint64))) ? r.get<qint64>() : 0;
+        if (!r.ok) return fail();
+        target.add(value, window, timeMs);
+        return true;
+    }
+    case RecordType::StepSettings: {
+        const StepSettings s = getStepSettings(r);
+        if (!r.ok) return fail();
+        target.setStepSettings(s);
+        return true;
+    }
+    case RecordType::Groups: {
+        // счётчики проверяем по остатку записи, чтобы не выделять память под мусор
+        auto count = [&r](int minItemBytes) -> int {
+            const quint32 n = r.get<quint32>();
+            if (!r.ok || quint64(n) * quint64(minItemBytes) > quint64(r.end - r.p)) { r.ok = false; return 0; }
+            return int(n);
+        };
+
+        QVector<MeasurementGroup> groups(count(4 + 3 + 4));
+        if (!r.ok) return fail();
+        for (auto& g : groups) {
+            g.groupId     = r.get<qint32>();
+            g.mode        = r.getEnum<StepMode>();
+            g.type        = r.getEnum<MeasurementGroupType>();
+            g.selectedFor = r.get<quint8>() != 0;
+            g.steps.resize(count(4 + 1 + 4));
+            if (!r.ok) return fail();
+            for (auto& s : g.steps) {
+                s.stepNumber = r.get<qint32>();
+                s.direction  = r.getEnum<ApproachDirection>();
+                s.measurements.resize(count(4 + 4 * 8 + 4));
+                if (!r.ok) return fail();
+                for (auto& m : s.measurements) {
+                    m.repeatIndex = r.get<qint32>();
+                    m.raw         = r.get<double>();
+                    m.distance    = r.get<double>();
+                    m.expected    = r.get<double>();
+                    m.deviation   = r.get<double>();
+                    m.rawIndex    = r.get<qint32>();
+                }
+            }
+        }
+        if (!r.ok) return fail();
+        qint64 rows = 0;
+        for (const auto& g : groups)
+            for (const auto& s : g.steps) rows += s.measurements.size();
+        if (rows > 0 && r.end - r.p == rows * qint64(sizeof(qint64)))
+            for (auto& g : groups)
+                for (auto& s : g.steps)
+                    for (auto& m : s.measurements)
+                        m.timeMs = r.get<qint64>();
+        target.setGroups(groups);
+        return true;
+    }
+    case RecordType::State: {
+        const StepSettings settings = getStepSettings(r);
+        MeasurementSnapshot::Cursor cursor;
+        cursor.currentStep          = r.get<qint32>();
+        cursor.currentRepeat        = r.get<qint32>();
+        cursor.groupIdCounter       = r.get<qint32>();
+        cursor.stepStructureChanged = r.get<quint8>() != 0;
+
+        MeasurementColumns c;
+        c.raw             = getColumn<double>(r);
+        c.distance        = getColumn<double>(r);
+        c.expected        = getColumn<double>(r);
+        c.deviation       = getColumn<double>(r);
+        c.repeatIndex     = getColumn<int>(r);
+        c.rawIndex        = getColumn<int>(r);
+        c.timeMs          = getColumn<qint64>(r);
+        c.drift           = getColumn<double>(r);
+        c.seriesOffset    = getColumn<int>(r);
+        c.seriesStep      = getColumn<int>(r);
+        c.seriesDirection = getEnumColumn<ApproachDirection>(r);
+        c.seriesGroup     = getColumn<int>(r);
+        c.groupOffset     = getColumn<int>(r);
+        c.groupId         = getColumn<int>(r);
+        c.groupMode       = getEnumColumn<StepMode>(r);
+        c.groupType       = getEnumColumn<MeasurementGroupType>(r);
+        c.groupSelected   = getEnumColumn<bool>(r);
+        if (!r.ok || !c.isConsistent()) return fail();
+
+        const qint64 rawBytes = r.get<qint64>();
+        const quint32 windows = r.get<quint32>();
+        if (!r.ok || quint64(windows) * sizeof(quint32) > quint64(r.end - r.p)) return fail();
+        QVector<QByteArray> blobs;
+        blobs.reserve(int(windows));
+        for (quint32 i = 0; i < windows; ++i) {
+            const quint32 n = r.get<quint32>();
+            if (!r.ok || quint64(r.end - r.p) < n) return fail();
+            blobs.append(QByteArray(r.p, int(n)));
+            r.p += n;
+        }
+        RawRecordStore raw;
+        raw.adoptMapped(blobs, rawBytes, nullptr);          // свои копии — держать нечего
+
+        target.load(settings, c, raw, cursor);
+        return true;
+    }
+    case RecordType::Reevaluate: {
+        const QVector<double> values = r.getDoubles();
+        if (!r.ok) return fail();
+        target.reevaluateRaw(values);
+        return true;
+    }
+    case RecordType::NewGroup:
+        target.requestNewGroup();
+        return true;
+    }
+    if (error) *error = QString("неизвестный тип записи журнала %1").arg(int(type));
+    return false;                                           // запись более новой версии
+}
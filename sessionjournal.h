@@ -0,0 +1,63 @@
+#ifndef SESSIONJOURNAL_H
+#define SESSIONJOURNAL_H
+
+#include <QObject>
+#include <QFile>
+#include <QTimer>
+#include <QByteArray>
+#include "datameasurement.h"
+
+// Журнал сессии: append-only двоичный файл со всеми изменениями DataMeasurement
+// (add, setStepSettings, reevaluateRaw, clear и полное состояние после отката/открытия).
+// Каждая запись — длина, тип, данные и CRC-32; fsync выполняется пачками. После сбоя
+// журнал проигрывается в DataMeasurement, битый хвост (недописанная запись) отбрасывается.
+class SessionJournal : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct ReplayResult {
+        int  records = 0;          // применено записей
+        bool tailDropped = false;  // хвост повреждён и отрезан
+        QString error;             // почему отвергнута целая по CRC запись (пусто — не было)
+    };
+
+    explicit SessionJournal(const QString& path, QObject* parent = nullptr);
+    ~SessionJournal();
+
+    bool open();                                        // открыть на дозапись (создать при отсутствии)
+    bool hasRecords() const;                            // есть ли что восстанавливать
+    ReplayResult replay(DataMeasurement& target);       // проиграть журнал в target
+    void reset();                                       // начать журнал заново (пустой)
+
+    void recordAdd(double value, const QVector<double>& rawWindow, qint64 timeMs);
+    void recordStepSettings(const StepSettings& settings);
+    void recordState(const DataMeasurement& measurement);   // всё состояние: колонки, сырые окна, конвейер add
+    void recordReevaluate(const QVector<double>& rawByIndex);
+    void recordClear();                                 // всё до clear больше не нужно — журнал обнуляется
+    void recordNewGroup();                              // requestNewGroup: следующий add — в новую группу
+
+    void setSyncBatch(int records) { m_syncBatch = qMax(1, records); } // fsync каждые N записей
+    void setSyncInterval(int ms) { m_syncTimer.setInterval(ms); }     // и не реже, чем раз в ms
+
+    QString path() const { return m_file.fileName(); }
+
+public slots:
+    void sync();                                        // сбросить буферы на диск (fsync)
+
+private:
+    // Groups — только чтение старых журналов (без сырых окон и конвейера), пишется State
+    enum class RecordType : quint8 { Add = 1, StepSettings = 2, Groups = 3, Reevaluate = 4, State = 5, NewGroup = 6 };
+
+    void write(RecordType type, const QByteArray& payload); // записать одну запись
+    bool writeHeader();                                 // магия и версия формата
+    static bool apply(RecordType type, const char* p, const char* end, DataMeasurement& target,
+                      QString* error);                  // false — запись отвергнута, причина в error
+
+    QFile m_file;
+    QTimer m_syncTimer;
+    int m_pending = 0;                                  // записей после последнего fsync
+    int m_syncBatch = 64;
+};
+
+#endif // SESSIONJOURNAL_H
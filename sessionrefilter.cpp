@@ -0,0 +1,33 @@
+#include "sessionrefilter.h"
+#include "filter.h"
+#include <QtConcurrent>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+
+QVector<double> SessionRefilter::run(const RawRecordStore& store,
+                                     const std::function<Filter*()>& factory,
+                                     int bufferCapacity)
+{
+    QVector<int> indices(store.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    // окна независимы: каждый поток распаковывает своё окно и создаёт свой фильтр
+    return QtConcurrent::blockingMapped<QVector<double>>(indices, [&](int index) {
+        std::unique_ptr<Filter> filter(factory());
+        return replay(store.window(index), filter.get(), bufferCapacity);
+    });
+}
+
+double SessionRefilter::replay(const QVector<double>& samples, Filter* filter, int bufferCapacity)
+{
+    filter->clear();
+
+    // DataBuffer на каждый новый отсчёт присылал последние bufferCapacity значений
+    const int cap = std::max(1, bufferCapacity);
+    for (int i = 0; i < samples.size(); ++i) {
+        const int from = std::max(0, i + 1 - cap);
+        filter->processData(samples.mid(from, i + 1 - from));
+    }
+    return filter->result();
+}
@@ -0,0 +1,26 @@
+#ifndef SESSIONREFILTER_H
+#define SESSIONREFILTER_H
+
+#include <QVector>
+#include <functional>
+#include "rawrecordstore.h"
+
+class Filter;
+
+// Офлайн-пересчёт сессии: каждое сохранённое сырое окно заново прогоняется
+// через выбранный фильтр (или цепочку стадий) параллельно на всех ядрах
+class SessionRefilter
+{
+public:
+    // результат по индексу окна (Measurement::rawIndex);
+    // bufferCapacity — ёмкость DataBuffer, окна которого видел фильтр при записи
+    static QVector<double> run(const RawRecordStore& store,
+                               const std::function<Filter*()>& factory,
+                               int bufferCapacity);
+
+private:
+    // повтор одного окна: тот же порядок вызовов processData, что и в DataBuffer
+    static double replay(const QVector<double>& samples, Filter* filter, int bufferCapacity);
+};
+
+#endif // SESSIONREFILTER_H
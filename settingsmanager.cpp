@@ -15,6 +15,7 @@ void SettingsManager::registerFilter(const QString& name,
                                      std::function<Filter*()> factory)
 {
     m_filterFactories.insert(action, factory);
+    m_filterOrder.append(action);
     action->setActionGroup(m_filterGroup);
     action->setText(name);
     if (!m_defaultAction) {
@@ -33,6 +34,23 @@ Filter* SettingsManager::createInitialFilter(QObject* parent) const
     return nullptr;
 }
 
+QStringList SettingsManager::filterNames() const
+{
+    QStringList names;
+    for (QAction* action : m_filterOrder)
+        names << action->text();
+    return names;
+}
+
+std::function<Filter*()> SettingsManager::filterFactory(const QString& name) const
+{
+    for (QAction* action : m_filterOrder) {
+        if (action->text() == name)
+            return m_filterFactories.value(action);
+    }
+    return {};
+}
+
 void SettingsManager::setStepSettings(const StepSettings& settings)
 {
     m_stepSettings = settings;
@@ -60,6 +78,22 @@ void SettingsManager::setSaveTime(int seconds) {
     m_saveTime = seconds;
 }
 
+int SettingsManager::decimation() const {
+    return m_decimation;
+}
+
+void SettingsManager::setDecimation(int ratio) {
+    m_decimation = ratio;
+}
+
+double SettingsManager::smoothingCutoff() const {
+    return m_smoothingCutoff;
+}
+
+void SettingsManager::setSmoothingCutoff(double hz) {
+    m_smoothingCutoff = hz;
+}
+
 void SettingsManager::setAutoSaveSettings(const AutoSaveSettings& settings) {
     m_autoSaveSettings = settings;
 }
@@ -68,6 +102,22 @@ AutoSaveSettings SettingsManager::autoSaveSettings() const {
     return m_autoSaveSettings;
 }
 
+CycleSettings SettingsManager::cycleSettings() const {
+    return m_cycleSettings;
+}
+
+void SettingsManager::setCycleSettings(const CycleSettings& settings) {
+    m_cycleSettings = settings;
+}
+
+EnvironmentSettings SettingsManager::environmentSettings() const {
+    return m_environmentSettings;
+}
+
+void SettingsManager::setEnvironmentSettings(const EnvironmentSettings& settings) {
+    m_environmentSettings = settings;
+}
+
 
 
 
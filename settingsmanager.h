@@ -43,6 +43,36 @@ struct AutoSaveSettings {
     double speedLimit = 0.01;         // spin_speedLimit
 };
 
+// ——— Цикл ISO 230-2 для станка (оптимизатор плана и G-code) ———
+// ——— Слово выдержки G4 в программе цикла ———
+enum class DwellWord {
+    MillisecondsP,   // G4 P<мс> целым числом (Fanuc и совместимые: P — мс без точки)
+    SecondsX         // G4 X<с> с дробью
+};
+
+struct CycleSettings {
+    int cycles = 5;                   // циклов (ISO 230-2: не меньше 5)
+    double feedRate = 1000.0;         // рабочая подача подхода к точке, ед./мин
+    double rapidRate = 5000.0;        // ускоренный ход без измерения, ед./мин
+    double acceleration = 100.0;      // ускорение оси, ед./с²
+    double overshoot = 1.0;           // перебег при развороте (выборка люфта), ед.
+    double settleTime = 1.0;          // успокоение после остановки, с
+    double targetSigma = 0.0005;      // допустимая СКО среднего в точке, ед.
+    double machineOrigin = 0.0;       // координата станка, соответствующая базе
+    QString axis = "X";               // ось в G-code
+    DwellWord dwellWord = DwellWord::MillisecondsP; // как записать выдержку G4
+};
+
+// ——— Компенсация среды (лазерный интерферометр) ———
+struct EnvironmentSettings {
+    bool enabled = false;             // применять поправки к потоку
+    QString sourcePath;               // файл/канал с отсчётами среды (строки JSON)
+    double wavelengthNm = 632.991;    // длина волны лазера в вакууме, нм (He-Ne)
+    double instrumentIndex = 1.0;     // показатель преломления, заложенный в показания (1 — вакуум)
+    double expansionCoeff = 11.5e-6;  // ТКЛР материала, 1/К (сталь)
+    double expansionOrigin = 0.0;     // неподвижная точка расширения в координатах показаний
+};
+
 // ——— Менеджер ———
 class SettingsManager : public QObject {
     Q_OBJECT
@@ -53,6 +83,10 @@ public:
     void registerFilter(const QString& name, QAction* action, std::function<Filter*()> factory);
     Filter* createInitialFilter(QObject* parent = nullptr) const;
 
+    // ——— Зарегистрированные фильтры по имени (для офлайн-пересчёта) ———
+    QStringList filterNames() const;
+    std::function<Filter*()> filterFactory(const QString& name) const;
+
     // ——— Геттер/сеттер настроек автосохранения ———
     void setStepSettings(const StepSettings& settings);
     StepSettings stepSettings() const;
@@ -64,6 +98,18 @@ public:
     int saveTime() const;
     void setSaveTime(int seconds);
 
+    int decimation() const;
+    void setDecimation(int ratio);
+
+    double smoothingCutoff() const;
+    void setSmoothingCutoff(double hz);
+
+    CycleSettings cycleSettings() const;
+    void setCycleSettings(const CycleSettings& settings);
+
+    EnvironmentSettings environmentSettings() const;
+    void setEnvironmentSettings(const EnvironmentSettings& settings);
+
 signals:
     void filterChanged(Filter* newFilter);
 
@@ -72,6 +118,7 @@ private slots:
 
 private:
     QMap<QAction*, std::function<Filter*()>> m_filterFactories;
+    QVector<QAction*> m_filterOrder;   // порядок регистрации фильтров
     QActionGroup* m_filterGroup;
     QAction* m_defaultAction = nullptr;
 
@@ -80,8 +127,12 @@ private:
     bool m_autoRepeatEnabled = false;
 
     int m_saveTime = 5;
+    int m_decimation = 1;
+    double m_smoothingCutoff = 0.0;  // срез ФНЧ для графика и авто-режима, Гц (0 — выкл.)
 
     AutoSaveSettings m_autoSaveSettings;
+    CycleSettings m_cycleSettings;
+    EnvironmentSettings m_environmentSettings;
 };
 
 #endif // SETTINGSMANAGER_H
@@ -1,5 +1,7 @@
 #include "stepconfigdialog.h"
 #include "ui_stepconfigdialog.h"
+#include "formulaexpression.h"
+#include <algorithm>
 
 stepconfigdialog::stepconfigdialog(QWidget *parent) :
     QDialog(parent),
@@ -12,6 +14,10 @@ stepconfigdialog::stepconfigdialog(QWidget *parent) :
     connect(ui->radioFormula, &QRadioButton::toggled, this, &stepconfigdialog::FormulaToggled);
     connect(ui->radioNone,    &QRadioButton::toggled, this, &stepconfigdialog::NoneToggled);
 
+    // проверка формулы при вводе
+    connect(ui->lineEdit, &QLineEdit::textChanged, this, &stepconfigdialog::validateFormula);
+    connect(ui->spinBox_2, &QSpinBox::valueChanged, this, &stepconfigdialog::validateFormula);
+
     //Подключение кнопки сохранить
     connect(ui->btnSave,   &QPushButton::clicked, this, &stepconfigdialog::Save);
 
@@ -69,6 +75,7 @@ void stepconfigdialog::loadFromSettings(const StepSettings& settings)
     ui->radioNone->blockSignals(false);
 
     ui->checkBidirectional->setChecked(m_settings.bidirectional);
+    validateFormula();
 }
 
 StepSettings stepconfigdialog::currentSettings() const
@@ -108,8 +115,51 @@ void stepconfigdialog::NoneToggled(bool checked)
     }
 }
 
+// разобрать формулу и показать ошибку (или первые значения) под полем ввода
+void stepconfigdialog::validateFormula()
+{
+    const QString text = ui->lineEdit->text();
+    if (text.trimmed().isEmpty()) {
+        ui->labelFormulaError->clear();
+        return;
+    }
+
+    const FormulaExpression f = FormulaExpression::compile(text);
+    if (!f.isValid()) {
+        ui->labelFormulaError->setStyleSheet("color: red;");
+        ui->labelFormulaError->setText(QString("Ошибка в позиции %1: %2")
+                                           .arg(f.errorPosition() + 1)
+                                           .arg(f.errorString()));
+        return;
+    }
+
+    // предпросмотр: первые шаги и последний
+    const int n = std::max(1, ui->spinBox_2->value());
+    const double base = ui->spinBoxBase->value();
+    const double step = ui->doubleSpinBox_2->value();
+    QVector<double> values(n);
+    f.evaluateSteps(1, n, n, base, step, values.data());
+
+    QStringList shown;
+    for (int i = 0; i < std::min(n, 3); ++i) shown << QString::number(values[i], 'g', 6);
+    if (n > 3) shown << "…" << QString::number(values[n - 1], 'g', 6);
+    ui->labelFormulaError->setStyleSheet(QString());
+    ui->labelFormulaError->setText("Шаги: " + shown.join("; "));
+}
+
 void stepconfigdialog::Save()
 {
+    // с ошибкой в формуле режим Formula не сохраняем
+    if (m_settings.mode == StepMode::Formula) {
+        const FormulaExpression f = FormulaExpression::compile(ui->lineEdit->text());
+        if (!f.isValid()) {
+            validateFormula();
+            ui->lineEdit->setFocus();
+            ui->lineEdit->setCursorPosition(std::max(0, f.errorPosition()));
+            return;
+        }
+    }
+
     // считываем все поля один раз
     m_settings.base         = ui->spinBoxBase->value();
     m_settings.step         = ui->doubleSpinBox_2->value();
@@ -168,6 +218,7 @@ void stepconfigdialog::applyUI(const StepSettings& s)
     ui->radioNone->blockSignals(false);
 
     ui->checkBidirectional->setChecked(s.bidirectional);
+    validateFormula();
 }
 
 
@@ -31,6 +31,8 @@ private slots:
     void FormulaToggled(bool checked);
     void NoneToggled(bool checked);
 
+    void validateFormula(); // разбор формулы на лету, ошибка — под полем ввода
+
     void Save();      // btnSave — сохраняет и закрывает диалог
     void Cancel();    // btnCancel — закрывает без сохранения
     void Default();   // btnDefault — сбрасывает формы к исходным значениям
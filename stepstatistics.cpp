@@ -0,0 +1,80 @@
+#include "stepstatistics.h"         // заголовок статистики
+#include <cmath>                        // sqrt/isnan
+
+// шаг Уэлфорда
+void RunningStats::add(double x)
+{
+    ++n;
+    const double d = x - mean;                              // отклонение от старого среднего
+    mean += d / n;                                          // новое среднее
+    m2   += d * (x - mean);                                 // накопление квадратов
+}
+
+double RunningStats::stddev() const
+{
+    return std::sqrt(variance());
+}
+
+// без направления или без ожидаемого шаг в расчёт не идёт
+bool StepAccumulator::counts(ApproachDirection dir, double deviation)
+{
+    return dir != ApproachDirection::Unknown && !std::isnan(deviation);
+}
+
+// одно измерение в накопители шага — общее ядро последовательного и параллельного пересчёта
+void StepAccumulator::add(ApproachDirection dir, double deviation, double exp)
+{
+    if (dir == ApproachDirection::Forward) {
+        forward.add(deviation);
+        if (std::isnan(expected)) expected = exp;               // как в AccuracyCalculator
+    } else {
+        backward.add(deviation);
+    }
+}
+
+// учесть одно измерение
+void StepStatistics::add(int group, int stepNumber, ApproachDirection dir,
+                         double deviation, double expected)
+{
+    if (group >= m_groups.size()) m_groups.resize(group + 1);   // новая группа
+
+    if (!StepAccumulator::counts(dir, deviation))
+        return;
+
+    m_groups[group][stepNumber].add(dir, deviation, expected);
+}
+
+// собрать заново по колонкам
+void StepStatistics::rebuild(const MeasurementColumns& cols)
+{
+    m_groups.clear();
+    m_groups.resize(cols.groupCount());
+
+    const double* dev = cols.deviation.constData();
+    const double* exp = cols.expected.constData();
+
+    for (int s = 0; s < cols.seriesCount(); ++s) {
+        const int g = cols.seriesGroup[s];
+        const int stepNumber = cols.seriesStep[s];
+        const ApproachDirection dir = cols.seriesDirection[s];
+        for (int i = cols.seriesBegin(s); i < cols.seriesEnd(s); ++i)
+            add(g, stepNumber, dir, dev[i], exp[i]);
+    }
+}
+
+// собрать заново одну группу: тот же порядок серий и строк, что и в rebuild
+void StepStatistics::rebuildGroup(const MeasurementColumns& cols, int group)
+{
+    if (group >= m_groups.size()) m_groups.resize(group + 1);
+    m_groups[group].clear();
+
+    const double* dev = cols.deviation.constData();
+    const double* exp = cols.expected.constData();
+
+    for (int s = cols.groupBegin(group); s < cols.groupEnd(group); ++s) {
+        const int stepNumber = cols.seriesStep[s];
+        const ApproachDirection dir = cols.seriesDirection[s];
+        for (int i = cols.seriesBegin(s); i < cols.seriesEnd(s); ++i)
+            add(group, stepNumber, dir, dev[i], exp[i]);
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef STEPSTATISTICS_H
+#define STEPSTATISTICS_H
+
+#include <QVector>                      // группы
+#include <QMap>                         // шаги по возрастанию номера
+#include <limits>                       // NaN
+#include "typemeasurement.h"            // ApproachDirection
+#include "measurementcolumns.h"         // полный пересчёт по колонкам
+
+// накопитель Уэлфорда: n, среднее и сумма квадратов отклонений
+struct RunningStats
+{
+    int    n    = 0;                                        // число значений
+    double mean = 0.0;                                      // текущее среднее
+    double m2   = 0.0;                                      // Σ(x - mean)²
+
+    void add(double x);                                     // добавить значение
+    double variance() const { return n > 1 ? m2 / (n - 1) : 0.0; } // несмещённая дисперсия
+    double stddev() const;                                  // СКО (0 при n < 2)
+};
+
+// накопители одного шага группы по направлениям
+struct StepAccumulator
+{
+    RunningStats forward;                                   // подходы вперёд
+    RunningStats backward;                                  // подходы назад
+    double expected = std::numeric_limits<double>::quiet_NaN(); // ожидаемое (первое из прямых серий)
+
+    static bool counts(ApproachDirection dir, double deviation); // идёт ли измерение в расчёт
+    void add(ApproachDirection dir, double deviation, double expected); // учесть (counts() == true)
+};
+
+// статистика погрешностей по (группа, шаг, направление), поддерживается при add
+// и пересобирается при пересчётах — AccuracyCalculator читает её за O(шагов)
+class StepStatistics
+{
+public:
+    using GroupStats = QMap<int, StepAccumulator>;          // шаг → накопители
+
+    void clear() { m_groups.clear(); }                      // сбросить всё
+    void add(int group, int stepNumber, ApproachDirection dir,
+             double deviation, double expected);            // учесть одно измерение
+    void rebuild(const MeasurementColumns& cols);           // собрать заново по колонкам
+    void rebuildGroup(const MeasurementColumns& cols, int group); // заново только одну группу
+    void setGroups(const QVector<GroupStats>& groups) { m_groups = groups; } // готовые накопители (RecalcEngine)
+
+    int groupCount() const { return m_groups.size(); }      // число групп
+    const GroupStats& group(int g) const { return m_groups[g]; } // накопители группы
+
+private:
+    QVector<GroupStats> m_groups;                           // по порядковому номеру группы
+};
+
+#endif // STEPSTATISTICS_H
@@ -0,0 +1,27 @@
+#include "tests.h"
+#include <QCoreApplication>
+#include <QtTest>
+
+// calibrix-tests — все наборы по очереди; код возврата — число упавших наборов
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    int failed = 0;
+
+    TestStandards standards;
+    failed += QTest::qExec(&standards, argc, argv) != 0;
+
+    TestDataMeasurement measurement;
+    failed += QTest::qExec(&measurement, argc, argv) != 0;
+
+    TestCyclePlanner planner;
+    failed += QTest::qExec(&planner, argc, argv) != 0;
+
+    TestBinaryIO binaryio;
+    failed += QTest::qExec(&binaryio, argc, argv) != 0;
+
+    TestUncertainty uncertainty;
+    failed += QTest::qExec(&uncertainty, argc, argv) != 0;
+
+    return failed;
+}
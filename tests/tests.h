@@ -0,0 +1,63 @@
+#ifndef TESTS_H
+#define TESTS_H
+
+#include <QObject>
+
+// ----- стандарты оценки на разобранных вручную примерах (tst_standards.cpp)
+class TestStandards : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void vdi3441Reference();        // Pa, Umax, Ū, Psmax, P и строки позиций
+    void jisb6192Reference();       // A, A⁺, A⁻, ±R/2, Bmax, B̄
+    void iso2302Reference();        // E, M, R, B, A по направлениям и вместе
+    void registry();                // ключи реестра и стандарт по умолчанию
+};
+
+// ----- конвейер add и снимки DataMeasurement (tst_datameasurement.cpp)
+class TestDataMeasurement : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void undoAcrossStructureChange();       // откат сохранения после смены структуры
+    void structureChangeSurvivesReapply();  // те же настройки ещё раз не отменяют новую группу
+    void derivedJobMatchesSync();           // пересчёт вне GUI-потока — те же числа
+    void driftOriginPerGroup();             // у каждой группы свой нуль дрейфа
+    void driftIncrementalMatchesRebuild();  // узлы при add = полная пересборка
+};
+
+// ----- программа цикла ISO 230-2 для стойки (tst_cycleplanner.cpp)
+class TestCyclePlanner : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void gcodeMillisecondsP();      // ASCII и G4 P в целых мс
+    void gcodeSecondsX();           // G4 X в секундах
+};
+
+// ----- перечисления в двоичных форматах журнала и .cbx (tst_binaryio.cpp)
+class TestBinaryIO : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void stepSettingsRejectUnknownMode();   // режим шагов новее этой версии — запись отвергнута
+    void enumRanges();                      // известные значения направлений и типов групп
+};
+
+// ----- интервалы UncertaintyEngine при фиксированном seed (tst_uncertainty.cpp)
+class TestUncertainty : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void philoxKnownAnswers();      // контрольные векторы Philox4x32-10
+    void monteCarloWithoutNoise();  // u = 0: интервал стягивается в оценку
+    void bootstrapHandComputed();   // E⁺ двух шагов: [0, 0.001], среднее 0.0005
+    void bootstrapDeterministic();  // seed → один отчёт при любом числе потоков
+};
+
+#endif // TESTS_H
@@ -0,0 +1,57 @@
+# Модульные тесты расчётных ядер Calibrix (QtTest, без GUI).
+# Сборка: qmake tests/tests.pro && make; запуск: ./calibrix-tests или make check
+
+QT       = core gui concurrent testlib
+CONFIG  += console c++17 testcase
+CONFIG  -= app_bundle
+TARGET   = calibrix-tests
+
+INCLUDEPATH += .. ../accuracy
+
+SOURCES += \
+    main.cpp \
+    tst_standards.cpp \
+    tst_datameasurement.cpp \
+    tst_cycleplanner.cpp \
+    tst_binaryio.cpp \
+    tst_uncertainty.cpp \
+    ../accuracy/accuracycalculator.cpp \
+    ../accuracy/evaluationstandard.cpp \
+    ../accuracy/iso2302standard.cpp \
+    ../accuracy/jisb6192standard.cpp \
+    ../accuracy/vdi3441standard.cpp \
+    ../accuracy/uncertaintyengine.cpp \
+    ../cycleplanner.cpp \
+    ../datameasurement.cpp \
+    ../measurementsnapshot.cpp \
+    ../measurementcolumns.cpp \
+    ../stepstatistics.cpp \
+    ../recalcengine.cpp \
+    ../calculatemesurement.cpp \
+    ../expectedtable.cpp \
+    ../formulaexpression.cpp \
+    ../rawrecordstore.cpp \
+    ../bytearena.cpp \
+    ../driftmodel.cpp
+
+HEADERS += \
+    tests.h \
+    ../accuracy/accuracycalculator.h \
+    ../accuracy/evaluationstandard.h \
+    ../accuracy/iso2302standard.h \
+    ../accuracy/jisb6192standard.h \
+    ../accuracy/vdi3441standard.h \
+    ../accuracy/uncertaintyengine.h \
+    ../cycleplanner.h \
+    ../datameasurement.h \
+    ../measurementsnapshot.h \
+    ../measurementcolumns.h \
+    ../stepstatistics.h \
+    ../recalcengine.h \
+    ../calculatemesurement.h \
+    ../expectedtable.h \
+    ../formulaexpression.h \
+    ../rawrecordstore.h \
+    ../bytearena.h \
+    ../driftmodel.h \
+    ../binaryio.h
@@ -0,0 +1,45 @@
+#include "tests.h"
+#include "binaryio.h"
+#include <QtTest>
+
+using namespace BinaryIO;
+
+// Настройки шагов с режимом, которого нет в этой версии, отвергаются, а не
+// превращаются в недопустимый StepMode
+void TestBinaryIO::stepSettingsRejectUnknownMode()
+{
+    StepSettings s;
+    s.mode = StepMode::Uniform;
+    s.count = 7;
+    QByteArray bytes;
+    putStepSettings(bytes, s);
+
+    Reader ok{ bytes.constData(), bytes.constData() + bytes.size() };
+    QCOMPARE(getStepSettings(ok).count, 7);
+    QVERIFY(ok.ok && !ok.badEnum);
+
+    bytes[0] = char(quint8(StepMode::Uniform) + 1);              // режим из более новой версии
+    Reader bad{ bytes.constData(), bytes.constData() + bytes.size() };
+    getStepSettings(bad);
+    QVERIFY(!bad.ok);
+    QVERIFY(bad.badEnum);
+}
+
+// Направление подхода и тип группы: известны только значения от 0 до последнего перечислителя
+void TestBinaryIO::enumRanges()
+{
+    QVERIFY(isKnownEnum<ApproachDirection>(int(ApproachDirection::Backward)));
+    QVERIFY(!isKnownEnum<ApproachDirection>(int(ApproachDirection::Backward) + 1));
+    QVERIFY(!isKnownEnum<ApproachDirection>(-1));
+    QVERIFY(isKnownEnum<MeasurementGroupType>(int(MeasurementGroupType::Bidirectional)));
+    QVERIFY(!isKnownEnum<MeasurementGroupType>(2));
+    QVERIFY(!isKnownEnum<bool>(2));
+
+    const char truncated[] = { char(ApproachDirection::Forward) };
+    Reader r{ truncated, truncated + 1 };
+    QCOMPARE(r.getEnum<ApproachDirection>(), ApproachDirection::Forward);
+    QVERIFY(r.ok);
+    r.getEnum<ApproachDirection>();                               // за концом — не перечисление, а обрыв
+    QVERIFY(!r.ok);
+    QVERIFY(!r.badEnum);
+}
@@ -0,0 +1,75 @@
+#include "tests.h"
+#include "cycleplanner.h"
+#include <QtTest>
+
+namespace {
+
+// два шага туда-обратно: выдержка 0.25 с на запись, 2 записи, успокоение 1 с → 1.5 с в точке
+CyclePlan twoStepPlan()
+{
+    CyclePlan plan;
+    plan.cycles = 1;
+    plan.targets = 2;
+    plan.repeats = 2;
+    plan.dwellSec = 0.25;
+    plan.moves = {
+        { -1.0, 0, ApproachDirection::Unknown,  true,  0.0  },
+        {  0.0, 1, ApproachDirection::Forward,  false, 0.25 },
+        { 10.0, 2, ApproachDirection::Forward,  false, 0.25 },
+        { 11.0, 0, ApproachDirection::Unknown,  true,  0.0  },
+        { 10.0, 2, ApproachDirection::Backward, false, 0.25 }
+    };
+    return plan;
+}
+
+CycleSettings cycleSettings(DwellWord word)
+{
+    CycleSettings cs;
+    cs.feedRate = 500.0;
+    cs.settleTime = 1.0;
+    cs.machineOrigin = 100.0;
+    cs.axis = QString::fromUtf8(" х");                          // кириллица в поле оси
+    cs.dwellWord = word;
+    return cs;
+}
+
+bool isAscii(const QString& s)
+{
+    for (const QChar c : s)
+        if (c.unicode() > 0x7F)
+            return false;
+    return true;
+}
+
+} // namespace
+
+// Fanuc: комментарии только ASCII, выдержка — целые миллисекунды в P
+void TestCyclePlanner::gcodeMillisecondsP()
+{
+    const QString g = CyclePlanner::toGCode(twoStepPlan(), cycleSettings(DwellWord::MillisecondsP));
+
+    QVERIFY(isAscii(g));
+    const QStringList lines = g.split('\n', Qt::SkipEmptyParts);
+    QCOMPARE(lines.size(), 12);
+    QCOMPARE(lines[0], QString("(CALIBRIX ISO 230-2 CYCLE, AXIS X, CYCLES 1, TARGETS 2)"));
+    QCOMPARE(lines[2], QString("G21 G90 G94"));
+    QCOMPARE(lines[3], QString("G0 X99.0000"));
+    QCOMPARE(lines[4], QString("G1 X100.0000 F500.0"));
+    QCOMPARE(lines[5], QString("G4 P1500 (STEP 1 FWD)"));
+    QCOMPARE(lines[6], QString("G1 X110.0000"));
+    QCOMPARE(lines[9], QString("G1 X110.0000"));
+    QCOMPARE(lines[10], QString("G4 P1500 (STEP 2 BWD)"));
+    QCOMPARE(lines[11], QString("M30"));
+}
+
+// выдержка в секундах словом X
+void TestCyclePlanner::gcodeSecondsX()
+{
+    CycleSettings cs = cycleSettings(DwellWord::SecondsX);
+    cs.axis = "y";
+    const QString g = CyclePlanner::toGCode(twoStepPlan(), cs);
+
+    QVERIFY(isAscii(g));
+    QVERIFY(g.contains("G1 Y100.0000 F500.0\nG4 X1.500 (STEP 1 FWD)\n"));
+    QVERIFY(!g.contains("G4 P"));
+}
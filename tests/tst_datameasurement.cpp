@@ -0,0 +1,208 @@
+#include "tests.h"
+#include "datameasurement.h"
+#include <QtTest>
+
+namespace {
+
+// равномерные шаги по 10 мм, один повтор, только вперёд
+StepSettings uniformSteps(int count)
+{
+    StepSettings s;
+    s.mode = StepMode::Uniform;
+    s.step = 10.0;
+    s.count = count;
+    return s;
+}
+
+// туда-обратно по count шагам: сохранения идут 1..N, N..1, 1..N — со сдвигом level и временем
+void addPingPong(DataMeasurement& dm, int count, int rows, double level, qint64& t)
+{
+    for (int k = 0; k < rows; ++k) {
+        const int i = k % (2 * count);
+        const int step = i < count ? i + 1 : 2 * count - i;
+        dm.add(10.0 * step + level + 0.0003 * k, {}, t);
+        t += 1000;
+    }
+}
+
+} // namespace
+
+// Смена структуры → сохранение → откат: снимок до сохранения помнит, что следующий add
+// открывает новую группу. Окно после отката ставит настройки заново (как
+// MainWindow::applySnapshot) — это не должно снимать запрос.
+void TestDataMeasurement::undoAcrossStructureChange()
+{
+    DataMeasurement dm;
+    dm.setStepSettings(uniformSteps(3));
+    dm.add(0.0, {}, 1);
+    dm.add(10.0, {}, 2);
+    QCOMPARE(dm.columns().groupCount(), 1);
+
+    const StepSettings changed = uniformSteps(5);
+    dm.setStepSettings(changed);
+    const MeasurementSnapshot beforeSave = dm.snapshot();
+    QVERIFY(beforeSave.cursor().stepStructureChanged);
+
+    dm.add(0.0, {}, 3);                                          // новая группа по новой структуре
+    QCOMPARE(dm.columns().groupCount(), 2);
+
+    dm.restore(beforeSave);                                      // откат сохранения
+    dm.setStepSettings(changed);                                 // повторы — по текущим настройкам
+    QCOMPARE(dm.columns().groupCount(), 1);
+    QVERIFY(dm.cursor().stepStructureChanged);
+
+    dm.add(0.0, {}, 4);                                          // снова новая группа, а не шаг 3 старой
+    const MeasurementColumns& cols = dm.columns();
+    QCOMPARE(cols.groupCount(), 2);
+    QCOMPARE(cols.groupSeries(0), 2);
+    QCOMPARE(cols.seriesStep.last(), 1);
+}
+
+// Повторная установка тех же настроек (переход в Idle после диалога шагов) и смена
+// только числа повторов не отменяют запрошенную новую группу
+void TestDataMeasurement::structureChangeSurvivesReapply()
+{
+    DataMeasurement dm;
+    dm.setStepSettings(uniformSteps(3));
+    dm.add(0.0, {}, 1);
+
+    StepSettings changed = uniformSteps(4);
+    dm.setStepSettings(changed);
+    dm.setStepSettings(changed);
+    changed.repeatCount = 2;
+    dm.setStepSettings(changed);
+    QVERIFY(dm.cursor().stepStructureChanged);
+
+    dm.add(0.0, {}, 2);
+    QCOMPARE(dm.columns().groupCount(), 2);
+    QVERIFY(!dm.cursor().stepStructureChanged);
+
+    dm.setStepSettings(changed);                                 // без изменений — та же группа
+    dm.add(0.0, {}, 3);
+    QCOMPARE(dm.columns().groupCount(), 2);
+}
+
+// Пересчёт после смены базы заданием вне объекта даёт те же числа, что и ленивый
+// пересчёт при чтении; после нового сохранения результат задания не принимается
+void TestDataMeasurement::derivedJobMatchesSync()
+{
+    StepSettings settings = uniformSteps(4);
+    settings.bidirectional = true;
+    DataMeasurement lazy, offThread;
+    for (DataMeasurement* dm : { &lazy, &offThread }) {
+        dm->setStepSettings(settings);
+        for (int cycle = 0; cycle < 2; ++cycle) {
+            for (int s = 0; s < 4; ++s) dm->add(10.0 * s + 0.001 * cycle, {}, 1 + cycle * 8 + s);
+            for (int s = 3; s >= 0; --s) dm->add(10.0 * s + 0.004, {}, 5 + cycle * 8 + 3 - s);
+        }
+    }
+    settings.base = 0.5;                                         // только база — новая версия производных
+    lazy.setStepSettings(settings);
+    offThread.setStepSettings(settings);
+    QVERIFY(offThread.derivedPending());
+
+    DataMeasurement::DerivedJob job = offThread.derivedJob();
+    DataMeasurement::runDerived(job);
+    QVERIFY(offThread.derivedPending());                         // сам объект задание не трогает
+    QVERIFY(offThread.adoptDerived(job));
+    QVERIFY(!offThread.derivedPending());
+
+    const MeasurementColumns& a = lazy.columns();
+    const MeasurementColumns& b = offThread.columns();
+    QCOMPARE(a.rowCount(), b.rowCount());
+    for (int i = 0; i < a.rowCount(); ++i) {
+        QCOMPARE(a.distance[i], b.distance[i]);
+        QCOMPARE(a.deviation[i], b.deviation[i]);
+    }
+    QVERIFY(a.seriesDirection == b.seriesDirection);
+    QCOMPARE(lazy.stepStatistics().group(0)[2].forward.mean, offThread.stepStatistics().group(0)[2].forward.mean);
+
+    settings.base = 0.25;
+    offThread.setStepSettings(settings);
+    DataMeasurement::DerivedJob late = offThread.derivedJob();
+    DataMeasurement::runDerived(late);
+    offThread.add(0.0, {}, 100);                                 // сохранение, пока шёл пересчёт
+    QVERIFY(!offThread.adoptDerived(late));
+    QCOMPARE(offThread.columns().distance.last(), -0.25);        // досчитано при чтении
+}
+
+// Новая группа с другой структурой начинает свою цепочку дрейфа: её смещение в опорной
+// позиции — погрешность позиционирования, а не дрейф от возвратов прошлой группы
+void TestDataMeasurement::driftOriginPerGroup()
+{
+    StepSettings settings = uniformSteps(2);
+    settings.bidirectional = true;
+    DataMeasurement dm;
+    dm.setDriftCompensation(true);
+    dm.setStepSettings(settings);
+    dm.add(10.000, {}, 1000);                                    // 1 → 2 → 2 → 1 → 1: два возврата
+    dm.add(20.0, {}, 2000);
+    dm.add(20.0, {}, 3000);
+    dm.add(10.0, {}, 4000);
+    dm.add(10.002, {}, 5000);
+
+    settings.count = 3;                                          // другая структура — новая группа
+    dm.setStepSettings(settings);
+    dm.add(10.010, {}, 6000);                                    // опорная позиция новой группы
+    dm.add(20.0, {}, 7000);
+    dm.add(30.0, {}, 8000);
+    dm.add(30.0, {}, 9000);
+    dm.add(20.0, {}, 10000);
+    dm.add(10.0, {}, 11000);
+    dm.add(10.012, {}, 12000);
+
+    const DriftModel& model = dm.driftModel();
+    QCOMPARE(model.groups(), QList<int>({ 0, 1 }));
+    const QVector<DriftModel::Knot> second = model.knots(1);
+    QCOMPARE(second.size(), 2);
+    QCOMPARE(second[0].drift, 0.0);
+    QVERIFY(qAbs(second[1].drift - 0.002) < 1e-12);
+    QVERIFY(qAbs(model.knots(0)[1].drift - 0.002) < 1e-12);
+
+    const MeasurementColumns& cols = dm.columns();
+    QVERIFY(qAbs(cols.deviation.last() - 0.010) < 1e-12);         // смещение осталось в погрешности
+    QCOMPARE(cols.drift[cols.seriesBegin(cols.groupBegin(1))], 0.0);
+}
+
+// Модель, дописанная по возвратам при add, и поправки в колонках совпадают с полной
+// пересборкой по колонкам
+void TestDataMeasurement::driftIncrementalMatchesRebuild()
+{
+    StepSettings settings = uniformSteps(3);
+    settings.bidirectional = true;
+    settings.repeatCount = 2;
+    DataMeasurement dm;
+    dm.setStepSettings(settings);
+    dm.setDriftCompensation(true);
+    qint64 t = 1000;
+    addPingPong(dm, 3, 1, 0.0, t);
+    dm.columns();                                                // модель собрана — дальше только add
+    for (int cycle = 0; cycle < 4; ++cycle)
+        addPingPong(dm, 3, 12, 0.001 * cycle, t);
+
+    DataMeasurement full = dm;
+    full.setDriftCompensation(false);                            // сбросить модель: соберётся заново
+    full.setDriftCompensation(true);
+
+    const DriftModel a = dm.driftModel();
+    const DriftModel b = full.driftModel();
+    QVERIFY(a.knotCount() >= 3);
+    QCOMPARE(a.knotCount(), b.knotCount());
+    for (int k = 0; k < a.knots(0).size(); ++k) {
+        QCOMPARE(a.knots(0)[k].timeMs, b.knots(0)[k].timeMs);
+        QCOMPARE(a.knots(0)[k].drift, b.knots(0)[k].drift);
+    }
+
+    const MeasurementColumns& ca = dm.columns();
+    const MeasurementColumns& cb = full.columns();
+    for (int i = 0; i < ca.rowCount(); ++i) {
+        QCOMPARE(ca.drift[i], cb.drift[i]);
+        QCOMPARE(ca.deviation[i], cb.deviation[i]);
+    }
+    for (auto it = full.stepStatistics().group(0).cbegin(); it != full.stepStatistics().group(0).cend(); ++it) {
+        const StepAccumulator& x = dm.stepStatistics().group(0)[it.key()];
+        QCOMPARE(x.forward.n, it->forward.n);
+        QCOMPARE(x.forward.mean, it->forward.mean);
+        QCOMPARE(x.backward.m2, it->backward.m2);
+    }
+}
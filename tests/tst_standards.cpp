@@ -0,0 +1,117 @@
+#include "tests.h"
+#include "evaluationstandard.h"
+#include "iso2302standard.h"
+#include "jisb6192standard.h"
+#include "vdi3441standard.h"
+#include <QtTest>
+#include <cmath>
+
+namespace {
+
+// Пример для ручного счёта (мм). Позиция 1 — по три подхода с обеих сторон,
+// позиция 2 — только вперёд:
+//   1: x⁺ = 0.001, 0.003, 0.002 → x̄⁺ = 0.002,  s⁺ = 0.001
+//      x⁻ = 0.004, 0.006, 0.005 → x̄⁻ = 0.005,  s⁻ = 0.001
+//   2: x⁺ = −0.002, 0.000, −0.001 → x̄⁺ = −0.001, s⁺ = 0.001
+StepStatistics::GroupStats referenceGroup()
+{
+    StepStatistics::GroupStats g;
+    for (double x : { 0.001, 0.003, 0.002 })
+        g[1].add(ApproachDirection::Forward, x, 10.0);
+    for (double x : { 0.004, 0.006, 0.005 })
+        g[1].add(ApproachDirection::Backward, x, 10.0);
+    for (double x : { -0.002, 0.0, -0.001 })
+        g[2].add(ApproachDirection::Forward, x, 20.0);
+    return g;
+}
+
+} // namespace
+
+// VDI/DGQ 3441:
+//   1: x̄ⱼ = (0.002 + 0.005)/2 = 0.0035, Uⱼ = 0.003, s̄ⱼ = 0.001, Psⱼ = 6·s̄ⱼ = 0.006
+//   2: x̄ⱼ = −0.001, Uⱼ нет, s̄ⱼ = 0.001, Psⱼ = 0.006
+//   Pa = 0.0035 − (−0.001) = 0.0045; Umax = Ū = 0.003; Psmax = 0.006
+//   P: полосы x̄ⱼ ± (Uⱼ + Psⱼ)/2 — [−0.001, 0.008] и [−0.004, 0.002] → 0.012
+void TestStandards::vdi3441Reference()
+{
+    const StandardGroupReport r = Vdi3441Standard().evaluateGroup(referenceGroup());
+
+    QCOMPARE(r.steps.size(), 2);
+    const QVector<double>& s1 = r.steps[0].values;
+    QCOMPARE(r.steps[0].stepNumber, 1);
+    QCOMPARE(r.steps[0].expected, 10.0);
+    QCOMPARE(s1[0], 0.002);
+    QCOMPARE(s1[1], 0.005);
+    QCOMPARE(s1[2], 0.0035);
+    QCOMPARE(s1[3], 0.003);
+    QCOMPARE(s1[4], 0.001);
+    QCOMPARE(s1[5], 0.006);
+
+    const QVector<double>& s2 = r.steps[1].values;
+    QCOMPARE(s2[0], -0.001);
+    QVERIFY(std::isnan(s2[1]));
+    QCOMPARE(s2[2], -0.001);
+    QVERIFY(std::isnan(s2[3]));
+    QCOMPARE(s2[4], 0.001);
+    QCOMPARE(s2[5], 0.006);
+
+    QCOMPARE(r.totals.size(), 5);
+    QCOMPARE(r.totals[0].value, 0.0045);        // Pa
+    QCOMPARE(r.totals[1].value, 0.003);         // Umax
+    QCOMPARE(r.totals[2].value, 0.003);         // Ū
+    QCOMPARE(r.totals[3].value, 0.006);         // Psmax
+    QCOMPARE(r.totals[4].value, 0.012);         // P
+}
+
+// JIS B 6192 (двунаправленные A, R, B — по позициям с обеих сторон, как в ядре ISO):
+//   A⁺ = max(x̄⁺ + 2s⁺) − min(x̄⁺ − 2s⁺) = 0.004 − (−0.003) = 0.007
+//   A⁻ = 0.007 − 0.003 = 0.004;  A (позиция 1) = 0.007 − 0.000 = 0.007
+//   R₁ = 2s⁺ + 2s⁻ + |B₁| = 0.007 → ±R/2 = 0.0035;  B₁ = x̄⁺ − x̄⁻ = −0.003
+void TestStandards::jisb6192Reference()
+{
+    const StandardGroupReport r = JisB6192Standard().evaluateGroup(referenceGroup());
+
+    QCOMPARE(r.steps.size(), 2);
+    QCOMPARE(r.steps[0].values[2], -0.003);     // B₁
+    QCOMPARE(r.steps[0].values[5], 0.0035);     // ±R₁/2
+
+    QCOMPARE(r.totals.size(), 6);
+    QCOMPARE(r.totals[0].value, 0.007);         // A
+    QCOMPARE(r.totals[1].value, 0.007);         // A⁺
+    QCOMPARE(r.totals[2].value, 0.004);         // A⁻
+    QCOMPARE(r.totals[3].value, 0.0035);        // ±R/2
+    QCOMPARE(r.totals[4].value, 0.003);         // Bmax
+    QCOMPARE(r.totals[5].value, -0.003);        // B̄
+}
+
+// ISO 230-2 на том же примере:
+//   E⁺ = 0.002 − (−0.001) = 0.003; E⁻ = 0; E = 0.005 − (−0.001) = 0.006; M = 0 (одна позиция с x̄ᵢ)
+//   R⁺ = R⁻ = 4s = 0.004; R = 0.007; B = 0.003; B̄ = −0.003; A⁺ = 0.007; A⁻ = 0.004; A = 0.007
+void TestStandards::iso2302Reference()
+{
+    const StandardGroupReport r = Iso2302Standard().evaluateGroup(referenceGroup());
+
+    QCOMPARE(r.totals.size(), 12);
+    QCOMPARE(r.totals[0].value, 0.003);         // E⁺
+    QCOMPARE(r.totals[1].value, 0.0);           // E⁻
+    QCOMPARE(r.totals[2].value, 0.004);         // R⁺
+    QCOMPARE(r.totals[3].value, 0.004);         // R⁻
+    QCOMPARE(r.totals[4].value, 0.007);         // A⁺
+    QCOMPARE(r.totals[5].value, 0.004);         // A⁻
+    QCOMPARE(r.totals[6].value, 0.006);         // E
+    QCOMPARE(r.totals[7].value, 0.0);           // M
+    QCOMPARE(r.totals[8].value, 0.003);         // B
+    QCOMPARE(r.totals[9].value, -0.003);        // B̄
+    QCOMPARE(r.totals[10].value, 0.007);        // R
+    QCOMPARE(r.totals[11].value, 0.007);        // A
+}
+
+void TestStandards::registry()
+{
+    const QVector<EvaluationStandard::Ptr>& all = EvaluationStandard::available();
+    QCOMPARE(all.size(), 3);
+    QCOMPARE(all.first()->id(), QString(Iso2302Standard::kId));
+    QVERIFY(EvaluationStandard::byId("vdi3441") != nullptr);
+    QVERIFY(EvaluationStandard::byId("jisb6192") != nullptr);
+    QVERIFY(EvaluationStandard::byId("unknown") == nullptr);
+}
@@ -0,0 +1,185 @@
+#include "tests.h"
+#include "uncertaintyengine.h"
+#include "measurementsnapshot.h"
+#include <QThreadPool>
+#include <QtTest>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// одна группа, только вперёд, по строке на подход
+MeasurementColumns forwardGroup(const QVector<QVector<double>>& steps)
+{
+    MeasurementColumns cols;
+    cols.appendGroup(1, StepMode::Uniform, MeasurementGroupType::Unidirectional);
+    for (int s = 0; s < steps.size(); ++s) {
+        cols.appendSeries(s + 1, ApproachDirection::Forward);
+        for (int k = 0; k < steps[s].size(); ++k) {
+            const double expected = 10.0 * (s + 1);
+            Measurement m;
+            m.repeatIndex = k + 1;
+            m.expected = expected;
+            m.deviation = steps[s][k];
+            m.distance = m.raw = expected + m.deviation;
+            cols.appendRow(m);
+        }
+    }
+    return cols;
+}
+
+// пять циклов туда-обратно по четырём позициям с постоянным люфтом
+MeasurementColumns bidirectionalGroup()
+{
+    static const double kForward[5][4] = {
+        {  0.0012, -0.0004, 0.0021, 0.0030 },
+        {  0.0008,  0.0001, 0.0017, 0.0026 },
+        {  0.0015, -0.0007, 0.0024, 0.0033 },
+        {  0.0010, -0.0002, 0.0019, 0.0028 },
+        {  0.0006,  0.0003, 0.0015, 0.0031 }
+    };
+    MeasurementColumns cols;
+    cols.appendGroup(1, StepMode::Uniform, MeasurementGroupType::Bidirectional);
+    for (int cycle = 0; cycle < 5; ++cycle)
+        for (int dir = 0; dir < 2; ++dir)
+            for (int i = 0; i < 4; ++i) {
+                const int s = dir == 0 ? i : 3 - i;
+                cols.appendSeries(s + 1, dir == 0 ? ApproachDirection::Forward : ApproachDirection::Backward);
+                Measurement m;
+                m.repeatIndex = 1;
+                m.expected = 25.0 * (s + 1);
+                m.deviation = kForward[cycle][s] + (dir == 0 ? 0.0 : 0.004);
+                m.distance = m.raw = m.expected + m.deviation;
+                cols.appendRow(m);
+            }
+    return cols;
+}
+
+bool sameBits(double a, double b)
+{
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+bool sameReport(const UncertaintyReport& a, const UncertaintyReport& b)
+{
+    if (a.size() != b.size()) return false;
+    for (int g = 0; g < a.size(); ++g) {
+        if (a[g].figures.size() != b[g].figures.size()) return false;
+        for (int f = 0; f < a[g].figures.size(); ++f) {
+            const UncertaintyInterval& x = a[g].figures[f];
+            const UncertaintyInterval& y = b[g].figures[f];
+            if (!sameBits(x.low, y.low) || !sameBits(x.high, y.high)
+                || !sameBits(x.mean, y.mean) || x.valid != y.valid)
+                return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// Контрольные векторы Random123 (kat_vectors, philox4x32 10): счётчик, ключ → блок
+void TestUncertainty::philoxKnownAnswers()
+{
+    quint32 out[4];
+
+    UncertaintyEngine::Philox(0).block(0, 0, 0, 0, out);
+    QCOMPARE(out[0], 0x6627e8d5u);
+    QCOMPARE(out[1], 0xe169c58du);
+    QCOMPARE(out[2], 0xbc57ac4cu);
+    QCOMPARE(out[3], 0x9b00dbd8u);
+
+    UncertaintyEngine::Philox(~quint64(0)).block(0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, out);
+    QCOMPARE(out[0], 0x408f276du);
+    QCOMPARE(out[1], 0x41c83b0eu);
+    QCOMPARE(out[2], 0xa20bc7c6u);
+    QCOMPARE(out[3], 0x6d5451fdu);
+
+    // ключ (k0, k1) = (0xa4093822, 0x299f31d0) — младшее слово seed первым
+    UncertaintyEngine::Philox(0x299f31d0a4093822ull).block(0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u, out);
+    QCOMPARE(out[0], 0xd16cfe09u);
+    QCOMPARE(out[1], 0x94fdccebu);
+    QCOMPARE(out[2], 0x5001e420u);
+    QCOMPARE(out[3], 0x24126ea1u);
+}
+
+// MonteCarlo без сырых окон и с perSaveSigma = 0: каждая реализация повторяет исходные
+// данные, интервал стягивается в оценку
+void TestUncertainty::monteCarloWithoutNoise()
+{
+    const MeasurementSnapshot snapshot = MeasurementSnapshot::fromColumns(bidirectionalGroup());
+    UncertaintySettings settings;
+    settings.method = UncertaintySettings::Method::MonteCarlo;
+    settings.draws = 500;
+    settings.perSaveSigma = 0.0;
+
+    const UncertaintyReport report = UncertaintyEngine::estimate(snapshot, settings);
+    QCOMPARE(report.size(), 1);
+    QCOMPARE(report[0].figures.size(), 5);                       // A, E, M, R, B
+    for (const UncertaintyInterval& iv : report[0].figures) {
+        QVERIFY(!std::isnan(iv.estimate));
+        QCOMPARE(iv.valid, settings.draws);
+        QVERIFY(sameBits(iv.low, iv.estimate));
+        QVERIFY(sameBits(iv.high, iv.estimate));
+        QCOMPARE(iv.stddev, 0.0);
+    }
+}
+
+// Два шага вперёд: x₁ ∈ {0.000, 0.002}, x₂ = {0.001, 0.001}. Бутстреп шага 1 даёт
+// x̄₁ = 0, 0.001, 0.002 с вероятностями 1/4, 1/2, 1/4, шаг 2 всегда x̄₂ = 0.001, поэтому
+// E⁺ = |x̄₁ − x̄₂| — 0 или 0.001 поровну: интервал 95 % — [0, 0.001], среднее 0.0005,
+// СКО 0.0005. При 10⁴ реализациях СКО доли нулей 0.005 — допуск в шесть СКО.
+void TestUncertainty::bootstrapHandComputed()
+{
+    const MeasurementSnapshot snapshot =
+        MeasurementSnapshot::fromColumns(forwardGroup({ { 0.000, 0.002 }, { 0.001, 0.001 } }));
+    UncertaintySettings settings;
+    settings.draws = 10000;
+
+    const UncertaintyReport report = UncertaintyEngine::estimate(snapshot, settings);
+    QCOMPARE(report.size(), 1);
+    QCOMPARE(report[0].figures.size(), 3);                       // A⁺, E⁺, R⁺
+    const UncertaintyInterval& e = report[0].figures[1];
+    QCOMPARE(e.label, QString::fromUtf8("E⁺"));
+    QCOMPARE(e.estimate, 0.0);
+    QCOMPARE(e.valid, settings.draws);
+    QCOMPARE(e.low, 0.0);
+    QCOMPARE(e.high, 0.001);
+    QVERIFY(std::fabs(e.mean - 0.0005) < 6 * 0.005 * 0.001);
+    QVERIFY(std::fabs(e.stddev - 0.0005) < 1e-5);
+}
+
+// Один seed — один отчёт: повтор, число реализаций выше порога пула при 1 и 4 потоках;
+// другой seed — другие границы
+void TestUncertainty::bootstrapDeterministic()
+{
+    const MeasurementSnapshot snapshot = MeasurementSnapshot::fromColumns(bidirectionalGroup());
+    UncertaintySettings settings;
+    settings.draws = 4 * UncertaintyEngine::kParallelDraws;
+
+    QThreadPool* pool = QThreadPool::globalInstance();
+    const int savedMax = pool->maxThreadCount();
+
+    pool->setMaxThreadCount(1);
+    const UncertaintyReport one = UncertaintyEngine::estimate(snapshot, settings);
+    pool->setMaxThreadCount(4);
+    const UncertaintyReport four = UncertaintyEngine::estimate(snapshot, settings);
+    const UncertaintyReport again = UncertaintyEngine::estimate(snapshot, settings);
+    pool->setMaxThreadCount(savedMax);
+
+    QCOMPARE(one.size(), 1);
+    QCOMPARE(one[0].figures.size(), 5);
+    QVERIFY(sameReport(one, four));
+    QVERIFY(sameReport(four, again));
+
+    // оценка — тот же итог, что у AccuracyCalculator, и внутри интервала
+    const AccuracyResultList direct = AccuracyCalculator::computeGroup(snapshot.groupStats(0));
+    const UncertaintyInterval& a = one[0].figures[0];
+    QCOMPARE(a.label, QString("A"));
+    QVERIFY(sameBits(a.estimate, direct.last().positioningAccuracy));
+    QVERIFY(a.low <= a.estimate && a.estimate <= a.high);
+
+    UncertaintySettings other = settings;
+    other.seed = settings.seed + 1;
+    QVERIFY(!sameReport(one, UncertaintyEngine::estimate(snapshot, other)));
+}
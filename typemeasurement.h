@@ -22,6 +22,9 @@ struct Measurement {
     double distance;     // Смещение относительно базовой точки (raw - base)
     double expected;     // Теоретическое значение шага
     double deviation;    // Отклонение: distance - expected
+    int rawIndex = -1;   // Индекс сырого окна в RawRecordStore (-1 — окна нет)
+    qint64 timeMs = 0;   // Время сохранения, мс от эпохи (0 — неизвестно)
+    double drift = 0.0;  // Поправка на дрейф: deviation = (distance - drift) - expected
 };
 
 struct MeasurementSeries {